@@ -0,0 +1,145 @@
+//
+// Copyright (c) 2026 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/beast2
+//
+
+// Measures the heap memory each worker pays for its
+// routing table: a flat_router held by value (as
+// http_worker did before shared_router) versus a
+// shared_router handle.
+//
+// Usage: router_memory [routes] [workers]
+
+#include <boost/beast2/shared_router.hpp>
+#include <boost/http/server/flat_router.hpp>
+#include <boost/http/server/router.hpp>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <vector>
+
+namespace {
+
+std::atomic<std::size_t> g_bytes{0};
+std::atomic<std::size_t> g_count{0};
+
+} // (anon)
+
+void*
+operator new(std::size_t n)
+{
+    g_bytes.fetch_add(n, std::memory_order_relaxed);
+    g_count.fetch_add(1, std::memory_order_relaxed);
+    if(void* p = std::malloc(n ? n : 1))
+        return p;
+    throw std::bad_alloc();
+}
+
+void
+operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void
+operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+namespace boost {
+namespace beast2 {
+
+namespace {
+
+struct sample
+{
+    std::size_t bytes;
+    std::size_t count;
+
+    static sample now() noexcept
+    {
+        return {
+            g_bytes.load(std::memory_order_relaxed),
+            g_count.load(std::memory_order_relaxed) };
+    }
+};
+
+http::flat_router
+make_routes(std::size_t n)
+{
+    http::router r;
+    for(std::size_t i = 0; i < n; ++i)
+    {
+        std::string path = "/api/v" + std::to_string(i % 7) +
+            "/resource" + std::to_string(i) + "/:id";
+        r.use(path,
+            [](http::route_params&) -> http::route_task
+            {
+                co_return http::route_next;
+            });
+    }
+    return http::flat_router(std::move(r));
+}
+
+template<class Handle, class Make>
+void
+measure(
+    char const* name,
+    std::size_t workers,
+    Make const& make)
+{
+    std::vector<Handle> v;
+    v.reserve(workers);
+    auto const s0 = sample::now();
+    for(std::size_t i = 0; i < workers; ++i)
+        v.push_back(make());
+    auto const s1 = sample::now();
+    std::printf(
+        "%-14s sizeof=%4zu  heap/worker=%10.1f bytes  allocs/worker=%6.1f\n",
+        name, sizeof(Handle),
+        double(s1.bytes - s0.bytes) / double(workers),
+        double(s1.count - s0.count) / double(workers));
+}
+
+int
+run(int argc, char** argv)
+{
+    std::size_t const routes =
+        argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 3000;
+    std::size_t const workers =
+        argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 1000;
+
+    auto const s0 = sample::now();
+    http::flat_router fr = make_routes(routes);
+    auto const s1 = sample::now();
+    std::printf(
+        "routes=%zu workers=%zu table=%zu bytes\n",
+        routes, workers, s1.bytes - s0.bytes);
+
+    // before: every worker holds the router by value
+    measure<http::flat_router>("flat_router", workers,
+        [&]{ return http::flat_router(fr); });
+
+    // after: every worker holds a shared handle
+    shared_router sr(std::move(fr));
+    measure<shared_router>("shared_router", workers,
+        [&]{ return shared_router(sr); });
+    return EXIT_SUCCESS;
+}
+
+} // (anon)
+
+} // beast2
+} // boost
+
+int main(int argc, char** argv)
+{
+    return boost::beast2::run(argc, argv);
+}
@@ -14,6 +14,10 @@
 #include <boost/beast2/error.hpp>
 #include <boost/beast2/http_server.hpp>
 #include <boost/beast2/https_server.hpp>
+#include <boost/beast2/metrics_service.hpp>
+#include <boost/beast2/request_arena.hpp>
+#include <boost/beast2/send_file.hpp>
+#include <boost/beast2/serve_precompressed.hpp>
 #include <boost/capy/buffers/string_dynamic_buffer.hpp>
 #include <boost/capy/ex/thread_pool.hpp>
 #include <boost/capy/io/push_to.hpp>
@@ -34,6 +38,7 @@
 #include <boost/url/ipv4_address.hpp>
 #include <csignal>
 #include <iostream>
+#include <memory_resource>
 #include <string>
 
 namespace boost {
@@ -77,7 +82,8 @@ struct redirect
         rp.res.set(http::field::location, url_);
         rp.res.set(http::field::content_type, "text/html; charset=utf-8");
 
-        std::string body;
+        // scratch for this request only
+        std::pmr::string body(get_arena(rp));
         body.reserve(128 + url_.size() * 2);
         body.append("<!DOCTYPE html><html><head><meta charset=\"utf-8\">"
             "<title>Redirecting</title></head><body>"
@@ -204,9 +210,20 @@ int server_main( int argc, char* argv[] )
     load_server_certificate(tls);
     http::router rr2;
     rr2.use( http::cors() );
+    rr2.use( "/", measure_route( "static" ) );
+    rr2.use( "/", serve_precompressed( argv[2] ) );
+    rr2.use( "/", sendfile_static( argv[2] ) );
     rr2.use( "/", http::serve_static( argv[2] ) );
-    https_server hs2(ioc, std::atoi(argv[1]), tls,
-        http::flat_router(std::move(rr2)),
+
+    // Where the kernel can encrypt the records, large
+    // files go out with sendfile; elsewhere sendfile_static
+    // passes every request on to serve_static
+    server_config cfg2;
+    cfg2.min_workers = std::atoi(argv[1]);
+    cfg2.max_workers = cfg2.min_workers;
+    cfg2.ktls = true;
+    https_server hs2(ioc, cfg2, tls,
+        shared_router(http::flat_router(std::move(rr2))),
         http::make_parser_config(http::parser_config(true)),
         http::make_serializer_config(http::serializer_config()));
     ec = hs2.bind(corosio::endpoint(ep, 443));
@@ -218,6 +235,24 @@ int server_main( int argc, char* argv[] )
     hs2.start();
 #endif
 
+    // Metrics and the log configuration have no access
+    // control, so they are only served on the loopback
+    // interface
+    http::router rr3;
+    rr3.use( "/metrics", serve_metrics() );
+    rr3.use( "/log", serve_log_admin() );
+    http_server hs3(ioc, 2, http::flat_router(std::move(rr3)),
+        http::make_parser_config(http::parser_config(true)),
+        http::make_serializer_config(http::serializer_config()));
+    ec = hs3.bind(corosio::endpoint(
+        corosio::ipv4_address::loopback(), 8080));
+    if(ec)
+    {
+        std::cerr << "Bind failed: " << ec.message() << "\n";
+        return EXIT_FAILURE;
+    }
+    hs3.start();
+
     corosio::signal_set sigs(ioc);
     sigs.add(SIGINT);
     capy::run_async(ioc.get_executor())(
@@ -226,15 +261,18 @@ int server_main( int argc, char* argv[] )
             auto [ec, sig] = co_await sigs.wait();
             if(ec)
                 throw std::system_error(ec);
-            hs1.stop();
+            // finish requests in flight, then close
+            hs1.drain();
+            hs3.drain();
         #ifdef BOOST_COROSIO_HAS_OPENSSL
-            hs2.stop();
+            hs2.drain();
         #endif
         }());
 
     ioc.run();
 
     hs1.join();
+    hs3.join();
 #ifdef BOOST_COROSIO_HAS_OPENSSL
     hs2.join();
 #else
@@ -8,79 +8,134 @@
 //
 
 #include "serve_log_admin.hpp"
+#include <boost/beast2/body_writer.hpp>
 #include <boost/beast2/error.hpp>
 #include <boost/beast2/format.hpp>
+#include <boost/beast2/html_template.hpp>
 #include <boost/beast2/log_service.hpp>
+#include <boost/capy/buffers/string_dynamic_buffer.hpp>
+#include <boost/capy/read.hpp>
+#include <boost/http/field.hpp>
+#include <boost/url/encoding_opts.hpp>
+#include <boost/url/params_view.hpp>
+#include <boost/url/parse_query.hpp>
+#include <boost/url/url_view.hpp>
+#include <charconv>
+#include <memory>
+#include <string>
 
 namespace boost {
 namespace beast2 {
 
 namespace {
 
+core::string_view const level_names[] = {
+    "Trace", "Debug", "Info", "Warn", "Error", "Fatal" };
+
+constexpr int max_level = 5;
+
+// The longest form body accepted by a submit
+constexpr unsigned long max_form = 1024;
+
 /** Handler to serve a log admin page
 */
 class serve_log_page
 {
+    // Compiled once, when the router is built
+    struct page
+    {
+        html_template t{
+            "<html>\n"
+            "<head>\n"
+            "<style>\n"
+            "table, th, td {\n"
+            "  border: 1px solid black;\n"
+            "  border-collapse: collapse;\n"
+            "}\n"
+            "</style>\n"
+            "</head>\n"
+            "<body>\n"
+            "<h1>Log Configuration</h1>\n"
+            "<table>\n"
+            "<tr><th style=\"min-width:100px\">Name</th><th>Level</th></tr>\n"
+            "{{#sections}}"
+            "<tr><td>{{name}}</td><td>\n"
+            "    <form action=\"submit\" method=\"POST\">\n"
+            "    <input type=\"hidden\" name=\"name\" value=\"{{name}}\">\n"
+            "    <select name=\"level\" onchange=\"this.form.submit()\">\n"
+            "{{#levels}}"
+            "        <option value=\"{{level}}\"{{selected}}>{{level}}: {{level_name}}</option>\n"
+            "{{/levels}}"
+            "    </select>\n"
+            "    </form>\n"
+            "</td></tr>\n"
+            "{{/sections}}"
+            "</table>\n"
+            "</body>\n"
+            "</html>\n" };
+
+        std::size_t const sections = t.slot("sections");
+        std::size_t const name = t.slot("name");
+        std::size_t const levels = t.slot("levels");
+        std::size_t const level = t.slot("level");
+        std::size_t const selected = t.slot("selected");
+        std::size_t const level_name = t.slot("level_name");
+    };
+
 public:
     serve_log_page()
         : ls_(use_log_service())
+        , page_(std::make_shared<page const>())
     {
     }
 
-    system::error_code
+    http::route_task
     operator()(
-        http::route_params&) const
+        http::route_params& rp) const
     {
-        return {};
-#if 0
         auto const v = ls_.get_sections();
-        std::string s;
-        format_to(s, "<html>\n");
-        format_to(s, "<head>\n");
-        format_to(s, "<style>\n");
-        format_to(s, "table, th, td {\n");
-        format_to(s, "  border: 1px solid black;\n");
-        format_to(s, "  border-collapse: collapse;\n");
-        format_to(s, "}\n");
-        format_to(s, "</style>\n");
-        format_to(s, "</head>\n");
-        format_to(s, "<body>\n");
-        format_to(s, "<h1>Log Configuration</h1>\n");
-        format_to(s, "<table>\n");
-        format_to(s, "<tr><th style=\"min-width:100px\">Name</th><th>Level</th></tr>\n");
-        for(auto const& sect : v)
-        {
-            auto const sel =
-            [&](int level) -> core::string_view
+        rp.res.set(http::field::content_type, "text/html; charset=utf-8");
+
+        // the page goes straight into the serializer
+        body_writer w(rp);
+        auto const& p = *page_;
+        std::size_t sect = 0;
+        int threshold = 0;
+        auto ec = co_await p.t.render(w,
+            [&](std::size_t slot, std::size_t row, html_writer& out)
             {
-                return sect.threshold() == level ? " selected" : "";
-            };
-            format_to(s, "<tr><td>{}</td><td>", sect.name());
-            format_to(s, "    <form action=\"submit\" method=\"GET\">\n");
-            format_to(s, "    <input type=\"hidden\" name=\"name\", value=\"{}\">\n", sect.name());
-            format_to(s, "    <select name=\"level\" onchange=\"this.form.submit()\">\n");
-            format_to(s, "        <option value=\"{}\"{}>{}: Trace</option>\n", 0, sel(0), 0);
-            format_to(s, "        <option value=\"{}\"{}>{}: Debug</option>\n", 1, sel(1), 1);
-            format_to(s, "        <option value=\"{}\"{}>{}: Info</option>\n" , 2, sel(2), 2);
-            format_to(s, "        <option value=\"{}\"{}>{}: Warn</option>\n" , 3, sel(3), 3);
-            format_to(s, "        <option value=\"{}\"{}>{}: Fatal</option>\n", 4, sel(4), 4);
-            format_to(s, "    </select>\n");
-            format_to(s, "    </form>\n");
-        }
-        format_to(s, "</td></tr>\n");
-        format_to(s, "</table>\n");
-        format_to(s, "</body>\n");
-        format_to(s, "</html>\n");
-
-        p.status(http::status::ok);
-        p.res.set(http::field::content_type, "text/html; charset=UTF-8");
-        p.set_body(std::move(s));
-        return http::route::send;
-#endif
+                if(slot == p.sections)
+                {
+                    if(row >= v.size())
+                        return false;
+                    // read once, the level may change meanwhile
+                    sect = row;
+                    threshold = v[row].threshold();
+                    return true;
+                }
+                if(slot == p.levels)
+                    return row <= static_cast<std::size_t>(max_level);
+                if(slot == p.name)
+                    out.text(v[sect].name());
+                else if(slot == p.level)
+                    format_to(out, "{}", row);
+                else if(slot == p.selected)
+                    out.text(threshold == static_cast<int>(row) ?
+                        " selected" : "");
+                else if(slot == p.level_name)
+                    out.text(level_names[row]);
+                return false;
+            });
+        if(! ec)
+            ec = co_await w.finish();
+        if(ec)
+            co_return http::route_error(ec);
+        co_return http::route_done;
     }
 
 private:
     log_service& ls_;
+    std::shared_ptr<page const> page_;
 };
 
 //------------------------------------------------
@@ -95,20 +150,76 @@ public:
     {
     }
 
-    system::error_code
+    http::route_task
     operator()(
-        http::route_params&) const
+        http::route_params& rp) const
     {
-        return {};
-#if 0
-        p.status(http::status::ok);
-        p.res.set(http::field::content_type, "plain/text; charset=UTF-8");
-        p.set_body("submit");
-        return http::route::send;
-#endif
+        // The form is small; its length must be declared,
+        // so that reading it is bounded
+        auto const len = rp.req.value_or(
+            http::field::content_length, "");
+        unsigned long size = 0;
+        auto const [end, err] = std::from_chars(
+            len.data(), len.data() + len.size(), size);
+        if( len.empty() ||
+            err != std::errc() ||
+            end != len.data() + len.size() ||
+            size > max_form)
+            co_return co_await fail(rp, "bad form length");
+
+        std::string form;
+        capy::string_dynamic_buffer buf(&form);
+        auto [rec, n] = co_await capy::read(rp.req_body, buf);
+        if(rec)
+            co_return http::route_error(rec);
+
+        // application/x-www-form-urlencoded
+        if(urls::parse_query(form).has_error())
+            co_return co_await fail(rp, "bad form");
+        urls::params_view const params(
+            form, urls::encoding_opts(true));
+        auto const it_name = params.find("name");
+        auto const it_level = params.find("level");
+        if( it_name == params.end() ||
+            it_level == params.end())
+            co_return co_await fail(rp, "missing parameter");
+
+        std::string const level = (*it_level).value;
+        if( level.size() != 1 ||
+            level[0] < '0' ||
+            level[0] > '0' + max_level)
+            co_return co_await fail(rp, "bad level");
+
+        // only sections which already exist, so that
+        // a request cannot create new ones
+        if(! ls_.set_threshold(
+                (*it_name).value, level[0] - '0'))
+            co_return co_await fail(rp, "unknown section");
+
+        // back to the page
+        rp.status(http::status::found);
+        rp.res.set(http::field::location, "./");
+        auto [ec] = co_await rp.send("");
+        if(ec)
+            co_return http::route_error(ec);
+        co_return http::route_done;
     }
 
 private:
+    static
+    http::route_task
+    fail(
+        http::route_params& rp,
+        core::string_view reason)
+    {
+        rp.status(http::status::bad_request);
+        rp.res.set(http::field::content_type, "text/plain; charset=utf-8");
+        auto [ec] = co_await rp.send(reason);
+        if(ec)
+            co_return http::route_error(ec);
+        co_return http::route_done;
+    }
+
     log_service& ls_;
 };
 
@@ -116,16 +227,14 @@ private:
 
 //------------------------------------------------
 
-#if 0
-router
+http::router
 serve_log_admin()
 {
-    router r;
+    http::router r;
     r.add(http::method::get, "/", serve_log_page());
-    r.add(http::method::get, "/submit", handle_submit());
+    r.add(http::method::post, "/submit", handle_submit());
     return r;
 }
-#endif
 
 } // beast2
 } // boost
@@ -16,6 +16,13 @@
 namespace boost {
 namespace beast2 {
 
+/** Return a router for the log configuration page.
+
+    `GET /` lists the sections with their thresholds,
+    and `POST /submit` changes one. It has no access
+    control of its own, so mount it only on a listener
+    which is not reachable from outside.
+*/
 http::router
 serve_log_admin();
 
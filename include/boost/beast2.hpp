@@ -10,13 +10,29 @@
 #ifndef BOOST_BEAST2_HPP
 #define BOOST_BEAST2_HPP
 
+#include <boost/beast2/admission_controller.hpp>
+#include <boost/beast2/body_writer.hpp>
 #include <boost/beast2/endpoint.hpp>
 #include <boost/beast2/error.hpp>
 #include <boost/beast2/format.hpp>
+#include <boost/beast2/frame_pool.hpp>
+#include <boost/beast2/html_template.hpp>
 #include <boost/beast2/http_server.hpp>
+#include <boost/beast2/log_backend.hpp>
 #include <boost/beast2/log_service.hpp>
 #include <boost/beast2/logger.hpp>
+#include <boost/beast2/metrics_service.hpp>
+#include <boost/beast2/request_arena.hpp>
+#include <boost/beast2/request_trace.hpp>
+#include <boost/beast2/response_cache.hpp>
+#include <boost/beast2/response_tap.hpp>
 #include <boost/beast2/route_handler_corosio.hpp>
+#include <boost/beast2/send_file.hpp>
+#include <boost/beast2/serve_precompressed.hpp>
+#include <boost/beast2/server_config.hpp>
+#include <boost/beast2/sharded_http_server.hpp>
+#include <boost/beast2/shared_router.hpp>
+#include <boost/beast2/timer_wheel.hpp>
 #include <boost/beast2/test/error.hpp>
 
 #endif
@@ -0,0 +1,100 @@
+//
+// Copyright (c) 2026 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/beast2
+//
+
+#ifndef BOOST_BEAST2_ADMISSION_CONTROLLER_HPP
+#define BOOST_BEAST2_ADMISSION_CONTROLLER_HPP
+
+#include <boost/beast2/detail/config.hpp>
+#include <boost/beast2/server_config.hpp>
+#include <chrono>
+#include <mutex>
+
+namespace boost {
+namespace beast2 {
+
+/** Decides whether to admit or shed a new connection.
+
+    The decision follows the CoDel detection rule. Each
+    arrival reports its queueing delay. A delay below the
+    target admits, and ends any overload. A delay at or
+    above the target starts a timer; if the delay is still
+    above target when one interval has passed, the
+    controller enters the dropping state and sheds every
+    arrival until one observes a delay below target again.
+
+    A single short burst therefore never sheds, while a
+    standing queue is detected within one interval.
+
+    @par Thread Safety
+    Distinct objects: Safe.
+    Shared objects: Safe.
+
+    @see admission_config
+*/
+class BOOST_BEAST2_DECL
+    admission_controller
+{
+public:
+    using clock_type = std::chrono::steady_clock;
+
+    /** Constructor.
+
+        @param cfg The admission settings.
+    */
+    explicit
+    admission_controller(
+        admission_config const& cfg) noexcept
+        : cfg_(cfg)
+    {
+    }
+
+    /** Return the settings.
+    */
+    admission_config const&
+    config() const noexcept
+    {
+        return cfg_;
+    }
+
+    /** Decide on a new connection.
+
+        @param delay The time the connection waited
+            between being accepted and being served.
+        @param now The current time.
+        @return `true` to admit, `false` to shed.
+    */
+    bool
+    admit(
+        clock_type::duration delay,
+        clock_type::time_point now);
+
+    /** Turn the last admission into a shed.
+
+        This is used when a connection was admitted but
+        no connection state is available to serve it.
+    */
+    void
+    shed() noexcept;
+
+    /** Return the counters.
+    */
+    admission_stats
+    get_stats() const;
+
+private:
+    mutable std::mutex m_;
+    admission_config cfg_;
+    admission_stats st_;
+    clock_type::time_point first_above_{};
+};
+
+} // beast2
+} // boost
+
+#endif
@@ -0,0 +1,161 @@
+//
+// Copyright (c) 2026 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/beast2
+//
+
+#ifndef BOOST_BEAST2_BODY_WRITER_HPP
+#define BOOST_BEAST2_BODY_WRITER_HPP
+
+#include <boost/beast2/detail/config.hpp>
+#include <boost/beast2/error.hpp>
+#include <boost/capy/buffers.hpp>
+#include <boost/capy/io/any_buffer_sink.hpp>
+#include <boost/capy/task.hpp>
+#include <boost/http/server/router.hpp>
+#include <boost/system/error_code.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace boost {
+namespace beast2 {
+
+/** Writes a response body into the serializer's buffers.
+
+    The writer is a sink for @ref format_to, so a handler
+    can generate a body piece by piece without first
+    building it in a string. Appended bytes are copied
+    into space prepared by `rp.res_body`, and go out
+    when @ref flush or @ref finish commits them.
+
+    A single append never fails: bytes which do not fit
+    in the prepared space are held until the next flush.
+    Handlers generating a large body flush whenever
+    @ref full returns `true`, which keeps memory bounded
+    by the serializer's buffer.
+
+    @code
+    http::route_task
+    serve_rows(http::route_params& rp)
+    {
+        body_writer w(rp);
+        for(auto const& row : rows)
+        {
+            format_to(w, "<tr><td>{}</td></tr>\n", row);
+            if(w.full())
+                if(auto ec = co_await w.flush())
+                    co_return http::route_error(ec);
+        }
+        if(auto ec = co_await w.finish())
+            co_return http::route_error(ec);
+        co_return http::route_done;
+    }
+    @endcode
+
+    @par Thread Safety
+    Distinct objects: Safe.
+    Shared objects: Unsafe.
+*/
+class BOOST_BEAST2_DECL
+    body_writer
+{
+    static constexpr std::size_t max_buffers = 8;
+
+    capy::any_buffer_sink& sink_;
+    capy::mutable_buffer bufs_[max_buffers];
+    std::size_t nbuf_ = 0;
+    std::size_t ibuf_ = 0;
+    char* p_ = nullptr;
+    char* end_ = nullptr;
+    std::size_t prepared_ = 0;
+    std::size_t written_ = 0;
+    std::string spill_;
+    std::uint64_t remain_ = 0;
+    bool sized_ = false;
+    bool overflow_ = false;
+    bool prepare_ = true;
+    bool discard_ = false;
+
+public:
+    /** Constructor.
+
+        The response is sent with chunked encoding, since
+        its length is not known in advance. For a `HEAD`
+        request the body is discarded.
+
+        @param rp The route parameters of the request.
+    */
+    explicit
+    body_writer(http::route_params& rp);
+
+    /** Constructor.
+
+        The response is given a `Content-Length` of
+        `size`, and exactly that many bytes must be
+        written: bytes beyond it are dropped and make
+        the next @ref flush fail, and @ref finish fails
+        if fewer were written, in both cases with
+        @ref error::body_length_mismatch. For a `HEAD`
+        request the body is discarded.
+
+        @param rp The route parameters of the request.
+        @param size The length of the body.
+    */
+    body_writer(
+        http::route_params& rp,
+        std::uint64_t size);
+
+    body_writer(body_writer const&) = delete;
+    body_writer& operator=(body_writer const&) = delete;
+
+    /** Append bytes to the body.
+    */
+    void
+    append(
+        char const* data,
+        std::size_t size);
+
+    /** Return true if the prepared space is used up.
+
+        Further appends are held in memory until the
+        next @ref flush.
+    */
+    bool
+    full() const noexcept
+    {
+        return ! spill_.empty() ||
+            (! prepare_ && written_ == prepared_);
+    }
+
+    /** Commit the bytes appended so far.
+
+        @return The error, if any.
+    */
+    capy::task<system::error_code>
+    flush();
+
+    /** Commit the remaining bytes and end the body.
+
+        @return The error, if any.
+    */
+    capy::task<system::error_code>
+    finish();
+
+private:
+    void
+    prepare();
+
+    std::size_t
+    fill(
+        char const* data,
+        std::size_t size) noexcept;
+};
+
+} // beast2
+} // boost
+
+#endif
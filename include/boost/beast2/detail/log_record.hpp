@@ -0,0 +1,215 @@
+//
+// Copyright (c) 2026 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/beast2
+//
+
+#ifndef BOOST_BEAST2_DETAIL_LOG_RECORD_HPP
+#define BOOST_BEAST2_DETAIL_LOG_RECORD_HPP
+
+#include <boost/beast2/format.hpp>
+#include <boost/beast2/log_backend.hpp>
+#include <boost/core/detail/string_view.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <tuple>
+#include <type_traits>
+
+namespace boost {
+namespace beast2 {
+namespace detail {
+
+/*  A deferred record holds the address and length of
+    its format string, which must have static storage
+    duration, followed by the bytes of each argument:
+    arithmetic values as they are in memory, strings as
+    a length and their characters. The decoder is an
+    instantiation of decode_record for the same argument
+    types, and runs on the logging thread. The literal
+    was checked when the program was compiled, and the
+    fields it parses to are kept by address, so each
+    format string is only parsed the first time.
+*/
+
+template<class T>
+struct log_arg
+{
+    static constexpr bool capturable = false;
+};
+
+template<class T>
+    requires std::is_arithmetic_v<T>
+struct log_arg<T>
+{
+    static constexpr bool capturable = true;
+
+    static
+    void
+    put(std::string& dest, T const& v)
+    {
+        dest.append(reinterpret_cast<char const*>(&v), sizeof(v));
+    }
+
+    static
+    T
+    get(char const*& p) noexcept
+    {
+        T v;
+        std::memcpy(&v, p, sizeof(v));
+        p += sizeof(v);
+        return v;
+    }
+};
+
+struct log_string_arg
+{
+    static constexpr bool capturable = true;
+
+    static
+    void
+    put(std::string& dest, core::string_view s)
+    {
+        auto const n = s.size();
+        dest.append(reinterpret_cast<char const*>(&n), sizeof(n));
+        dest.append(s.data(), n);
+    }
+
+    static
+    core::string_view
+    get(char const*& p) noexcept
+    {
+        std::size_t n;
+        std::memcpy(&n, p, sizeof(n));
+        p += sizeof(n);
+        core::string_view s(p, n);
+        p += n;
+        return s;
+    }
+};
+
+template<>
+struct log_arg<core::string_view> : log_string_arg {};
+
+template<>
+struct log_arg<std::string> : log_string_arg {};
+
+// A null pointer is recorded as the formatter shows it
+struct log_cstr_arg : log_string_arg
+{
+    static
+    void
+    put(std::string& dest, char const* s)
+    {
+        log_string_arg::put(dest, s ?
+            core::string_view(s) : core::string_view("(null)"));
+    }
+};
+
+template<>
+struct log_arg<char const*> : log_cstr_arg {};
+
+template<>
+struct log_arg<char*> : log_cstr_arg {};
+
+template<std::size_t N>
+struct log_arg<char[N]> : log_string_arg {};
+
+template<class... Args>
+constexpr bool log_capturable =
+    (log_arg<Args>::capturable && ...);
+
+// Format strings already parsed, by address. Each
+// logging thread keeps its own, and a string which
+// collides with another in its slot is parsed again.
+template<class... Args>
+class log_format_cache
+{
+    static constexpr std::size_t slots = 16;
+    static constexpr std::size_t max_fields =
+        sizeof...(Args) > 0 ? sizeof...(Args) : 1;
+
+public:
+    struct entry
+    {
+        char const* s = nullptr;
+        std::size_t size = 0;
+        format_field fields[max_fields];
+        format_text tail;
+        std::size_t n = 0;
+    };
+
+    entry const&
+    get(char const* s, std::size_t size)
+    {
+        auto& e = e_[(reinterpret_cast<
+            std::uintptr_t>(s) >> 4) % slots];
+        if(e.s != s || e.size != size)
+        {
+            e.n = parse_format(
+                s, size, e.fields, sizeof...(Args), e.tail);
+            e.s = s;
+            e.size = size;
+        }
+        return e;
+    }
+
+private:
+    entry e_[slots];
+};
+
+template<class... Args>
+void
+decode_record(
+    char const* p,
+    std::size_t,
+    std::string& dest)
+{
+    char const* fs;
+    std::size_t n;
+    std::memcpy(&fs, p, sizeof(fs));
+    p += sizeof(fs);
+    std::memcpy(&n, p, sizeof(n));
+    p += sizeof(n);
+
+    // a braced list is evaluated left to right
+    std::tuple<decltype(log_arg<Args>::get(p))...> args{
+        log_arg<Args>::get(p)... };
+    thread_local log_format_cache<Args...> cache;
+    auto const& f = cache.get(fs, n);
+    std::apply(
+        [&](auto const&... a)
+        {
+            format_access::emit(dest, fs,
+                f.fields, f.n, f.tail, a...);
+        }, args);
+}
+
+// Encode a record and put it in the backend's ring
+template<class... Args>
+bool
+push_record(
+    log_backend& backend,
+    char const* fs,
+    std::size_t n,
+    Args const&... args)
+{
+    // Reused by every record of the thread, so
+    // encoding does not allocate once it has grown
+    thread_local std::string buf;
+    buf.clear();
+    buf.append(reinterpret_cast<char const*>(&fs), sizeof(fs));
+    buf.append(reinterpret_cast<char const*>(&n), sizeof(n));
+    (log_arg<Args>::put(buf, args), ...);
+    return backend.push(buf, &decode_record<Args...>);
+}
+
+} // detail
+} // beast2
+} // boost
+
+#endif
@@ -0,0 +1,52 @@
+//
+// Copyright (c) 2026 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/beast2
+//
+
+#ifndef BOOST_BEAST2_DETAIL_REQUEST_SLOTS_HPP
+#define BOOST_BEAST2_DETAIL_REQUEST_SLOTS_HPP
+
+#include <boost/beast2/detail/config.hpp>
+#include <boost/http/server/router.hpp>
+
+namespace boost {
+namespace beast2 {
+
+class file_sender;
+class histogram;
+class request_arena;
+class response_tap;
+
+namespace detail {
+
+// What a worker publishes to the handlers of a request.
+// The worker owns one of these and places a single
+// pointer to it in the route data of each request,
+// instead of one entry per object.
+struct request_slots
+{
+    request_arena* arena = nullptr;
+    file_sender* sender = nullptr;
+    response_tap* tap = nullptr;
+
+    // Set by measure_route
+    histogram const* latency = nullptr;
+};
+
+inline
+request_slots*
+find_slots(http::route_params& rp) noexcept
+{
+    auto const p = rp.route_data.find<request_slots*>();
+    return p ? *p : nullptr;
+}
+
+} // detail
+} // beast2
+} // boost
+
+#endif
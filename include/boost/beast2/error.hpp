@@ -24,6 +24,9 @@ namespace beast2 {
 enum class error
 {
     success = 0,
+
+    /// The bytes of a body differ from its Content-Length
+    body_length_mismatch,
 };
 
 } // beast2
@@ -14,133 +14,539 @@
 #include <boost/beast2/detail/except.hpp>
 #include <boost/core/detail/string_view.hpp>
 
-#include <memory>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
 #include <ostream>
 #include <streambuf>
 #include <string>
+#include <type_traits>
 
 namespace boost {
 namespace beast2 {
 
+/** A destination for formatted output.
+
+    Any type with `append(char const*, std::size_t)`,
+    such as `std::string`, is a sink.
+*/
+template<class T>
+concept format_sink =
+    requires(T& t, char const* p, std::size_t n)
+    {
+        t.append(p, n);
+    };
+
 namespace detail {
 
-struct format_impl
+/*  A format string is a sequence of literal text and
+    replacement fields. Each field is `{}` or `{:spec}`,
+    where spec is
+
+        [[fill]align][#][0][width][.precision][type]
+
+    align is one of `<`, `>` or `^`, and type is one of
+    `bcdoxX` for integers, `eEfFgG` for floating point,
+    `s` for strings or `p` for pointers. `{{` and `}}`
+    are literal braces.
+
+    A string is split into fields once: at compile time
+    for literals, else before any output is produced.
+    Errors call throw_invalid_argument, which is not a
+    constant expression, so a bad literal does not compile.
+*/
+
+struct format_spec
 {
-    std::ostream& os;
-    core::string_view fs;
-    char const* p;
-    char const* p0;
-    char const* end;
-    bool has_placeholder = false;
+    char fill = ' ';
+    char align = 0;
+    char type = 0;
+    bool alt = false;
+    bool zero = false;
+    bool has_precision = false;
+    std::uint32_t width = 0;
+    std::uint32_t precision = 0;
+};
+
+// The literal text before a field, or after the last one
+struct format_text
+{
+    std::uint32_t pos = 0;
+    std::uint32_t len = 0;
 
-    format_impl(
-        std::ostream& os_,
-        core::string_view fs_)
-        : os(os_)
-        , fs(fs_)
-        , p(fs.data())
-        , p0(p)
-        , end(p + fs.size())
+    // contains {{ or }}
+    bool escaped = false;
+};
+
+struct format_field
+{
+    format_text text;
+    format_spec spec;
+};
+
+enum class format_kind : unsigned char
+{
+    integer,
+    character,
+    floating,
+    string,
+    pointer,
+    other
+};
+
+template<class T>
+constexpr
+format_kind
+format_kind_of() noexcept
+{
+    using U = std::remove_cv_t<T>;
+    if constexpr(std::is_same_v<U, char>)
+        return format_kind::character;
+    else if constexpr(std::is_integral_v<U>)
+        return format_kind::integer;
+    else if constexpr(std::is_floating_point_v<U>)
+        return format_kind::floating;
+    else if constexpr(
+        std::is_null_pointer_v<U> ||
+        std::is_member_pointer_v<U>)
+        return format_kind::other;
+    else if constexpr(std::is_convertible_v<
+            U const&, core::string_view>)
+        return format_kind::string;
+    else if constexpr(std::is_pointer_v<U>)
+        return format_kind::pointer;
+    else
+        return format_kind::other;
+}
+
+constexpr
+std::size_t
+parse_format_int(
+    char const* s,
+    std::size_t n,
+    std::size_t i,
+    std::uint32_t& v)
+{
+    v = 0;
+    while(i < n && s[i] >= '0' && s[i] <= '9')
     {
+        v = v * 10 + static_cast<std::uint32_t>(s[i] - '0');
+        if(v > 4096)
+            detail::throw_invalid_argument(
+                "invalid format spec, width or precision too large");
+        ++i;
     }
+    return i;
+}
 
-    core::string_view
-    next()
+constexpr
+bool
+is_format_align(char c) noexcept
+{
+    return c == '<' || c == '>' || c == '^';
+}
+
+constexpr
+std::size_t
+parse_format_spec(
+    char const* s,
+    std::size_t n,
+    std::size_t i,
+    format_spec& spec)
+{
+    if( i + 1 < n &&
+        is_format_align(s[i + 1]) &&
+        s[i] != '{' && s[i] != '}')
+    {
+        spec.fill = s[i];
+        spec.align = s[i + 1];
+        i += 2;
+    }
+    else if(i < n && is_format_align(s[i]))
     {
-        has_placeholder = false;
-        bool unmatched_open = false;
-        bool unmatched_close = false;
-        while (p != end)
+        spec.align = s[i];
+        ++i;
+    }
+    if(i < n && s[i] == '#')
+    {
+        spec.alt = true;
+        ++i;
+    }
+    if(i < n && s[i] == '0')
+    {
+        spec.zero = true;
+        ++i;
+    }
+    i = parse_format_int(s, n, i, spec.width);
+    if(i < n && s[i] == '.')
+    {
+        auto const j = parse_format_int(
+            s, n, i + 1, spec.precision);
+        if(j == i + 1)
+            detail::throw_invalid_argument(
+                "invalid format spec, missing precision");
+        spec.has_precision = true;
+        i = j;
+    }
+    if(i < n && s[i] != '}')
+    {
+        switch(s[i])
         {
-            if(unmatched_open)
-            {
-                if(*p == '{')
-                {
-                    p++;
-                    core::string_view seg(p0, (p - 1) - p0);
-                    p0 = p;
-                    return seg;
-                }
-                if(*p == '}')
-                {
-                    p++;
-                    core::string_view seg(p0, (p - 2) - p0);
-                    p0 = p;
-                    has_placeholder = true;
-                    return seg;
-                }
-                detail::throw_invalid_argument(
-                    "invalid format string, unmatched {");
-            }
-            if(unmatched_close)
-            {
-                if(*p == '}')
-                {
-                    p++;
-                    core::string_view seg(p0, (p - 1) - p0);
-                    p0 = p;
-                    return seg;
-                }
-                detail::throw_invalid_argument(
-                    "invalid format string, unmatched }");
-            }
-            if (*p == '{')
-            {
-                unmatched_open = true;
-            }
-            if(*p == '}')
+        case 'b': case 'c': case 'd': case 'o': case 'x': case 'X':
+        case 'e': case 'E': case 'f': case 'F': case 'g': case 'G':
+        case 's': case 'p':
+            spec.type = s[i];
+            ++i;
+            break;
+        default:
+            detail::throw_invalid_argument("invalid format spec");
+        }
+    }
+    return i;
+}
+
+// Split a format string into at most `max` fields,
+// returning the number of fields
+constexpr
+std::size_t
+parse_format(
+    char const* s,
+    std::size_t n,
+    format_field* fields,
+    std::size_t max,
+    format_text& tail)
+{
+    std::size_t count = 0;
+    std::size_t i = 0;
+    format_text text;
+    while(i < n)
+    {
+        if(s[i] == '}')
+        {
+            if(i + 1 < n && s[i + 1] == '}')
             {
-                unmatched_close = true;
+                text.escaped = true;
+                i += 2;
+                continue;
             }
-            p++;
+            detail::throw_invalid_argument(
+                "invalid format string, unmatched }");
+        }
+        if(s[i] != '{')
+        {
+            ++i;
+            continue;
+        }
+        if(i + 1 < n && s[i + 1] == '{')
+        {
+            text.escaped = true;
+            i += 2;
+            continue;
         }
-        if (unmatched_open)
+        text.len = static_cast<std::uint32_t>(i - text.pos);
+        format_spec spec;
+        ++i;
+        if(i < n && s[i] == ':')
+            i = parse_format_spec(s, n, i + 1, spec);
+        if(i >= n)
             detail::throw_invalid_argument(
                 "invalid format string, unmatched {");
-        if(unmatched_close)
+        if(s[i] != '}')
             detail::throw_invalid_argument(
-                "invalid format string, unmatched }");
+                "invalid format string, bad replacement field");
+        ++i;
+        if(count == max)
+            detail::throw_invalid_argument(
+                "too few format arguments provided");
+        fields[count].text = text;
+        fields[count].spec = spec;
+        ++count;
+        text = format_text();
+        text.pos = static_cast<std::uint32_t>(i);
+    }
+    text.len = static_cast<std::uint32_t>(n - text.pos);
+    tail = text;
+    return count;
+}
+
+constexpr
+bool
+format_type_in(
+    char type,
+    char const* allowed) noexcept
+{
+    for(; *allowed; ++allowed)
+        if(*allowed == type)
+            return true;
+    return false;
+}
 
-        core::string_view seg(
-            p0, end - p0);
-        p0 = end;
-        return seg;
+constexpr
+void
+check_format_spec(
+    format_spec const& spec,
+    format_kind kind)
+{
+    char const* allowed = "";
+    switch(kind)
+    {
+    case format_kind::integer:   allowed = "bdoxX"; break;
+    case format_kind::character: allowed = "bcdoxX"; break;
+    case format_kind::floating:  allowed = "eEfFgG"; break;
+    case format_kind::string:    allowed = "s"; break;
+    case format_kind::pointer:   allowed = "p"; break;
+    case format_kind::other:     break;
     }
+    if(spec.type && ! format_type_in(spec.type, allowed))
+        detail::throw_invalid_argument(
+            "format spec does not match the argument type");
+    if( spec.has_precision &&
+        kind != format_kind::floating &&
+        kind != format_kind::string)
+        detail::throw_invalid_argument(
+            "precision is not allowed for the argument type");
+    if( spec.alt &&
+        kind != format_kind::integer &&
+        kind != format_kind::character)
+        detail::throw_invalid_argument(
+            "# is not allowed for the argument type");
+    if( spec.zero &&
+        kind != format_kind::integer &&
+        kind != format_kind::character &&
+        kind != format_kind::floating)
+        detail::throw_invalid_argument(
+            "0 is not allowed for the argument type");
+}
+
+template<class... Args>
+constexpr
+void
+check_format_fields(
+    format_field const* fields,
+    std::size_t n)
+{
+    constexpr format_kind kinds[] = {
+        format_kind_of<Args>()..., format_kind::other };
+    for(std::size_t i = 0; i < n; ++i)
+        check_format_spec(fields[i].spec, kinds[i]);
+}
+
+//------------------------------------------------
 
-    template<class Arg>
-    void do_arg(Arg const& arg)
+template<class Sink>
+void
+write_text(
+    Sink& dest,
+    char const* s,
+    format_text const& t)
+{
+    char const* p = s + t.pos;
+    char const* const end = p + t.len;
+    if(! t.escaped)
     {
-        core::string_view seg = next();
-        while(seg.size())
+        if(p != end)
+            dest.append(p, t.len);
+        return;
+    }
+    // append up to and including each brace,
+    // then skip its twin
+    while(p != end)
+    {
+        char const* q = p;
+        while(q != end && *q != '{' && *q != '}')
+            ++q;
+        if(q == end)
         {
-            os.write(seg.data(), static_cast<std::streamsize>(seg.size()));
-            if(has_placeholder)
-                break;
-            seg = next();
+            dest.append(p, static_cast<std::size_t>(end - p));
+            break;
         }
-        if(has_placeholder)
-            os << arg;
-    };
+        dest.append(p, static_cast<std::size_t>(q - p) + 1);
+        p = q + 2;
+    }
+}
+
+template<class Sink>
+void
+write_fill(
+    Sink& dest,
+    char c,
+    std::size_t n)
+{
+    char buf[32];
+    std::memset(buf, c, sizeof(buf));
+    while(n > 0)
+    {
+        auto const m = n < sizeof(buf) ? n : sizeof(buf);
+        dest.append(buf, m);
+        n -= m;
+    }
+}
 
-    template<class... Args>
-    void operator()(Args const&... args)
+template<class Sink>
+void
+write_padded(
+    Sink& dest,
+    char const* p,
+    std::size_t n,
+    format_spec const& spec,
+    char default_align)
+{
+    if(spec.width <= n)
     {
-        using expander = int[];
-        (void)expander{0, (do_arg(args), 0)...};
+        dest.append(p, n);
+        return;
+    }
+    auto const fill = spec.width - n;
+    auto const align = spec.align ? spec.align : default_align;
+    std::size_t const before =
+        align == '>' ? fill :
+        align == '^' ? fill / 2 : 0;
+    write_fill(dest, spec.fill, before);
+    dest.append(p, n);
+    write_fill(dest, spec.fill, fill - before);
+}
 
-        core::string_view seg;
-        do
+// `prefix` counts the sign and base prefix, which
+// come before any zeros of zero padding
+template<class Sink>
+void
+write_number(
+    Sink& dest,
+    char const* p,
+    std::size_t n,
+    std::size_t prefix,
+    format_spec const& spec)
+{
+    if(! spec.zero || spec.align || spec.width <= n)
+        return write_padded(dest, p, n, spec, '>');
+    dest.append(p, prefix);
+    write_fill(dest, '0', spec.width - n);
+    dest.append(p + prefix, n - prefix);
+}
+
+inline
+void
+to_upper(
+    char* first,
+    char* last) noexcept
+{
+    for(; first != last; ++first)
+        if(*first >= 'a' && *first <= 'z')
+            *first = static_cast<char>(*first - 'a' + 'A');
+}
+
+template<class Sink, class T>
+void
+format_integer(
+    Sink& dest,
+    T v,
+    format_spec const& spec)
+{
+    using U = std::make_unsigned_t<T>;
+
+    int base = 10;
+    char const* prefix = "";
+    switch(spec.type)
+    {
+    case 'b': base = 2;  prefix = "0b"; break;
+    case 'o': base = 8;  prefix = "0";  break;
+    case 'x': base = 16; prefix = "0x"; break;
+    case 'X': base = 16; prefix = "0X"; break;
+    default:
+        break;
+    }
+
+    // sign, prefix and binary digits
+    char buf[3 + std::numeric_limits<U>::digits];
+    char* p = buf;
+    U u = static_cast<U>(v);
+    if constexpr(std::is_signed_v<T>)
+    {
+        if(v < 0)
         {
-            seg = next();
-            if(has_placeholder)
-                detail::throw_invalid_argument(
-                    "too few format arguments provided");
-            if(seg.size())
-                os.write(seg.data(), static_cast<std::streamsize>(seg.size()));
+            *p++ = '-';
+            u = static_cast<U>(U(0) - u);
         }
-        while(seg.size());
     }
-};
+    if(spec.alt)
+        for(; *prefix; ++prefix)
+            *p++ = *prefix;
+    auto const digits = p;
+    p = std::to_chars(p, buf + sizeof(buf), u, base).ptr;
+    if(spec.type == 'X')
+        to_upper(digits, p);
+    write_number(dest, buf,
+        static_cast<std::size_t>(p - buf),
+        static_cast<std::size_t>(digits - buf), spec);
+}
+
+template<class Sink, class T>
+void
+format_float(
+    Sink& dest,
+    T v,
+    format_spec const& spec)
+{
+    // Without a type, the output matches the
+    // default of an ostream
+    auto fmt = std::chars_format::general;
+    switch(spec.type)
+    {
+    case 'e': case 'E': fmt = std::chars_format::scientific; break;
+    case 'f': case 'F': fmt = std::chars_format::fixed; break;
+    default:
+        break;
+    }
+    int const precision = spec.has_precision ?
+        static_cast<int>(spec.precision) : 6;
+    bool const upper =
+        spec.type == 'E' || spec.type == 'F' || spec.type == 'G';
+
+    auto const finish =
+        [&](char* first, char* last)
+        {
+            if(upper)
+                to_upper(first, last);
+            write_number(dest, first,
+                static_cast<std::size_t>(last - first),
+                *first == '-' ? 1 : 0, spec);
+        };
+
+    char buf[128];
+    auto const r = std::to_chars(
+        buf, buf + sizeof(buf), v, fmt, precision);
+    if(r.ec == std::errc())
+        return finish(buf, r.ptr);
+
+    // only fixed notation of large values gets here
+    std::string big(static_cast<std::size_t>(
+        std::numeric_limits<T>::max_exponent10 + precision + 8), '\0');
+    auto const r2 = std::to_chars(
+        &big[0], &big[0] + big.size(), v, fmt, precision);
+    finish(&big[0], r2.ptr);
+}
+
+template<class Sink>
+void
+format_string_arg(
+    Sink& dest,
+    core::string_view s,
+    format_spec const& spec)
+{
+    auto n = s.size();
+    if(spec.has_precision && spec.precision < n)
+        n = spec.precision;
+    write_padded(dest, s.data(), n, spec, '<');
+}
+
+template<class T>
+concept format_streamable =
+    requires(std::ostream& os, T const& v)
+    {
+        os << v;
+    };
 
 class appendbuf : public std::streambuf
 {
@@ -184,18 +590,238 @@ public:
     }
 };
 
+template<class Sink, class T>
+void
+format_value(
+    Sink& dest,
+    T const& v,
+    format_spec const& spec)
+{
+    constexpr auto kind = format_kind_of<T>();
+    if constexpr(kind == format_kind::character)
+    {
+        if(spec.type && spec.type != 'c')
+            return format_integer(dest,
+                static_cast<int>(v), spec);
+        write_padded(dest, &v, 1, spec, '<');
+    }
+    else if constexpr(kind == format_kind::integer)
+    {
+        if constexpr(std::is_same_v<T, bool>)
+            format_integer(dest, static_cast<unsigned>(v), spec);
+        else
+            format_integer(dest, v, spec);
+    }
+    else if constexpr(kind == format_kind::floating)
+    {
+        format_float(dest, v, spec);
+    }
+    else if constexpr(kind == format_kind::string)
+    {
+        if constexpr(std::is_pointer_v<T>)
+        {
+            if(! v)
+                return format_string_arg(dest, "(null)", spec);
+        }
+        format_string_arg(dest, core::string_view(v), spec);
+    }
+    else if constexpr(kind == format_kind::pointer)
+    {
+        format_spec hex = spec;
+        hex.type = 'x';
+        hex.alt = true;
+        format_integer(dest,
+            reinterpret_cast<std::uintptr_t>(v), hex);
+    }
+    else
+    {
+        static_assert(format_streamable<T>,
+            "the type is not formattable");
+
+        // Other types go through their stream operator
+        std::string s;
+        appendstream os(s);
+        os << v;
+        write_padded(dest, s.data(), s.size(), spec, '<');
+    }
+}
+
+struct ostream_sink
+{
+    std::ostream& os;
+
+    void
+    append(char const* p, std::size_t n)
+    {
+        os.write(p, static_cast<std::streamsize>(n));
+    }
+};
+
+struct buffer_sink
+{
+    char* p;
+    char* end;
+    std::size_t n = 0;
+
+    void
+    append(char const* s, std::size_t len) noexcept
+    {
+        n += len;
+        auto const room = static_cast<std::size_t>(end - p);
+        if(len > room)
+            len = room;
+        if(len == 0)
+            return;
+        std::memcpy(p, s, len);
+        p += len;
+    }
+};
+
+struct format_access;
+
 } // detail
 
-/** Format arguments using a format string
+//------------------------------------------------
+
+/** A format string checked against its argument types.
+
+    A string literal is parsed when the program is
+    compiled. An unbalanced brace, too few arguments, or
+    a spec which does not fit the type of its argument
+    is a compile error, and formatting needs no parsing.
+
+    Other strings are parsed each time they are used,
+    and the same mistakes throw `std::invalid_argument`
+    before any output is produced.
+
+    Arguments beyond the last field are ignored.
 */
 template<class... Args>
+class format_string
+{
+    static constexpr std::size_t max_fields =
+        sizeof...(Args) > 0 ? sizeof...(Args) : 1;
+
+    friend struct detail::format_access;
+
+    core::string_view s_;
+    detail::format_field fields_[max_fields];
+    detail::format_text tail_;
+    std::size_t n_ = 0;
+    bool checked_ = false;
+
+public:
+    /** Constructor.
+
+        The literal is parsed and checked at compile time.
+    */
+    template<std::size_t N>
+    consteval
+    format_string(char const (&s)[N])
+        : s_(s, N - 1)
+        , checked_(true)
+    {
+        n_ = detail::parse_format(
+            s, N - 1, fields_, sizeof...(Args), tail_);
+        detail::check_format_fields<Args...>(fields_, n_);
+    }
+
+    /** Constructor.
+
+        The string is parsed and checked when it is used.
+    */
+    template<class S>
+        requires (! std::is_array_v<S>) &&
+            std::is_convertible_v<S const&, core::string_view>
+    format_string(S const& s) noexcept
+        : s_(s)
+    {
+    }
+
+    /** Return the format string.
+    */
+    core::string_view
+    get() const noexcept
+    {
+        return s_;
+    }
+
+    /** Return true if the string was checked at compile time.
+
+        Such a string is a literal.
+    */
+    bool
+    checked() const noexcept
+    {
+        return checked_;
+    }
+};
+
+namespace detail {
+
+struct format_access
+{
+    template<class Sink, class... Args>
+    static
+    void
+    emit(
+        Sink& dest,
+        char const* s,
+        format_field const* fields,
+        std::size_t n,
+        format_text const& tail,
+        Args const&... args)
+    {
+        std::size_t i = 0;
+        auto const one =
+            [&](auto const& arg)
+            {
+                if(i == n)
+                    return;
+                write_text(dest, s, fields[i].text);
+                format_value(dest, arg, fields[i].spec);
+                ++i;
+            };
+        (void)one;
+        (one(args), ...);
+        write_text(dest, s, tail);
+    }
+
+    template<class Sink, class... Args>
+    static
+    void
+    write(
+        Sink& dest,
+        format_string<Args...> const& fs,
+        Args const&... args)
+    {
+        if(fs.checked_)
+            return emit(dest, fs.s_.data(),
+                fs.fields_, fs.n_, fs.tail_, args...);
+
+        format_field fields[format_string<Args...>::max_fields];
+        format_text tail;
+        auto const n = parse_format(fs.s_.data(), fs.s_.size(),
+            fields, sizeof...(Args), tail);
+        check_format_fields<Args...>(fields, n);
+        emit(dest, fs.s_.data(), fields, n, tail, args...);
+    }
+};
+
+} // detail
+
+/** Format arguments using a format string
+
+    The output is appended to the sink.
+*/
+template<format_sink Sink, class... Args>
 void
 format_to(
-    std::ostream& os,
-    core::string_view fs,
+    Sink& dest,
+    format_string<std::type_identity_t<Args>...> fs,
     Args const&... args)
 {
-    detail::format_impl(os, fs)(args...);
+    detail::format_access::write(dest, fs, args...);
 }
 
 /** Format arguments using a format string
@@ -203,12 +829,33 @@ format_to(
 template<class... Args>
 void
 format_to(
-    std::string& dest,
-    core::string_view fs,
+    std::ostream& os,
+    format_string<std::type_identity_t<Args>...> fs,
+    Args const&... args)
+{
+    detail::ostream_sink dest{ os };
+    detail::format_access::write(dest, fs, args...);
+}
+
+/** Format arguments into a buffer
+
+    At most `size` characters are written, and no null
+    terminator is added.
+
+    @return The length of the whole output, which is
+        more than `size` if the output was truncated.
+*/
+template<class... Args>
+std::size_t
+format_to(
+    char* dest,
+    std::size_t size,
+    format_string<std::type_identity_t<Args>...> fs,
     Args const&... args)
 {
-    detail::appendstream ss(dest);
-    format_to(ss, fs, args...);
+    detail::buffer_sink s{ dest, dest + size };
+    detail::format_access::write(s, fs, args...);
+    return s.n;
 }
 
 } // beast2
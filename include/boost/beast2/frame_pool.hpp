@@ -0,0 +1,136 @@
+//
+// Copyright (c) 2026 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/beast2
+//
+
+#ifndef BOOST_BEAST2_FRAME_POOL_HPP
+#define BOOST_BEAST2_FRAME_POOL_HPP
+
+#include <boost/beast2/detail/config.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+
+namespace boost {
+namespace beast2 {
+
+/** Counters describing a @ref frame_pool.
+*/
+struct frame_pool_stats
+{
+    /// Blocks handed out.
+    std::uint64_t allocations = 0;
+
+    /** Blocks obtained from the upstream resource.
+
+        Once a worker has warmed up, this stops growing.
+    */
+    std::uint64_t heap_allocations = 0;
+
+    /// Bytes held on the free lists.
+    std::size_t cached_bytes = 0;
+};
+
+/** A recycling allocator for coroutine frames.
+
+    Frames are rounded up to one of a few power-of-two
+    size classes. A freed frame goes onto the free list
+    of its class and is handed out again to the next
+    frame of that class, so a worker which runs the same
+    handlers over and over stops calling the upstream
+    resource after the first few requests. Frames larger
+    than the largest class, or with extended alignment,
+    go straight to the upstream resource.
+
+    @par Thread Safety
+    Distinct objects: Safe.
+    Shared objects: Unsafe. A pool belongs to one worker,
+    which runs on one thread at a time.
+
+    @see http_worker
+*/
+class BOOST_BEAST2_DECL
+    frame_pool
+    : public std::pmr::memory_resource
+{
+public:
+    /// The smallest size class, in bytes.
+    static constexpr std::size_t min_size = 64;
+
+    /// The largest size class, in bytes.
+    static constexpr std::size_t max_size = 4096;
+
+    /// Destructor.
+    ~frame_pool();
+
+    /** Constructor.
+
+        @param max_cached The most free blocks kept per
+            size class. Blocks freed beyond this go back
+            to the upstream resource.
+        @param upstream The resource blocks come from.
+    */
+    explicit
+    frame_pool(
+        std::size_t max_cached = 1024,
+        std::pmr::memory_resource* upstream =
+            std::pmr::new_delete_resource()) noexcept;
+
+    frame_pool(frame_pool const&) = delete;
+    frame_pool& operator=(frame_pool const&) = delete;
+
+    /** Return the counters.
+    */
+    frame_pool_stats
+    get_stats() const noexcept;
+
+    /** Return every free block to the upstream resource.
+    */
+    void
+    release() noexcept;
+
+private:
+    static constexpr std::size_t classes = 7; // 64 ... 4096
+
+    struct free_block
+    {
+        free_block* next;
+    };
+
+    struct free_list
+    {
+        free_block* head = nullptr;
+        std::size_t count = 0;
+    };
+
+    static std::size_t class_of(std::size_t bytes) noexcept;
+
+    void*
+    do_allocate(
+        std::size_t bytes,
+        std::size_t alignment) override;
+
+    void
+    do_deallocate(
+        void* p,
+        std::size_t bytes,
+        std::size_t alignment) override;
+
+    bool
+    do_is_equal(
+        std::pmr::memory_resource const& other) const noexcept override;
+
+    free_list lists_[classes];
+    std::size_t max_cached_;
+    std::pmr::memory_resource* upstream_;
+    frame_pool_stats st_;
+};
+
+} // beast2
+} // boost
+
+#endif
@@ -0,0 +1,273 @@
+//
+// Copyright (c) 2026 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/beast2
+//
+
+#ifndef BOOST_BEAST2_HTML_TEMPLATE_HPP
+#define BOOST_BEAST2_HTML_TEMPLATE_HPP
+
+#include <boost/beast2/detail/config.hpp>
+#include <boost/beast2/body_writer.hpp>
+#include <boost/beast2/format.hpp>
+#include <boost/capy/task.hpp>
+#include <boost/core/detail/string_view.hpp>
+#include <boost/system/error_code.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace boost {
+namespace beast2 {
+
+/** Writes the value of a slot while a template renders.
+
+    The writer is a sink for @ref format_to. Unless the
+    slot is raw, characters special to HTML are replaced
+    by entities as they are written.
+*/
+class BOOST_BEAST2_DECL
+    html_writer
+{
+    void* dest_;
+    void (*append_)(void*, char const*, std::size_t);
+    bool escape_ = true;
+
+    friend class html_template;
+
+public:
+    /** Constructor.
+
+        @param dest The sink receiving the output.
+    */
+    template<format_sink Sink>
+    explicit
+    html_writer(Sink& dest) noexcept
+        : dest_(&dest)
+        , append_(
+            [](void* p, char const* data, std::size_t size)
+            {
+                static_cast<Sink*>(p)->append(data, size);
+            })
+    {
+    }
+
+    /** Write text.
+    */
+    void
+    append(
+        char const* data,
+        std::size_t size);
+
+    /** Write text.
+    */
+    void
+    text(core::string_view s)
+    {
+        append(s.data(), s.size());
+    }
+};
+
+//------------------------------------------------
+
+/** An HTML template compiled for repeated rendering.
+
+    The template text is parsed once, into a flat list
+    of literal slices and slots. Rendering walks the
+    list, appending each slice to the sink as it is and
+    asking a function for the value of each slot, so no
+    part of the template is examined again and no
+    intermediate string is built.
+
+    Slots are named, and the syntax follows Mustache:
+
+    @li `{{name}}` is text, escaped for HTML.
+    @li `{{{name}}}` is written as is.
+    @li `{{#name}}` ... `{{/name}}` is a section, rendered
+        once for each row.
+
+    @code
+    html_template const t(
+        "<ul>{{#items}}<li>{{item}}</li>{{/items}}</ul>");
+    auto const items = t.slot("items");
+    auto const item = t.slot("item");
+
+    std::vector<std::string> v = { "a", "b&c" };
+    std::string s;
+    t.render(s,
+        [&](std::size_t slot, std::size_t row, html_writer& w)
+        {
+            if(slot == items)
+                return row < v.size();
+            if(slot == item)
+                w.text(v[row]);
+            return false;
+        });
+    // s == "<ul><li>a</li><li>b&amp;c</li></ul>"
+    @endcode
+
+    The function is invoked as `fill(slot, row, w)` and
+    returns `bool`. For a section it is invoked with rows
+    0, 1, 2 and so on, and returns whether to render that
+    row. For any other slot it writes the value to `w`,
+    and the result is ignored. `row` is the current row of
+    the innermost enclosing section, or zero.
+
+    @par Thread Safety
+    Distinct objects: Safe.
+    Shared objects: Safe for `const` member functions.
+*/
+class BOOST_BEAST2_DECL
+    html_template
+{
+public:
+    /** Constructor.
+
+        @param text The template.
+
+        @throws std::invalid_argument The template is
+            malformed.
+    */
+    explicit
+    html_template(core::string_view text);
+
+    /** Return the index of a slot.
+
+        @throws std::invalid_argument No slot has the name.
+    */
+    std::size_t
+    slot(core::string_view name) const;
+
+    /** Return the number of distinct slots.
+    */
+    std::size_t
+    slots() const noexcept
+    {
+        return names_.size();
+    }
+
+    /** Render the template.
+
+        @param dest The sink receiving the output.
+        @param fill The function producing slot values.
+    */
+    template<format_sink Sink, class Fill>
+        requires (! std::is_same_v<Sink, body_writer>)
+    void
+    render(
+        Sink& dest,
+        Fill&& fill) const
+    {
+        html_writer w(dest);
+        cursor c(*this);
+        render_some(c, w, &fill, &call<
+            std::remove_reference_t<Fill>>, nullptr);
+    }
+
+    /** Render the template into a response body.
+
+        The walk pauses whenever the prepared space of `w`
+        is used up, and resumes once @ref body_writer::flush
+        completes, so no more than about one slot value is
+        ever held in memory. The body is not finished.
+
+        @param w The writer receiving the output.
+        @param fill The function producing slot values.
+
+        @return The error from a flush, if any.
+    */
+    template<class Fill>
+    capy::task<system::error_code>
+    render(
+        body_writer& w,
+        Fill fill) const
+    {
+        html_writer out(w);
+        cursor c(*this);
+        while(! render_some(c, out, &fill,
+            &call<Fill>, &w))
+            if(auto ec = co_await w.flush())
+                co_return ec;
+        co_return system::error_code();
+    }
+
+private:
+    using fill_fn = bool(*)(
+        void*, std::size_t, std::size_t, html_writer&);
+
+    struct op
+    {
+        enum kind_t : unsigned char
+        {
+            literal,
+            text,
+            raw,
+            section
+        };
+
+        kind_t kind;
+
+        // literal: offset in text_
+        // other: slot
+        std::uint32_t a;
+
+        // literal: length
+        // section: index one past its last op
+        std::uint32_t b;
+    };
+
+    // A section being rendered
+    struct frame
+    {
+        std::size_t next;   // index of the next op
+        std::size_t last;   // one past the last op
+        std::size_t row;
+        std::size_t sec;    // the section op, or npos
+    };
+
+    // Where a paused walk resumes
+    struct cursor
+    {
+        explicit
+        cursor(html_template const& t);
+
+        std::vector<frame> stack;
+    };
+
+    template<class F>
+    static
+    bool
+    call(
+        void* f,
+        std::size_t slot,
+        std::size_t row,
+        html_writer& w)
+    {
+        return (*static_cast<F*>(f))(slot, row, w);
+    }
+
+    // Returns true when done, false when `w` is full
+    bool
+    render_some(
+        cursor& c,
+        html_writer& out,
+        void* f,
+        fill_fn fn,
+        body_writer const* w) const;
+
+    std::string text_;
+    std::vector<op> ops_;
+    std::vector<std::string> names_;
+    std::vector<bool> is_section_;
+    std::size_t depth_ = 0;
+};
+
+} // beast2
+} // boost
+
+#endif
@@ -11,6 +11,9 @@
 #define BOOST_BEAST2_HTTP_SERVER_HPP
 
 #include <boost/beast2/detail/config.hpp>
+#include <boost/beast2/frame_pool.hpp>
+#include <boost/beast2/server_config.hpp>
+#include <boost/beast2/shared_router.hpp>
 #include <boost/corosio/tcp_server.hpp>
 #include <boost/corosio/io_context.hpp>
 #include <boost/http/config.hpp>
@@ -27,6 +30,16 @@ namespace beast2 {
     through a router. Each connection is handled by a worker that
     processes requests using coroutines.
 
+    The number of concurrent connections is bounded by
+    @ref server_config::max_workers. Parser and serializer
+    state is taken from an elastic pool which grows when
+    every pooled object is busy and shrinks back towards
+    @ref server_config::min_workers when load drops.
+
+    Under overload, new connections are answered with a
+    pre-serialized `503 Service Unavailable` instead of
+    waiting in the kernel backlog; see @ref admission_config.
+
     @par Thread Safety
     Distinct objects: Safe.
     Shared objects: Unsafe.
@@ -62,6 +75,10 @@ public:
 
     /** Construct an HTTP server.
 
+        All worker objects are allocated up front; this is
+        equivalent to a @ref server_config with both bounds
+        set to `num_workers`.
+
         @param ctx The I/O context for asynchronous operations.
         @param num_workers Number of worker objects for handling
             connections concurrently.
@@ -76,6 +93,104 @@ public:
         http::flat_router router,
         http::shared_parser_config parser_cfg,
         http::shared_serializer_config serializer_cfg);
+
+    /** Construct an HTTP server.
+
+        @param ctx The I/O context for asynchronous operations.
+        @param cfg The server configuration.
+        @param router The shared router for dispatching requests to
+            handlers. The routing table is not copied.
+        @param parser_cfg Shared configuration for request parsers.
+        @param serializer_cfg Shared configuration for response
+            serializers.
+    */
+    http_server(
+        corosio::io_context& ctx,
+        server_config const& cfg,
+        shared_router router,
+        http::shared_parser_config parser_cfg,
+        http::shared_serializer_config serializer_cfg);
+
+    /** Return the connection pool counters.
+
+        This function may be called from any thread.
+    */
+    pool_stats
+    get_pool_stats() const;
+
+    /** Return the overload admission counters.
+
+        This function may be called from any thread.
+
+        @see admission_config
+    */
+    admission_stats
+    get_admission_stats() const;
+
+    /** Return the connection counters.
+
+        This function may be called from any thread.
+    */
+    connection_stats
+    get_connection_stats() const noexcept;
+
+    /** Return the coroutine frame counters.
+
+        The counters of every connection's @ref frame_pool
+        are summed. A connection adds its share each time
+        a session ends.
+
+        This function may be called from any thread.
+    */
+    frame_pool_stats
+    get_frame_stats() const noexcept;
+
+    /** Stop the server gracefully.
+
+        The server stops accepting and closes idle
+        keep-alive connections. Every other connection is
+        sent `Connection: close` on its next response and
+        closed once that response is written. Connections
+        still open after @ref server_config::drain_timeout
+        are cancelled. Once the last connection is closed
+        the server has no more work, and the I/O context
+        may return from `run`.
+
+        This function returns immediately, and may be
+        called from any thread. Calling it again has no
+        effect.
+    */
+    void
+    drain();
+
+    /** Replace the routing table.
+
+        Requests which are already being dispatched complete
+        on the table they started with; every request whose
+        dispatch begins after this call returns uses the new
+        table. Connections are not interrupted. The request
+        path takes no locks: while the table is unchanged a
+        worker only loads a version number, and after a
+        replacement it copies the new handle once.
+
+        The old table is destroyed once the last worker
+        holding it has moved on. A worker moves on at the
+        start of its next request, so pooled workers which
+        sit idle keep the old table alive until they serve
+        another connection or are released by the pool.
+        This function may be called from any thread.
+
+        @param router The new router.
+    */
+    void
+    replace_router(http::flat_router router);
+
+    /** Replace the routing table.
+
+        @param router The new shared router.
+    */
+    void
+    replace_router(shared_router router);
 };
 
 } // beast2
@@ -11,6 +11,16 @@
 #define BOOST_BEAST2_HTTP_WORKER_HPP
 
 #include <boost/beast2/detail/config.hpp>
+#include <boost/beast2/detail/request_slots.hpp>
+#include <boost/beast2/frame_pool.hpp>
+#include <boost/beast2/metrics_service.hpp>
+#include <boost/beast2/request_arena.hpp>
+#include <boost/beast2/request_trace.hpp>
+#include <boost/beast2/response_tap.hpp>
+#include <boost/beast2/send_file.hpp>
+#include <boost/beast2/server_config.hpp>
+#include <boost/beast2/shared_router.hpp>
+#include <boost/beast2/timer_wheel.hpp>
 #include <boost/capy/io/any_read_stream.hpp>
 #include <boost/capy/task.hpp>
 #include <boost/http/config.hpp>
@@ -18,6 +28,9 @@
 #include <boost/http/serializer.hpp>
 #include <boost/http/server/flat_router.hpp>
 #include <boost/http/server/router.hpp>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
 
 namespace boost {
 namespace beast2 {
@@ -35,12 +48,18 @@ namespace beast2 {
     @ref corosio::tcp_server::worker_base and `http_worker`.
     The derived class must:
 
-    @li Construct `http_worker` with a router and configurations
+    @li Construct `http_worker` with a shared router and
+        configurations
     @li Initialize the @ref stream member before calling
         @ref do_http_session
     @li Wire the parser and serializer to the socket by setting
         `rp.req_body` and `rp.res_body`
 
+    To enforce @ref timeouts, the derived class also points
+    @ref wheel at the timer wheel of its I/O context and sets
+    the handler of @ref deadline, typically to cancel the
+    socket's pending operations.
+
     @par Example
     @code
     struct my_worker
@@ -51,7 +70,7 @@ namespace beast2 {
 
         my_worker(
             corosio::io_context& ctx,
-            http::flat_router const& router,
+            shared_router const& router,
             http::shared_parser_config parser_cfg,
             http::shared_serializer_config serializer_cfg)
             : http_worker(router, parser_cfg, serializer_cfg)
@@ -80,15 +99,132 @@ namespace beast2 {
 */
 class BOOST_BEAST2_DECL http_worker
 {
+    router_slot const* slot_ = nullptr;
+    detail::request_slots slots_;
+    std::uint64_t version_ = 0;
+    bool idle_ = false;
+
 public:
-    http::flat_router fr;
+    shared_router fr;
+
+    /** Recycled memory for coroutine frames.
+
+        Installed as the frame allocator while the dispatch
+        of a request is created, so the frames of the route
+        handlers are drawn from free lists kept across
+        requests.
+        Declared before @ref rp, whose handlers may hold
+        frames from it.
+    */
+    frame_pool frames;
+
+    /** Scratch memory for the current request.
+
+        Reset before each request, and published in the
+        route parameters where @ref get_arena finds it.
+        Declared before @ref rp, which may hold objects
+        using it.
+    */
+    request_arena arena;
+
     http::route_params rp;
     capy::any_read_stream stream;
     http::request_parser parser;
     http::serializer serializer;
 
+    /** Deadlines applied by @ref do_http_session.
+    */
+    timeout_config timeouts;
+
+    /** Most bytes of an unread request body discarded.
+
+        @see server_config::unread_body_limit
+    */
+    std::size_t unread_body_limit = 64 * 1024;
+
+    /** The wheel deadlines are armed on.
+
+        If null, no deadlines are enforced.
+    */
+    timer_wheel* wheel = nullptr;
+
+    /** The connection's current deadline.
+
+        Its handler is invoked when a phase of the session
+        takes longer than allowed by @ref timeouts.
+    */
+    timer_wheel::entry deadline;
+
+    /** A flag asking the session to close.
+
+        If set and true when a request is dispatched, the
+        response is sent with `Connection: close`. The
+        session ends after its current response, and does
+        not wait for another request.
+    */
+    std::atomic<bool> const* closing = nullptr;
+
+    /** The zero-copy file sender of the connection.
+
+        If set, it is published in the route parameters of
+        every request, where @ref send_file finds it.
+    */
+    file_sender* sender = nullptr;
+
+    /** The tap between the serializer and the connection.
+
+        If set, it is published in the route parameters of
+        every request, and is told when each request has
+        been handled.
+    */
+    response_tap* tap = nullptr;
+
+    /** The receiver of request timestamps.
+
+        If set, each request is timestamped in @ref trace
+        and handed to the tracer once it has been handled.
+    */
+    request_tracer* tracer = nullptr;
+
+    /** The timestamps of the current request.
+
+        The worker stamps every point except
+        @ref trace_point::last_byte, which is stamped
+        by the derived class when its output stream
+        writes. A derived class which accepts before the
+        session starts may stamp @ref trace_point::accept
+        itself; otherwise the start of the session is used.
+    */
+    request_trace trace;
+
+    /** The metrics updated by each request.
+
+        If set, each response is counted by status class,
+        and its latency is recorded in the histogram of
+        its route.
+    */
+    server_metrics const* metrics = nullptr;
+
     /** Construct an HTTP worker.
 
+        The routing table is shared with every other worker
+        constructed from the same handle; it is not copied.
+
+        @param fr_ The router for dispatching requests to handlers.
+        @param parser_cfg Shared configuration for the request parser.
+        @param serializer_cfg Shared configuration for the response
+            serializer.
+    */
+    http_worker(
+        shared_router fr_,
+        http::shared_parser_config parser_cfg,
+        http::shared_serializer_config serializer_cfg);
+
+    /** Construct an HTTP worker.
+
+        The router is moved into a new @ref shared_router
+        owned by this worker alone.
+
         @param fr_ The router for dispatching requests to handlers.
         @param parser_cfg Shared configuration for the request parser.
         @param serializer_cfg Shared configuration for the response
@@ -99,6 +235,22 @@ public:
         http::shared_parser_config parser_cfg,
         http::shared_serializer_config serializer_cfg);
 
+    /** Construct an HTTP worker.
+
+        The worker dispatches through the table currently
+        published in `slot`, and picks up replacements
+        between requests. The slot must outlive the worker.
+
+        @param slot The slot publishing the routing table.
+        @param parser_cfg Shared configuration for the request parser.
+        @param serializer_cfg Shared configuration for the response
+            serializer.
+    */
+    http_worker(
+        router_slot const& slot,
+        http::shared_parser_config parser_cfg,
+        http::shared_serializer_config serializer_cfg);
+
     /** Handle an HTTP session.
 
         This coroutine reads HTTP requests, dispatches them through
@@ -106,10 +258,64 @@ public:
         closed or an error occurs. The stream data member must be
         initialized before calling this function.
 
+        Bytes read past the end of a request are kept, so that
+        pipelined requests are parsed from the buffer as soon as
+        the previous response is written, and responses go out
+        in request order. Responses are not overlapped with
+        parsing: the next request is only parsed once the
+        current response has been written.
+
+        If a handler does not read the whole request body, up
+        to @ref unread_body_limit remaining bytes are read and
+        discarded, and the connection is kept. A longer
+        remainder closes the connection after the response,
+        which may already have been sent with keep-alive; a
+        pipelined request behind it then gets no response.
+
         @return An awaitable that completes when the session ends.
     */
     capy::task<void>
     do_http_session();
+
+    /** Return true if the session is waiting for another request.
+
+        An idle session is waiting for a request header and
+        has received no byte of it, so it can be closed
+        without losing a request in flight. This holds
+        before the first request as well as between
+        requests. Bytes of a pipelined request which
+        arrived together with the previous one are not
+        seen here.
+    */
+    bool
+    is_idle() const noexcept
+    {
+        return idle_;
+    }
+
+protected:
+    /** Return true if requests are being traced.
+
+        This is always `false` when the library is built
+        with `BOOST_BEAST2_NO_REQUEST_TRACE`. The macro is
+        only seen where the library is compiled, so this
+        is defined there, and code including this header
+        need not agree on it.
+    */
+    bool
+    tracing() const noexcept;
+
+    /** Stamp a point of @ref trace, if tracing.
+    */
+    void
+    mark(trace_point p) noexcept;
+
+private:
+    capy::task<bool> discard_body();
+    void set_deadline(timer_wheel::duration d) noexcept;
+    bool is_closing() const noexcept;
+    void record_metrics(
+        std::chrono::steady_clock::time_point started) noexcept;
 };
 
 } // beast2
@@ -11,6 +11,9 @@
 #define BOOST_BEAST2_HTTPS_SERVER_HPP
 
 #include <boost/beast2/detail/config.hpp>
+#include <boost/beast2/frame_pool.hpp>
+#include <boost/beast2/server_config.hpp>
+#include <boost/beast2/shared_router.hpp>
 #include <boost/corosio/tcp_server.hpp>
 #include <boost/corosio/io_context.hpp>
 #include <boost/corosio/tls_context.hpp>
@@ -29,6 +32,16 @@ namespace beast2 {
     by a worker that processes requests using coroutines over an
     encrypted TLS stream.
 
+    As with @ref http_server, connection slots are bounded by
+    @ref server_config::max_workers while the TLS, parser and
+    serializer state is drawn from an elastic pool.
+
+    All connections share one TLS context and one session
+    cache, so a client may resume its session on a later
+    connection; see @ref tls_session_config. Handshakes
+    may be moved off the event loop with
+    @ref server_config::handshake_pool.
+
     @par Thread Safety
     Distinct objects: Safe.
     Shared objects: Unsafe.
@@ -71,12 +84,16 @@ public:
 
     /** Construct an HTTPS server.
 
+        All worker objects are allocated up front; this is
+        equivalent to a @ref server_config with both bounds
+        set to `num_workers`.
+
         @param ctx The I/O context for asynchronous operations.
         @param num_workers Number of worker objects for handling
             connections concurrently.
         @param tls_ctx The TLS context containing certificate and
-            key configuration. The context is copied and shared
-            among all workers.
+            key configuration. The context is shared among all
+            connections.
         @param router The router for dispatching requests to handlers.
         @param parser_cfg Shared configuration for request parsers.
         @param serializer_cfg Shared configuration for response
@@ -89,6 +106,116 @@ public:
         http::flat_router router,
         http::shared_parser_config parser_cfg,
         http::shared_serializer_config serializer_cfg);
+
+    /** Construct an HTTPS server.
+
+        @param ctx The I/O context for asynchronous operations.
+        @param cfg The server configuration.
+        @param tls_ctx The TLS context containing certificate and
+            key configuration.
+        @param router The shared router for dispatching requests to
+            handlers. The routing table is not copied.
+        @param parser_cfg Shared configuration for request parsers.
+        @param serializer_cfg Shared configuration for response
+            serializers.
+    */
+    https_server(
+        corosio::io_context& ctx,
+        server_config const& cfg,
+        corosio::tls_context tls_ctx,
+        shared_router router,
+        http::shared_parser_config parser_cfg,
+        http::shared_serializer_config serializer_cfg);
+
+    /** Return the connection pool counters.
+
+        This function may be called from any thread.
+    */
+    pool_stats
+    get_pool_stats() const;
+
+    /** Return the overload admission counters.
+
+        This function may be called from any thread.
+
+        @see admission_config
+    */
+    admission_stats
+    get_admission_stats() const;
+
+    /** Return the connection counters.
+
+        This function may be called from any thread.
+    */
+    connection_stats
+    get_connection_stats() const noexcept;
+
+    /** Return the coroutine frame counters.
+
+        The counters of every connection's @ref frame_pool
+        are summed. A connection adds its share each time
+        a session ends.
+
+        This function may be called from any thread.
+    */
+    frame_pool_stats
+    get_frame_stats() const noexcept;
+
+    /** Return the TLS handshake counters.
+
+        This function may be called from any thread.
+
+        @see tls_session_config
+    */
+    tls_stats
+    get_tls_stats() const;
+
+    /** Stop the server gracefully.
+
+        The server stops accepting and closes idle
+        keep-alive connections. Every other connection is
+        sent `Connection: close` on its next response and
+        closed once that response is written. Connections
+        still open after @ref server_config::drain_timeout
+        are cancelled. Once the last connection is closed
+        the server has no more work, and the I/O context
+        may return from `run`.
+
+        This function returns immediately, and may be
+        called from any thread. Calling it again has no
+        effect.
+    */
+    void
+    drain();
+
+    /** Replace the routing table.
+
+        Requests which are already being dispatched complete
+        on the table they started with; every request whose
+        dispatch begins after this call returns uses the new
+        table. Connections are not interrupted. The request
+        path takes no locks: while the table is unchanged a
+        worker only loads a version number, and after a
+        replacement it copies the new handle once.
+
+        The old table is destroyed once the last worker
+        holding it has moved on. A worker moves on at the
+        start of its next request, so pooled workers which
+        sit idle keep the old table alive until they serve
+        another connection or are released by the pool.
+        This function may be called from any thread.
+
+        @param router The new router.
+    */
+    void
+    replace_router(http::flat_router router);
+
+    /** Replace the routing table.
+
+        @param router The new shared router.
+    */
+    void
+    replace_router(shared_router router);
 };
 
 } // beast2
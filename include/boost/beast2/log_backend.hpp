@@ -0,0 +1,250 @@
+//
+// Copyright (c) 2026 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/beast2
+//
+
+#ifndef BOOST_BEAST2_LOG_BACKEND_HPP
+#define BOOST_BEAST2_LOG_BACKEND_HPP
+
+#include <boost/beast2/detail/config.hpp>
+#include <boost/core/detail/string_view.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace boost {
+namespace beast2 {
+
+/** A destination for batches of log records.
+
+    The sink is only called from the logging thread of a
+    @ref log_backend, with a batch of whole records each
+    ending in a newline.
+*/
+class BOOST_SYMBOL_VISIBLE
+    log_sink
+{
+public:
+    virtual ~log_sink() = default;
+
+    /** Write a batch of records.
+    */
+    virtual
+    void
+    write(
+        char const* data,
+        std::size_t size) = 0;
+};
+
+/** A log sink writing to a file descriptor.
+
+    This covers standard error, a regular file, a pipe or
+    an anonymous memory file.
+*/
+class BOOST_BEAST2_DECL
+    fd_log_sink
+    : public log_sink
+{
+    int fd_;
+    bool owned_;
+
+public:
+    /** Destructor.
+
+        The descriptor is closed if it is owned.
+    */
+    ~fd_log_sink();
+
+    /** Constructor.
+
+        @param fd The descriptor to write to.
+        @param owned Whether the sink closes the descriptor.
+    */
+    explicit
+    fd_log_sink(
+        int fd,
+        bool owned = false) noexcept;
+
+    fd_log_sink(fd_log_sink const&) = delete;
+    fd_log_sink& operator=(fd_log_sink const&) = delete;
+
+    /** Return a sink writing to standard error.
+    */
+    static
+    std::shared_ptr<fd_log_sink>
+    stderr_sink();
+
+    /** Return a sink appending to a file.
+
+        The file is created if it does not exist.
+
+        @throws system::system_error The file could not
+            be opened.
+    */
+    static
+    std::shared_ptr<fd_log_sink>
+    open(core::string_view path);
+
+#ifdef __linux__
+    /** Return a sink writing to an anonymous memory file.
+
+        The records can be read back through
+        @ref native_handle, for example by a crash handler.
+
+        @throws system::system_error The file could not
+            be created.
+    */
+    static
+    std::shared_ptr<fd_log_sink>
+    memfd(core::string_view name);
+#endif
+
+    /** Return the descriptor.
+    */
+    int
+    native_handle() const noexcept
+    {
+        return fd_;
+    }
+
+    void
+    write(
+        char const* data,
+        std::size_t size) override;
+};
+
+/** A function appending the text of a binary log record.
+
+    @param data The bytes of the record.
+    @param size The number of bytes.
+    @param dest The string to append to.
+*/
+using log_decoder = void(*)(
+    char const* data,
+    std::size_t size,
+    std::string& dest);
+
+/** What a producer does when the log buffer is full.
+*/
+enum class log_overflow
+{
+    /// The record is discarded and counted.
+    drop,
+
+    /// The producer waits for room.
+    block
+};
+
+/** Counters describing a @ref log_backend.
+*/
+struct log_backend_stats
+{
+    /// Records handed to the sink.
+    std::uint64_t written = 0;
+
+    /// Records discarded because the buffer was full,
+    /// or because their decoder or the sink threw.
+    std::uint64_t dropped = 0;
+
+    /// Records whose producer waited for room.
+    std::uint64_t blocked = 0;
+
+    /// Calls made to the sink.
+    std::uint64_t batches = 0;
+};
+
+/** An asynchronous writer of log records.
+
+    Producers copy each record into a bounded ring of
+    slots and return; a background thread takes records
+    from the ring in order and hands them to the sink in
+    large batches. Putting a record in the ring takes no
+    lock. Records short enough to fit a slot are copied
+    inline; longer ones are copied to the heap.
+
+    When the ring is full the record is dropped or the
+    producer waits, as set by @ref set_overflow. Dropped
+    records are counted.
+
+    @par Thread Safety
+    Distinct objects: Safe.
+    Shared objects: Safe.
+*/
+class BOOST_BEAST2_DECL
+    log_backend
+{
+public:
+    /** Destructor.
+
+        Records already in the ring are written before
+        the background thread exits.
+    */
+    ~log_backend();
+
+    /** Constructor.
+
+        @param capacity The number of slots in the ring,
+            rounded up to a power of two.
+        @param sink The initial sink. If null, records go
+            to standard error.
+    */
+    explicit
+    log_backend(
+        std::size_t capacity = 8192,
+        std::shared_ptr<log_sink> sink = nullptr);
+
+    log_backend(log_backend const&) = delete;
+    log_backend& operator=(log_backend const&) = delete;
+
+    /** Replace the sink.
+
+        Records already in the ring may go to either sink.
+    */
+    void
+    set_sink(std::shared_ptr<log_sink> sink);
+
+    /** Set the overflow policy.
+    */
+    void
+    set_overflow(log_overflow policy) noexcept;
+
+    /** Put a record in the ring.
+
+        A newline is appended when the record is written.
+
+        @param record The bytes of the record.
+        @param decode If set, the record is binary, and
+            this is called on the logging thread to turn
+            it into text. Otherwise the record is text.
+
+        @return `false` if the record was dropped.
+    */
+    bool
+    push(
+        core::string_view record,
+        log_decoder decode = nullptr) noexcept;
+
+    /** Wait until every record pushed so far is written.
+    */
+    void
+    flush();
+
+    /** Return the counters.
+    */
+    log_backend_stats
+    get_stats() const noexcept;
+
+private:
+    struct impl;
+    std::unique_ptr<impl> impl_;
+};
+
+} // beast2
+} // boost
+
+#endif
@@ -35,6 +35,27 @@ public:
     auto
     get_sections() const noexcept ->
         std::vector<section> = 0;
+
+    /** Set the threshold of a section by name
+
+        Messages below the level are not formatted or
+        written. Unlike @ref get_section, this does not
+        create a section, so that a name taken from a
+        request cannot add one.
+        @param name The section name.
+        @param level The new threshold.
+        @return `false` if no section has the name.
+    */
+    virtual bool set_threshold(
+        core::string_view name,
+        int level) = 0;
+
+    /** Return the backend which writes log records
+
+        Use it to choose the sink and the overflow
+        policy, and to read the drop counters.
+    */
+    virtual log_backend& get_backend() noexcept = 0;
 };
 
 /** Return the log service from the system context
@@ -12,9 +12,13 @@
 
 #include <boost/beast2/detail/config.hpp>
 #include <boost/beast2/format.hpp>
+#include <boost/beast2/log_backend.hpp>
+#include <boost/beast2/detail/log_record.hpp>
+#include <atomic>
 #include <memory>
 #include <sstream>
 #include <string>
+#include <type_traits>
 #include <vector>
 
 namespace boost {
@@ -35,18 +39,68 @@ struct section
     }
 
     /** Return the level below which logging is squelched
+
+        New sections start at level 0 (trace), so every
+        message is written until a threshold is set.
     */
     int threshold() const noexcept
     {
-        return impl_->level;
+        return impl_->level.load(std::memory_order_relaxed);
+    }
+
+    /** Set the level below which logging is squelched
+
+        This may be called while other threads log to
+        the section; they see the new level on their
+        next message.
+    */
+    void set_threshold(int level) noexcept
+    {
+        impl_->level.store(level, std::memory_order_relaxed);
     }
 
+    /** Write a message at trace level.
+
+        @see log
+    */
     template<class... Args>
     void operator()(
-        core::string_view const& fs,
+        format_string<std::type_identity_t<Args>...> fs,
+        Args const&... args)
+    {
+        log(0, fs, args...);
+    }
+
+    /** Write a message.
+
+        Nothing is done if the level is below the threshold.
+
+        When the format string is a literal and every
+        argument is a number or a string, formatting is
+        deferred: the address of the format string and
+        the bytes of the arguments are copied into the log
+        buffer, and the text is produced on the logging
+        thread. Other messages are formatted at once.
+        A literal format string is checked at compile time
+        and must have static storage duration.
+    */
+    template<class... Args>
+    void log(
+        int level,
+        format_string<std::type_identity_t<Args>...> fs,
         Args const&... args)
     {
-        int level = 0;
+        if(level < threshold())
+            return;
+        if constexpr(detail::log_capturable<Args...>)
+        {
+            if(fs.checked() && impl_->backend)
+            {
+                detail::push_record(*impl_->backend,
+                    fs.get().data(), fs.get().size(), args...);
+                return;
+            }
+        }
         std::string s;
         format_to(s, fs, args...);
         write(level, std::move(s));
@@ -56,14 +110,18 @@ private:
     BOOST_BEAST2_DECL
     void write(int, std::string);
 
-    section(core::string_view);
+    section(core::string_view, std::shared_ptr<log_backend>);
 
     friend class log_sections;
 
+    // Every copy of a section shares ownership of the
+    // backend, so a section which outlives the
+    // log_sections it came from still writes safely
     struct impl
     {
         std::string name;
-        int level = 0;
+        std::atomic<int> level{0};
+        std::shared_ptr<log_backend> backend;
     };
 
     std::shared_ptr<impl> impl_;
@@ -71,30 +129,35 @@ private:
 
 //------------------------------------------------
 
-#if 0
+/** A section bound to a level.
+
+    The logging macros produce one of these, so that
+    the level reaches the section.
+*/
 class log_stream
 {
 public:
     log_stream() = default;
 
-    log_stream(section& sect, int level)
+    log_stream(section& sect, int level) noexcept
         : sect_(&sect)
         , level_(level)
     {
     }
 
     template<class... Args>
-    void operator()(Args const&... args)
+    void operator()(
+        format_string<std::type_identity_t<Args>...> fs,
+        Args const&... args)
     {
         if( sect_)
-            sect_->operator()(args...);
+            sect_->log(level_, fs, args...);
     }
 
 private:
     section* sect_ = nullptr;
     int level_ = 0;
 };
-#endif
 
 //------------------------------------------------
 
@@ -125,6 +188,17 @@ public:
     get_sections() const noexcept ->
         std::vector<section>;
 
+    /** Return the backend which writes the records of every section.
+
+        The backend is owned jointly with the sections;
+        it is destroyed, after writing what it holds,
+        once this object and every copy of its sections
+        are gone.
+    */
+    BOOST_BEAST2_DECL
+    log_backend&
+    backend() noexcept;
+
 private:
     struct impl;
     impl* impl_;
@@ -134,7 +208,8 @@ private:
 
 #ifndef LOG_AT_LEVEL
 #define LOG_AT_LEVEL(sect, level) \
-    if((level) < (sect).threshold()) {} else sect
+    if((level) < (sect).threshold()) {} else \
+        ::boost::beast2::log_stream((sect), (level))
 #endif
 
 /// Log at trace level
@@ -164,7 +239,7 @@ private:
 
 /// Log at fatal level
 #ifndef LOG_FTL
-#define LOG_FTL(sect, ...) LOG_AT_LEVEL(sect, 5, __VA_ARGS__)
+#define LOG_FTL(sect) LOG_AT_LEVEL(sect, 5)
 #endif
 
 } // beast2
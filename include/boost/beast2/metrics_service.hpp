@@ -0,0 +1,558 @@
+//
+// Copyright (c) 2026 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/beast2
+//
+
+#ifndef BOOST_BEAST2_METRICS_SERVICE_HPP
+#define BOOST_BEAST2_METRICS_SERVICE_HPP
+
+#include <boost/beast2/detail/config.hpp>
+#include <boost/core/detail/string_view.hpp>
+#include <boost/http/server/router.hpp>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <string>
+
+namespace boost {
+namespace beast2 {
+
+namespace detail {
+
+// Each thread which updates metrics is given a slot
+// index of its own the first time it does, and gives
+// it back when it exits. Metrics keep one slot per
+// index, on its own cache line, in blocks allocated
+// as threads arrive, and sum them when read.
+constexpr std::size_t metric_block = 16;
+constexpr std::size_t metric_blocks = 64;
+
+struct BOOST_BEAST2_DECL metric_thread
+{
+    std::size_t const index;
+
+    metric_thread() noexcept;
+    ~metric_thread();
+
+    metric_thread(metric_thread const&) = delete;
+    metric_thread& operator=(metric_thread const&) = delete;
+};
+
+// Return the slot index of the calling thread
+inline
+std::size_t
+metric_slot() noexcept
+{
+    thread_local metric_thread const t;
+    return t.index;
+}
+
+// The per-thread slots of one metric. Threads past
+// the last block, or whose block cannot be allocated,
+// share the overflow slot.
+template<class Slot>
+class metric_slots
+{
+    std::atomic<Slot*> blocks_[metric_blocks] = {};
+    Slot overflow_;
+
+public:
+    metric_slots() = default;
+    metric_slots(metric_slots const&) = delete;
+    metric_slots& operator=(metric_slots const&) = delete;
+
+    ~metric_slots()
+    {
+        for(auto& b : blocks_)
+            delete[] b.load(std::memory_order_relaxed);
+    }
+
+    Slot&
+    get(std::size_t i) noexcept
+    {
+        if(i >= metric_block * metric_blocks)
+            return overflow_;
+        auto& b = blocks_[i / metric_block];
+        auto p = b.load(std::memory_order_acquire);
+        if(! p)
+        {
+            p = new(std::nothrow) Slot[metric_block];
+            if(! p)
+                return overflow_;
+            Slot* prev = nullptr;
+            if(! b.compare_exchange_strong(prev, p,
+                std::memory_order_acq_rel,
+                std::memory_order_acquire))
+            {
+                // another thread of the block won
+                delete[] p;
+                p = prev;
+            }
+        }
+        return p[i % metric_block];
+    }
+
+    template<class F>
+    void
+    for_each(F&& f) const
+    {
+        f(overflow_);
+        for(auto const& b : blocks_)
+            if(auto p = b.load(std::memory_order_acquire))
+                for(std::size_t i = 0; i < metric_block; ++i)
+                    f(p[i]);
+    }
+};
+
+struct alignas(64) counter_shard
+{
+    std::atomic<std::uint64_t> v{0};
+};
+
+struct counter_impl
+{
+    metric_slots<counter_shard> shards;
+};
+
+struct gauge_impl
+{
+    std::atomic<std::int64_t> v{0};
+};
+
+// Log-linear buckets: each power of two is split into
+// four, so a bucket is within 25% of its values
+struct histogram_impl
+{
+    static constexpr std::size_t sub_bits = 2;
+    static constexpr std::size_t octaves = 40;
+    static constexpr std::size_t buckets =
+        octaves << sub_bits;
+
+    struct alignas(64) shard
+    {
+        std::atomic<std::uint64_t> count{0};
+        std::atomic<std::uint64_t> sum{0};
+        std::atomic<std::uint64_t> b[buckets] = {};
+    };
+
+    double unit = 1;
+    metric_slots<shard> shards;
+
+    static
+    std::size_t
+    index(std::uint64_t v) noexcept
+    {
+        constexpr std::uint64_t sub = 1u << sub_bits;
+        if(v < sub)
+            return static_cast<std::size_t>(v);
+        std::size_t e = 0;
+        while((v >> e) >= 2 * sub)
+            ++e;
+        auto const i = ((e + 1) << sub_bits) +
+            static_cast<std::size_t>((v >> e) - sub);
+        return i < buckets ? i : buckets - 1;
+    }
+};
+
+} // detail
+
+/** A monotonically increasing count.
+
+    This is a lightweight handle to a metric owned by a
+    @ref metrics_service. A default-constructed handle
+    discards its updates.
+
+    @par Thread Safety
+    Updates are lock-free and may be made concurrently.
+*/
+class counter
+{
+    detail::counter_impl* p_ = nullptr;
+
+    friend class metrics_service;
+
+    explicit
+    counter(detail::counter_impl* p) noexcept
+        : p_(p)
+    {
+    }
+
+public:
+    counter() = default;
+
+    /** Add to the count.
+    */
+    void
+    add(std::uint64_t n = 1) const noexcept
+    {
+        if(p_)
+            p_->shards.get(detail::metric_slot()).v.fetch_add(
+                n, std::memory_order_relaxed);
+    }
+
+    /** Return the count.
+    */
+    BOOST_BEAST2_DECL
+    std::uint64_t
+    value() const noexcept;
+};
+
+/** A value which goes up and down.
+
+    This is a lightweight handle to a metric owned by a
+    @ref metrics_service. A default-constructed handle
+    discards its updates.
+
+    @par Thread Safety
+    Updates are lock-free and may be made concurrently.
+*/
+class gauge
+{
+    detail::gauge_impl* p_ = nullptr;
+
+    friend class metrics_service;
+
+    explicit
+    gauge(detail::gauge_impl* p) noexcept
+        : p_(p)
+    {
+    }
+
+public:
+    gauge() = default;
+
+    /** Set the value.
+    */
+    void
+    set(std::int64_t v) const noexcept
+    {
+        if(p_)
+            p_->v.store(v, std::memory_order_relaxed);
+    }
+
+    /** Add to the value.
+    */
+    void
+    add(std::int64_t n = 1) const noexcept
+    {
+        if(p_)
+            p_->v.fetch_add(n, std::memory_order_relaxed);
+    }
+
+    /** Subtract from the value.
+    */
+    void
+    sub(std::int64_t n = 1) const noexcept
+    {
+        add(-n);
+    }
+
+    /** Return the value.
+    */
+    std::int64_t
+    value() const noexcept
+    {
+        return p_ ? p_->v.load(std::memory_order_relaxed) : 0;
+    }
+};
+
+/** A distribution of observed values.
+
+    Values are non-negative integers in a unit chosen
+    when the histogram is created, for example
+    microseconds. They are counted in buckets whose
+    width grows with the value, so that each bucket is
+    within 25% of the values it holds, over a range
+    of 2^40.
+
+    This is a lightweight handle to a metric owned by a
+    @ref metrics_service. A default-constructed handle
+    discards its updates.
+
+    @par Thread Safety
+    Updates are lock-free and may be made concurrently.
+*/
+class histogram
+{
+    detail::histogram_impl* p_ = nullptr;
+
+    friend class metrics_service;
+
+    explicit
+    histogram(detail::histogram_impl* p) noexcept
+        : p_(p)
+    {
+    }
+
+public:
+    histogram() = default;
+
+    /** Record a value.
+    */
+    void
+    observe(std::uint64_t v) const noexcept
+    {
+        if(! p_)
+            return;
+        auto& s = p_->shards.get(detail::metric_slot());
+        s.b[detail::histogram_impl::index(v)].fetch_add(
+            1, std::memory_order_relaxed);
+        s.sum.fetch_add(v, std::memory_order_relaxed);
+        s.count.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /** Return the number of values recorded.
+    */
+    BOOST_BEAST2_DECL
+    std::uint64_t
+    count() const noexcept;
+
+    /** Return an upper bound on a quantile of the values.
+
+        @param q The quantile, from 0 to 1.
+    */
+    BOOST_BEAST2_DECL
+    std::uint64_t
+    quantile(double q) const noexcept;
+};
+
+//------------------------------------------------
+
+/** A registry of metrics.
+
+    Metrics are identified by a name and an optional set
+    of labels, written as in the Prometheus text format,
+    for example `code="2xx",method="GET"`. Looking up a
+    metric takes a lock, so handles are meant to be
+    obtained once and kept; updating a metric through a
+    handle does not lock. Each counter and histogram
+    keeps a slot on its own cache line for every thread
+    which updates it, so threads never write to a shared
+    line; the slots are summed when the registry is
+    rendered.
+
+    Metrics live as long as the service.
+
+    @see use_metrics_service, serve_metrics
+*/
+class BOOST_SYMBOL_VISIBLE
+    metrics_service
+{
+public:
+    /** Return a new or existing counter.
+
+        @param name The metric name.
+        @param help The description rendered with it.
+        @param labels The labels of this metric, if any.
+
+        @throws std::invalid_argument The name is in
+            use by a metric of another type.
+    */
+    virtual counter get_counter(
+        core::string_view name,
+        core::string_view help,
+        core::string_view labels = {}) = 0;
+
+    /** Return a new or existing gauge.
+
+        @param name The metric name.
+        @param help The description rendered with it.
+        @param labels The labels of this metric, if any.
+
+        @throws std::invalid_argument The name is in
+            use by a metric of another type.
+    */
+    virtual gauge get_gauge(
+        core::string_view name,
+        core::string_view help,
+        core::string_view labels = {}) = 0;
+
+    /** Return a new or existing histogram.
+
+        @param name The metric name.
+        @param help The description rendered with it.
+        @param labels The labels of this metric, if any.
+        @param unit The size of one observed unit in the
+            rendered output, for example `1e-6` for values
+            in microseconds rendered in seconds.
+
+        @throws std::invalid_argument The name is in
+            use by a metric of another type.
+    */
+    virtual histogram get_histogram(
+        core::string_view name,
+        core::string_view help,
+        core::string_view labels = {},
+        double unit = 1) = 0;
+
+    /** Append every metric in the Prometheus text format.
+    */
+    virtual void render(std::string& dest) const = 0;
+
+protected:
+    static counter make(detail::counter_impl* p) noexcept
+    {
+        return counter(p);
+    }
+
+    static gauge make(detail::gauge_impl* p) noexcept
+    {
+        return gauge(p);
+    }
+
+    static histogram make(detail::histogram_impl* p) noexcept
+    {
+        return histogram(p);
+    }
+};
+
+/** Return the metrics service from the system context
+
+    If the system context does not already contain the
+    service, it is created.
+
+    @return The metrics service.
+*/
+BOOST_BEAST2_DECL
+metrics_service&
+use_metrics_service();
+
+//------------------------------------------------
+
+/** The metrics recorded by the servers.
+
+    Every server holding one of these, and every worker
+    pointed at it, updates the same process-wide metrics:
+
+    @li `beast2_connections_accepted_total`
+    @li `beast2_connections_shed_total`
+    @li `beast2_connections_active`
+    @li `beast2_requests_total{code="2xx"}`, by status class
+    @li `beast2_response_bytes_total`
+    @li `beast2_tls_handshakes_total{type="full"}`, also
+        `"resumed"` and `"failed"`
+    @li `beast2_route_latency_seconds{route="..."}`
+
+    @see server_config::metrics, measure_route
+*/
+struct BOOST_BEAST2_DECL
+    server_metrics
+{
+    counter connections_accepted;
+    counter connections_shed;
+    gauge connections_active;
+
+    /// Requests by status class, 1xx to 5xx.
+    counter requests[5];
+
+    counter response_bytes;
+
+    /// TLS handshakes: full, resumed and failed.
+    counter tls_handshakes[3];
+
+    /// Latency of requests on unlabelled routes.
+    histogram latency;
+
+    /** Constructor.
+
+        @param svc The service holding the metrics.
+    */
+    explicit
+    server_metrics(
+        metrics_service& svc = use_metrics_service());
+
+    /** Count a response.
+
+        @param status The status code.
+    */
+    void
+    on_response(unsigned status) const noexcept
+    {
+        if(status >= 100 && status < 600)
+            requests[status / 100 - 1].add();
+    }
+};
+
+//------------------------------------------------
+
+/** A route handler serving metrics to Prometheus.
+
+    GET and HEAD requests are answered with every metric
+    of the service in the Prometheus text format. Other
+    methods are passed on with `route_next`.
+
+    @par Example
+    @code
+    rr.use( "/metrics", beast2::serve_metrics() );
+    @endcode
+*/
+class BOOST_BEAST2_DECL
+    serve_metrics
+{
+    metrics_service* svc_;
+
+public:
+    /** Constructor.
+
+        @param svc The service to render. It must outlive
+            every router holding this handler.
+    */
+    explicit
+    serve_metrics(
+        metrics_service& svc = use_metrics_service()) noexcept
+        : svc_(&svc)
+    {
+    }
+
+    http::route_task
+    operator()(http::route_params& rp) const;
+};
+
+/** A route handler measuring the latency of a route.
+
+    Installed in front of the handlers of a route, it
+    labels each request it sees, so that the worker
+    records the time from the parsed header to the end
+    of dispatch in the histogram
+    `beast2_route_latency_seconds{route="<name>"}`.
+    Requests of unlabelled routes are recorded under
+    `route=""`. The request is always passed on with
+    `route_next`.
+
+    @par Example
+    @code
+    rr.use( "/api", beast2::measure_route( "api" ) );
+    rr.use( "/api", api_handler );
+    @endcode
+*/
+class BOOST_BEAST2_DECL
+    measure_route
+{
+    histogram h_;
+
+public:
+    /** Constructor.
+
+        @param name The value of the `route` label. It
+            may hold any characters; backslashes, quotes
+            and newlines are escaped when rendered.
+        @param svc The service holding the histogram.
+    */
+    explicit
+    measure_route(
+        core::string_view name,
+        metrics_service& svc = use_metrics_service());
+
+    http::route_task
+    operator()(http::route_params& rp) const;
+};
+
+} // beast2
+} // boost
+
+#endif
@@ -0,0 +1,118 @@
+//
+// Copyright (c) 2026 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/beast2
+//
+
+#ifndef BOOST_BEAST2_REQUEST_ARENA_HPP
+#define BOOST_BEAST2_REQUEST_ARENA_HPP
+
+#include <boost/beast2/detail/config.hpp>
+#include <boost/http/server/router.hpp>
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+
+namespace boost {
+namespace beast2 {
+
+/** A monotonic memory resource reset between requests.
+
+    Each worker owns one arena. Allocations are carved
+    from a buffer owned by the arena, which spills into
+    larger blocks from the global heap when exhausted.
+    Deallocation does nothing; all memory is reclaimed at
+    once by @ref reset, which the worker calls before
+    each request. The first buffer is kept, so a request
+    which fits in it never touches the global heap.
+
+    Memory from the arena must not outlive the request.
+    Handlers reach the arena of the current request with
+    @ref get_arena.
+
+    @par Example
+    @code
+    http::route_task operator()( http::route_params& rp ) const
+    {
+        std::pmr::string body( beast2::get_arena( rp ) );
+        body.append( "<p>Hello</p>" );
+        auto [ec] = co_await rp.send( body );
+        ...
+    }
+    @endcode
+
+    @par Thread Safety
+    Distinct objects: Safe.
+    Shared objects: Unsafe.
+*/
+class BOOST_BEAST2_DECL
+    request_arena
+    : public std::pmr::memory_resource
+{
+    std::unique_ptr<unsigned char[]> buf_;
+    std::size_t size_;
+    std::size_t used_ = 0;
+    std::pmr::monotonic_buffer_resource mr_;
+
+public:
+    /** Constructor.
+
+        @param initial_size The size of the buffer kept
+            between requests, in bytes.
+    */
+    explicit
+    request_arena(
+        std::size_t initial_size = 16 * 1024);
+
+    request_arena(request_arena const&) = delete;
+    request_arena& operator=(request_arena const&) = delete;
+
+    /** Return the number of bytes allocated since the last reset.
+    */
+    std::size_t
+    used() const noexcept
+    {
+        return used_;
+    }
+
+    /** Release every allocation.
+    */
+    void
+    reset() noexcept;
+
+private:
+    void*
+    do_allocate(
+        std::size_t bytes,
+        std::size_t alignment) override;
+
+    void
+    do_deallocate(
+        void* p,
+        std::size_t bytes,
+        std::size_t alignment) override;
+
+    bool
+    do_is_equal(
+        std::pmr::memory_resource const& other) const noexcept override;
+};
+
+/** Return the memory resource for the current request.
+
+    This is the @ref request_arena of the worker handling
+    the request, or the global heap if the worker does not
+    publish one.
+
+    @param rp The route parameters of the request.
+*/
+BOOST_BEAST2_DECL
+std::pmr::memory_resource*
+get_arena(http::route_params& rp) noexcept;
+
+} // beast2
+} // boost
+
+#endif
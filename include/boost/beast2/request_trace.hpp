@@ -0,0 +1,199 @@
+//
+// Copyright (c) 2026 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/beast2
+//
+
+#ifndef BOOST_BEAST2_REQUEST_TRACE_HPP
+#define BOOST_BEAST2_REQUEST_TRACE_HPP
+
+#include <boost/beast2/detail/config.hpp>
+#include <boost/beast2/logger.hpp>
+#include <boost/http/server/router.hpp>
+#include <chrono>
+#include <cstddef>
+
+namespace boost {
+namespace beast2 {
+
+/** A point in the life of a request.
+
+    @see request_trace
+*/
+enum class trace_point : unsigned char
+{
+    /// The connection was accepted.
+    accept,
+
+    /// The first byte of the request was read.
+    first_byte,
+
+    /// The request header was parsed.
+    header_parsed,
+
+    /// The request target was parsed.
+    url_parsed,
+
+    /// The request was handed to the router.
+    dispatch_begin,
+
+    /// The router returned.
+    dispatch_end,
+
+    /// The last byte of the response was written.
+    last_byte
+};
+
+/** Timestamps taken while a request is handled.
+
+    Points which were not reached, or which the worker
+    cannot observe, hold a default-constructed time.
+    For a request after the first on a connection,
+    the time between @ref trace_point::accept and
+    @ref trace_point::first_byte includes the time the
+    connection spent idle.
+
+    @see request_tracer
+*/
+struct request_trace
+{
+    using clock_type = std::chrono::steady_clock;
+
+    /// The number of points.
+    static constexpr std::size_t size =
+        static_cast<std::size_t>(trace_point::last_byte) + 1;
+
+    /// The time of each point, indexed by @ref trace_point.
+    clock_type::time_point at[size] = {};
+
+    /** Return the time of a point.
+    */
+    clock_type::time_point&
+    operator[](trace_point p) noexcept
+    {
+        return at[static_cast<std::size_t>(p)];
+    }
+
+    /** Return the time of a point.
+    */
+    clock_type::time_point
+    operator[](trace_point p) const noexcept
+    {
+        return at[static_cast<std::size_t>(p)];
+    }
+
+    /** Return true if a point was reached.
+    */
+    bool
+    has(trace_point p) const noexcept
+    {
+        return (*this)[p] != clock_type::time_point();
+    }
+
+    /** Return the time between two points.
+
+        If either point was not reached, zero is returned.
+    */
+    clock_type::duration
+    between(
+        trace_point from,
+        trace_point to) const noexcept
+    {
+        if(! has(from) || ! has(to))
+            return clock_type::duration::zero();
+        return (*this)[to] - (*this)[from];
+    }
+
+    /** Stamp a point with the current time.
+    */
+    void
+    mark(trace_point p) noexcept
+    {
+        (*this)[p] = clock_type::now();
+    }
+};
+
+/** A receiver of request traces.
+
+    When a tracer is installed in a server, every worker
+    timestamps each request at the points listed in
+    @ref trace_point, and calls @ref on_request once the
+    request has been handled. When no tracer is installed
+    the only cost is a test of a null pointer. Defining
+    `BOOST_BEAST2_NO_REQUEST_TRACE` when building the
+    library removes even that; it makes no difference to
+    code which only includes the headers.
+
+    @par Thread Safety
+    @ref on_request is called concurrently from every
+    worker.
+
+    @see server_config::tracer, slow_request_reporter
+*/
+class BOOST_SYMBOL_VISIBLE
+    request_tracer
+{
+public:
+    virtual ~request_tracer() = default;
+
+    /** Called when a request has been handled.
+
+        @param trace The timestamps of the request.
+        @param rp The route parameters of the request.
+    */
+    virtual
+    void
+    on_request(
+        request_trace const& trace,
+        http::route_params const& rp) = 0;
+};
+
+/** A tracer which logs requests slower than a threshold.
+
+    A request is slow when the time from its first byte
+    to the end of its dispatch, or to its last byte if
+    that is later, exceeds the threshold. Each slow
+    request is logged at warning level with the time
+    spent waiting for it, reading its header, parsing
+    its target, in the handler, and writing after the
+    handler returned.
+
+    @par Example
+    @code
+    server_config cfg;
+    cfg.tracer = std::make_shared< slow_request_reporter >(
+        use_log_service().get_section( "slow" ),
+        std::chrono::milliseconds( 250 ) );
+    @endcode
+*/
+class BOOST_BEAST2_DECL
+    slow_request_reporter
+    : public request_tracer
+{
+    section sect_;
+    request_trace::clock_type::duration threshold_;
+
+public:
+    /** Constructor.
+
+        @param sect The log section slow requests go to.
+        @param threshold The time above which a request
+            is reported.
+    */
+    slow_request_reporter(
+        section sect,
+        request_trace::clock_type::duration threshold);
+
+    void
+    on_request(
+        request_trace const& trace,
+        http::route_params const& rp) override;
+};
+
+} // beast2
+} // boost
+
+#endif
@@ -0,0 +1,248 @@
+//
+// Copyright (c) 2026 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/beast2
+//
+
+#ifndef BOOST_BEAST2_RESPONSE_CACHE_HPP
+#define BOOST_BEAST2_RESPONSE_CACHE_HPP
+
+#include <boost/beast2/detail/config.hpp>
+#include <boost/core/detail/string_view.hpp>
+#include <boost/http/server/router.hpp>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace boost {
+namespace beast2 {
+
+/** Settings for a @ref response_cache.
+*/
+struct response_cache_config
+{
+    /// Total size of the stored responses, in bytes.
+    std::size_t max_bytes = 64 * 1024 * 1024;
+
+    /** Number of independently locked shards.
+
+        The size limit is divided evenly between them.
+    */
+    std::size_t shards = 16;
+
+    /// Largest single response stored, in bytes.
+    std::size_t max_entry = 1024 * 1024;
+
+    /** Lifetime of a response without `max-age`.
+
+        Zero means such responses are not stored.
+    */
+    std::chrono::steady_clock::duration default_ttl{};
+};
+
+/** Counters describing a @ref response_cache.
+*/
+struct response_cache_stats
+{
+    /// Requests answered from the cache.
+    std::uint64_t hits = 0;
+
+    /// Lookups which found nothing fresh.
+    std::uint64_t misses = 0;
+
+    /// Responses stored.
+    std::uint64_t stores = 0;
+
+    /// Responses evicted to make room.
+    std::uint64_t evictions = 0;
+
+    /// Number of responses stored.
+    std::size_t entries = 0;
+
+    /// Bytes of stored responses.
+    std::size_t bytes = 0;
+};
+
+/** A size-bounded store of serialized responses.
+
+    Responses are kept fully serialized, header and body,
+    so that a hit is answered by writing the stored bytes
+    straight to the connection. Entries are spread over
+    shards by URL, each with its own lock and its own
+    least-recently-used list.
+
+    Use @ref cache_responses to place the cache in a
+    router.
+
+    @par Thread Safety
+    Distinct objects: Safe.
+    Shared objects: Safe.
+*/
+class BOOST_BEAST2_DECL
+    response_cache
+{
+public:
+    using clock_type = std::chrono::steady_clock;
+
+    /** A stored response.
+    */
+    struct entry
+    {
+        /// The serialized response.
+        std::string bytes;
+
+        /// The size of the header at the front of `bytes`.
+        std::size_t header_size = 0;
+
+        /// The value of the `ETag` field, if any.
+        std::string etag;
+
+        /// When the response was stored.
+        clock_type::time_point stored;
+
+        /// When the response becomes stale.
+        clock_type::time_point expires;
+    };
+
+    /// Destructor.
+    ~response_cache();
+
+    /** Constructor.
+
+        @param cfg The cache settings.
+    */
+    explicit
+    response_cache(
+        response_cache_config const& cfg = {});
+
+    response_cache(response_cache const&) = delete;
+    response_cache& operator=(response_cache const&) = delete;
+
+    /** Return the settings.
+    */
+    response_cache_config const&
+    config() const noexcept;
+
+    /** Look up a fresh response.
+
+        @param url The normalized URL, including the host.
+        @param vary The values of the request fields named
+            by the stored response's `Vary`, as returned by
+            @ref vary_of.
+        @param now The current time.
+        @return The response, or null.
+    */
+    std::shared_ptr<entry const>
+    find(
+        core::string_view url,
+        core::string_view vary,
+        clock_type::time_point now = clock_type::now());
+
+    /** Return the field names a URL's responses vary on.
+
+        @param url The normalized URL, including the host.
+        @return A comma separated list, empty if none.
+    */
+    std::string
+    vary_of(core::string_view url) const;
+
+    /** Store a response.
+
+        An existing response for the same URL and values is
+        replaced. Least recently used responses are evicted
+        until the shard is back within its size limit.
+
+        @param url The normalized URL, including the host.
+        @param vary_names The field names the response
+            varies on, comma separated.
+        @param vary The values of those fields.
+        @param e The response.
+    */
+    void
+    insert(
+        core::string_view url,
+        core::string_view vary_names,
+        core::string_view vary,
+        std::shared_ptr<entry const> e);
+
+    /** Remove every stored response.
+    */
+    void
+    clear();
+
+    /** Return the counters.
+    */
+    response_cache_stats
+    get_stats() const;
+
+private:
+    struct shard;
+    struct impl;
+    impl* impl_;
+
+    shard& shard_for(core::string_view url) const noexcept;
+};
+
+/** A route handler answering requests from a response cache.
+
+    A fresh stored response to a `GET` or `HEAD` is written
+    to the connection with an `Age` field added, and the
+    request goes no further: the handler and the serializer
+    never see it. A conditional request whose
+    `If-None-Match` names the stored `ETag` is answered
+    with `304 Not Modified`.
+
+    On a miss, the request is passed on, and the response
+    written by the rest of the route is recorded. Only
+    responses to `GET` are stored; a `HEAD` is answered
+    from the header of a stored `GET`. A `200` response is
+    stored if its `Cache-Control` allows it: `no-store`,
+    `no-cache` and `private`, a `Vary` of `*`, `Set-Cookie`
+    and an `Age` field all prevent storage, and `s-maxage`
+    or `max-age` give its lifetime.
+
+    Requests with `Cache-Control: no-cache` or `no-store`
+    bypass the lookup, as do requests with
+    `Authorization`, which may be answered differently
+    for each user. As RFC 9111 section 3.5 requires, the
+    response to a request with `Authorization` is only
+    stored when it is marked `public`, `must-revalidate`
+    or `s-maxage`.
+
+    @par Example
+    @code
+    response_cache cache;
+    rr.use( "/api", cache_responses( cache ) );
+    rr.use( "/api", expensive_handler );
+    @endcode
+*/
+class BOOST_BEAST2_DECL
+    cache_responses
+{
+    response_cache* cache_;
+
+public:
+    /** Constructor.
+
+        @param cache The cache to use. It must outlive
+            every router holding this handler.
+    */
+    explicit
+    cache_responses(response_cache& cache) noexcept
+        : cache_(&cache)
+    {
+    }
+
+    http::route_task
+    operator()(http::route_params& rp) const;
+};
+
+} // beast2
+} // boost
+
+#endif
@@ -0,0 +1,100 @@
+//
+// Copyright (c) 2026 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/beast2
+//
+
+#ifndef BOOST_BEAST2_RESPONSE_TAP_HPP
+#define BOOST_BEAST2_RESPONSE_TAP_HPP
+
+#include <boost/beast2/detail/config.hpp>
+#include <boost/capy/task.hpp>
+#include <boost/core/detail/string_view.hpp>
+#include <boost/system/error_code.hpp>
+#include <cstddef>
+#include <functional>
+#include <string>
+
+namespace boost {
+namespace beast2 {
+
+/** Access to the serialized bytes of a connection's responses.
+
+    Workers place the tap between the serializer and the
+    socket, and publish it in the route parameters of each
+    request. Middleware uses it to record a response as it
+    is written, or to send bytes which were serialized
+    earlier without involving the serializer at all.
+
+    @par Thread Safety
+    Distinct objects: Safe.
+    Shared objects: Unsafe.
+
+    @see cache_responses
+*/
+class BOOST_BEAST2_DECL
+    response_tap
+{
+    std::string buf_;
+    std::size_t limit_ = 0;
+    std::function<void(core::string_view)> done_;
+    bool active_ = false;
+
+public:
+    virtual ~response_tap() = default;
+
+    /** Write bytes to the connection.
+
+        The bytes must form one or more complete
+        responses. They are not recorded.
+
+        @param bytes The bytes to write.
+        @return The error, if any.
+    */
+    virtual
+    capy::task<system::error_code>
+    write(core::string_view bytes) = 0;
+
+    /** Record the response to the current request.
+
+        Every byte written through the serializer until the
+        request has been handled is recorded. If the
+        response completes normally within `limit` bytes,
+        `done` is invoked with the recorded bytes before
+        the next request is read.
+
+        @param limit The most bytes to record.
+        @param done The function to invoke.
+    */
+    void
+    capture(
+        std::size_t limit,
+        std::function<void(core::string_view)> done);
+
+    /** Finish the current request.
+
+        Called by the worker after a request has been
+        handled. Delivers the recording, if any.
+    */
+    void
+    complete();
+
+    /** Abandon any recording.
+    */
+    void
+    discard() noexcept;
+
+protected:
+    /** Record bytes written through the serializer.
+    */
+    void
+    record(void const* data, std::size_t size);
+};
+
+} // beast2
+} // boost
+
+#endif
@@ -0,0 +1,127 @@
+//
+// Copyright (c) 2026 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/beast2
+//
+
+#ifndef BOOST_BEAST2_SEND_FILE_HPP
+#define BOOST_BEAST2_SEND_FILE_HPP
+
+#include <boost/beast2/detail/config.hpp>
+#include <boost/capy/task.hpp>
+#include <boost/core/detail/string_view.hpp>
+#include <boost/http/server/router.hpp>
+#include <boost/system/error_code.hpp>
+#include <cstdint>
+#include <string>
+
+namespace boost {
+namespace beast2 {
+
+/** A connection which can send file contents without copying.
+
+    A worker whose socket supports a zero-copy transfer,
+    such as `sendfile` on a plain TCP socket, or on a TLS
+    socket whose records the kernel encrypts (see
+    @ref server_config::ktls), publishes a sender in the
+    route parameters of each request. Use @ref send_file
+    to reach it from a route handler.
+
+    @see send_file
+*/
+class file_sender
+{
+public:
+    virtual ~file_sender() = default;
+
+    /** Send a serialized header followed by a file range.
+
+        @param header The complete response header.
+        @param fd An open file descriptor.
+        @param offset The offset of the first byte to send.
+        @param size The number of bytes to send.
+    */
+    virtual
+    capy::task<system::error_code>
+    send(
+        core::string_view header,
+        int fd,
+        std::uint64_t offset,
+        std::uint64_t size) = 0;
+};
+
+/** Send a file range as the response body without copying.
+
+    The response in `rp.res` is given a `Content-Length` of
+    `size`, and its header is written directly to the
+    socket. The kernel then moves the file bytes to the
+    socket without a copy through userspace. For a `HEAD`
+    request only the header is sent.
+
+    When the connection does not support a zero-copy
+    transfer, for example over TLS without kernel offload,
+    nothing is sent and the error `operation_not_supported`
+    is returned, so that the caller can fall back to the
+    serializer.
+
+    @param rp The route parameters of the request.
+    @param fd An open file descriptor. It is not closed.
+    @param offset The offset of the first byte to send.
+    @param size The number of bytes to send.
+    @return The error, if any.
+*/
+BOOST_BEAST2_DECL
+capy::task<system::error_code>
+send_file(
+    http::route_params& rp,
+    int fd,
+    std::uint64_t offset,
+    std::uint64_t size);
+
+/** A route handler serving large static files without copying.
+
+    Regular files under the document root at least
+    `min_size` bytes long are sent with @ref send_file.
+    The path below the mount point of the route is
+    looked up under the root. Every other request,
+    including one for a directory or a small file, one
+    with `Range` or a precondition such as
+    `If-None-Match`, or one on a connection without
+    zero-copy support, is passed on with `route_next`, so
+    this handler is meant to be installed just before
+    `http::serve_static` on the same root and mount point:
+
+    @code
+    rr.use( "/", beast2::sendfile_static( root ) );
+    rr.use( "/", http::serve_static( root ) );
+    @endcode
+*/
+class BOOST_BEAST2_DECL
+    sendfile_static
+{
+    std::string root_;
+    std::uint64_t min_size_;
+
+public:
+    /** Constructor.
+
+        @param root The document root.
+        @param min_size The smallest file to serve. Small
+            files are cheaper to send from userspace.
+    */
+    explicit
+    sendfile_static(
+        core::string_view root,
+        std::uint64_t min_size = 64 * 1024);
+
+    http::route_task
+    operator()(http::route_params& rp) const;
+};
+
+} // beast2
+} // boost
+
+#endif
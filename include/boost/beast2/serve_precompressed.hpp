@@ -0,0 +1,135 @@
+//
+// Copyright (c) 2026 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/beast2
+//
+
+#ifndef BOOST_BEAST2_SERVE_PRECOMPRESSED_HPP
+#define BOOST_BEAST2_SERVE_PRECOMPRESSED_HPP
+
+#include <boost/beast2/detail/config.hpp>
+#include <boost/core/detail/string_view.hpp>
+#include <boost/http/server/router.hpp>
+#include <cstddef>
+#include <memory>
+
+namespace boost {
+namespace beast2 {
+
+/** A content coding for a static asset.
+*/
+enum class content_coding
+{
+    identity,
+    gzip,
+    br
+};
+
+/** Choose a content coding from an `Accept-Encoding` value.
+
+    Brotli is preferred over gzip when the client weighs
+    them equally. Codings with a weight of zero are never
+    chosen, and `*` stands for any coding not listed.
+
+    @param accept_encoding The field value.
+    @param second If not null, receives the next best
+        acceptable coding, or `identity` if none.
+    @return The best acceptable coding, or `identity`.
+*/
+BOOST_BEAST2_DECL
+content_coding
+negotiate_encoding(
+    core::string_view accept_encoding,
+    content_coding* second = nullptr) noexcept;
+
+/** Settings for @ref serve_precompressed.
+*/
+struct precompressed_config
+{
+    /** Whether to look for `.br` and `.gz` sidecar files.
+
+        A sidecar is used only if it is at least as new
+        as the file it was made from.
+    */
+    bool use_sidecars = true;
+
+    /// Total size of the compressed cache, in bytes.
+    std::size_t max_cache_bytes = 32 * 1024 * 1024;
+
+    /** Largest file compressed in memory, in bytes.
+    */
+    std::size_t max_file_size = 4 * 1024 * 1024;
+
+    /** Most files waiting to be compressed at once.
+
+        Further files are served uncompressed until
+        there is room in the queue.
+    */
+    std::size_t max_pending = 64;
+
+    /// Brotli quality, from 0 to 11.
+    int brotli_quality = 9;
+
+    /// Gzip level, from 1 to 9.
+    int gzip_level = 9;
+};
+
+/** A route handler serving compressed static assets.
+
+    A `GET` or `HEAD` for a compressible file under the
+    document root is answered with a `br` or `gzip`
+    coding chosen from the request's `Accept-Encoding`.
+    A `.br` or `.gz` sidecar file next to the asset is
+    sent when present; on plain TCP it goes out with
+    @ref send_file. Without a usable sidecar, the file is
+    compressed once with the brotli or zlib service
+    installed in the system context, and the result is
+    kept in a bounded cache keyed by path, modification
+    time and coding, so an edited file is compressed
+    again.
+
+    Compression runs on a background thread owned by
+    the handler, and each file is compressed at most
+    once at a time. Until its result is ready, requests
+    for the file are passed on and get it uncompressed.
+
+    Everything else, including requests with `Range` or
+    a precondition, is passed on with `route_next`, so
+    the handler goes just before `http::serve_static` on
+    the same root:
+
+    @code
+    rr.use( "/", beast2::serve_precompressed( root ) );
+    rr.use( "/", http::serve_static( root ) );
+    @endcode
+
+    Copies of the handler share one cache.
+*/
+class BOOST_BEAST2_DECL
+    serve_precompressed
+{
+    struct impl;
+    std::shared_ptr<impl> impl_;
+
+public:
+    /** Constructor.
+
+        @param root The document root.
+        @param cfg The settings.
+    */
+    explicit
+    serve_precompressed(
+        core::string_view root,
+        precompressed_config const& cfg = {});
+
+    http::route_task
+    operator()(http::route_params& rp) const;
+};
+
+} // beast2
+} // boost
+
+#endif
@@ -0,0 +1,391 @@
+//
+// Copyright (c) 2026 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/beast2
+//
+
+#ifndef BOOST_BEAST2_SERVER_CONFIG_HPP
+#define BOOST_BEAST2_SERVER_CONFIG_HPP
+
+#include <boost/beast2/detail/config.hpp>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace boost {
+namespace capy { class thread_pool; }
+namespace beast2 {
+
+class request_tracer;
+
+/** Per-connection deadlines.
+
+    Deadlines are tracked on the @ref timer_wheel of the
+    server's I/O context, at a resolution of 100ms. When a
+    deadline passes, the connection's pending I/O is
+    cancelled and the connection is closed. A duration of
+    zero disables the corresponding deadline.
+*/
+struct timeout_config
+{
+    /** Time allowed to receive the first request header.
+
+        This also bounds the TLS handshake.
+    */
+    std::chrono::steady_clock::duration header =
+        std::chrono::seconds(20);
+
+    /** Time a keep-alive connection may take to deliver
+        the complete header of its next request.
+    */
+    std::chrono::steady_clock::duration idle =
+        std::chrono::seconds(60);
+
+    /** Time allowed for a handler to read the request body
+        and begin writing the response.
+    */
+    std::chrono::steady_clock::duration body =
+        std::chrono::seconds(60);
+
+    /** Longest pause allowed while writing the response.
+
+        The deadline is pushed back each time bytes are
+        sent, so a long download is not cut off as long
+        as it keeps making progress. A stalled client is
+        cancelled after this much time without progress.
+        This also bounds the TLS shutdown.
+    */
+    std::chrono::steady_clock::duration write =
+        std::chrono::seconds(60);
+};
+
+/** Overload admission settings.
+
+    The server measures how long each accepted connection
+    waits before its session starts running on the event
+    loop. When that delay stays above `target` for a whole
+    `interval`, the server is overloaded and new connections
+    are shed until the delay falls back below `target`.
+    Connections are also shed when every connection state
+    is busy.
+
+    A shed connection never gets a parser or a route: on
+    @ref http_server it receives a pre-serialized
+    `503 Service Unavailable` with `Retry-After` and is
+    closed, and on @ref https_server it is closed before
+    the TLS handshake. In both cases, what the client sent
+    is drained for up to `linger` before the socket is
+    closed, so that the close does not reset the
+    connection.
+
+    Shedding is off by default, and no extra connection
+    slots are reserved for it; set `enabled` and
+    `shed_workers` to opt in.
+
+    The delay is measured from the moment the connection
+    is accepted. Time spent in the kernel's listen backlog
+    before that is not seen, so a long backlog can hide an
+    overload: keep the listen backlog short when relying
+    on this, so that excess connections are refused by
+    the kernel rather than queued out of sight.
+
+    @see admission_controller
+*/
+struct admission_config
+{
+    /** Whether delay-based shedding is enabled.
+
+        Connections are still shed when the pool is
+        exhausted and `shed_workers` is not zero.
+    */
+    bool enabled = false;
+
+    /// Acceptable queueing delay.
+    std::chrono::steady_clock::duration target =
+        std::chrono::milliseconds(5);
+
+    /// How long the delay must exceed `target` before shedding.
+    std::chrono::steady_clock::duration interval =
+        std::chrono::milliseconds(100);
+
+    /** Extra connection slots used only for shedding.
+
+        These let the server keep accepting, and answer
+        quickly, when all `max_workers` slots are busy.
+        Each one holds a socket while it is in use.
+    */
+    std::size_t shed_workers = 0;
+
+    /// Value of the `Retry-After` field, in seconds.
+    unsigned retry_after = 1;
+
+    /** How long a shed connection is drained before closing.
+
+        Zero closes right after the response is sent.
+    */
+    std::chrono::steady_clock::duration linger =
+        std::chrono::seconds(1);
+};
+
+/** Counters describing overload admission.
+
+    @see http_server::get_admission_stats
+*/
+struct admission_stats
+{
+    /// Connections admitted.
+    std::uint64_t admitted = 0;
+
+    /// Connections shed.
+    std::uint64_t shed = 0;
+
+    /// True while the server considers itself overloaded.
+    bool dropping = false;
+};
+
+/** TLS session resumption settings.
+
+    A resumed handshake skips the key exchange and
+    certificate verification, which dominate the cost of
+    a new TLS connection. @ref https_server supports both
+    kinds of resumption, and shares their state among all
+    of its connections:
+
+    @li Session IDs, looked up in a server-side cache.
+    @li Session tickets, which carry the session to the
+        client sealed with a key known only to the server.
+
+    @see https_server::get_tls_stats
+*/
+struct tls_session_config
+{
+    /// Whether sessions are kept in the server-side cache.
+    bool cache = true;
+
+    /** Maximum number of cached sessions.
+
+        The least recently stored sessions are evicted
+        first.
+    */
+    std::size_t cache_size = 20480;
+
+    /// How long a session may be resumed.
+    std::chrono::seconds lifetime{300};
+
+    /// Whether session tickets are issued and accepted.
+    bool tickets = true;
+
+    /** How often the ticket key is replaced.
+
+        Tickets sealed with the key before the current
+        one are still accepted, so a ticket remains usable
+        for at least this long.
+    */
+    std::chrono::seconds ticket_rotation{3600};
+};
+
+/** Configuration for @ref http_server and @ref https_server.
+
+    The server keeps `max_workers` lightweight connection
+    slots, which bounds the number of concurrent connections.
+    The expensive per-connection state (parser and serializer
+    buffers) lives in a separate pool which starts with
+    `min_workers` objects, grows on demand when every pooled
+    object is busy, and gives idle objects back to the heap
+    once they have been unused for `shrink_after`. A slot
+    opens its socket the first time it is used to accept.
+*/
+struct server_config
+{
+    /** Number of connection states allocated up front.
+
+        The pool never shrinks below this size.
+    */
+    std::size_t min_workers = 16;
+
+    /** Maximum number of concurrent connections.
+    */
+    std::size_t max_workers = 1024;
+
+    /** How long an idle connection state is kept.
+
+        Idle states above `min_workers` which have not
+        been used for this long are released, whether or
+        not the server sees further connections. They are
+        checked on the timer wheel of the server's I/O
+        context, so a state may linger up to one tick of
+        the wheel longer.
+    */
+    std::chrono::steady_clock::duration shrink_after =
+        std::chrono::seconds(30);
+
+    /** Per-connection deadlines.
+    */
+    timeout_config timeouts;
+
+    /** Most bytes of an unread request body discarded
+        to keep a connection open.
+
+        A handler may respond without reading the whole
+        request body. The rest is then read and thrown
+        away, up to this many bytes, so that the next
+        request on the connection can be found. A longer
+        remainder closes the connection after the
+        response.
+    */
+    std::size_t unread_body_limit = 64 * 1024;
+
+    /** Overload admission settings.
+    */
+    admission_config admission;
+
+    /** How long a drain waits for requests in flight.
+
+        Connections still open when this has elapsed
+        are cancelled.
+
+        @see http_server::drain
+    */
+    std::chrono::steady_clock::duration drain_timeout =
+        std::chrono::seconds(30);
+
+    /** Receiver of request timestamps.
+
+        If null, requests are not traced.
+
+        @see slow_request_reporter
+    */
+    std::shared_ptr<request_tracer> tracer;
+
+    /** TLS session resumption settings.
+
+        These apply to @ref https_server only.
+    */
+    tls_session_config tls;
+
+    /** Whether the kernel encrypts TLS records.
+
+        When set, @ref https_server hands the keys of each
+        connection to its socket after the handshake
+        (Linux kTLS), then writes responses as it would on
+        plain TCP, so that @ref send_file works over TLS.
+        Both directions are offloaded, or neither.
+        Connections whose cipher or kernel does not
+        support this, or where OpenSSL still holds
+        unprocessed bytes, are served by OpenSSL as usual.
+        AES-GCM and ChaCha20-Poly1305 are supported, with
+        TLS 1.2 and 1.3.
+    */
+    bool ktls = false;
+
+    /** Where TLS handshakes run.
+
+        If set, @ref https_server runs the OpenSSL side of
+        each handshake on this pool, and the connection
+        resumes on its own executor once the handshake
+        completes. Reads and writes of the socket still
+        happen on its event loop. The public-key
+        operations of a burst of new clients then no
+        longer delay the established connections sharing
+        their event loop. If null, handshakes run on the
+        event loop.
+    */
+    std::shared_ptr<capy::thread_pool> handshake_pool;
+
+    /** Whether idle TLS connections give back their buffers.
+
+        OpenSSL holds a read and a write buffer of about
+        16KB for each connection. If set, they are freed
+        whenever a connection has no record in flight,
+        such as a keep-alive connection waiting for its
+        next request, and allocated again when needed.
+        This trades allocations for memory when there are
+        many idle connections. Applies to @ref https_server
+        only.
+    */
+    bool tls_release_buffers = false;
+
+    /** Whether the server updates the built-in metrics.
+
+        @see server_metrics, use_metrics_service
+    */
+    bool metrics = true;
+};
+
+/** Counters describing a server's connection pool.
+
+    @see http_server::get_pool_stats, https_server::get_pool_stats
+*/
+struct pool_stats
+{
+    /// Number of connection states currently allocated.
+    std::size_t size = 0;
+
+    /// Number of allocated states serving a connection.
+    std::size_t busy = 0;
+
+    /// Largest value of `size` observed.
+    std::size_t peak = 0;
+
+    /// Number of states allocated on demand.
+    std::uint64_t grow_count = 0;
+
+    /// Number of idle states released.
+    std::uint64_t shrink_count = 0;
+};
+
+/** Counters describing a server's connections.
+
+    @see http_server::get_connection_stats
+*/
+struct connection_stats
+{
+    /// Number of connections being served.
+    std::size_t live = 0;
+
+    /// Number of connections still open since a drain began.
+    std::size_t draining = 0;
+
+    /// True once a drain has begun.
+    bool stopping = false;
+};
+
+/** Counters describing TLS handshakes.
+
+    @see https_server::get_tls_stats
+*/
+struct tls_stats
+{
+    /// Handshakes which negotiated a new session.
+    std::uint64_t full_handshakes = 0;
+
+    /// Handshakes which resumed a session.
+    std::uint64_t resumed_handshakes = 0;
+
+    /// Handshakes which failed.
+    std::uint64_t failed_handshakes = 0;
+
+    /// Session IDs found in the cache.
+    std::uint64_t cache_hits = 0;
+
+    /// Session IDs not found in the cache.
+    std::uint64_t cache_misses = 0;
+
+    /// Number of sessions in the cache.
+    std::size_t cached_sessions = 0;
+
+    /// Number of times the ticket key was replaced.
+    std::uint64_t key_rotations = 0;
+
+    /// Connections whose records the kernel encrypts.
+    std::uint64_t ktls_connections = 0;
+};
+
+} // beast2
+} // boost
+
+#endif
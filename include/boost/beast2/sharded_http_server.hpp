@@ -0,0 +1,218 @@
+//
+// Copyright (c) 2026 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/beast2
+//
+
+#ifndef BOOST_BEAST2_SHARDED_HTTP_SERVER_HPP
+#define BOOST_BEAST2_SHARDED_HTTP_SERVER_HPP
+
+#include <boost/beast2/detail/config.hpp>
+#include <boost/beast2/http_server.hpp>
+#include <boost/corosio/endpoint.hpp>
+#include <boost/corosio/io_context.hpp>
+#include <boost/http/config.hpp>
+#include <cstddef>
+#include <system_error>
+
+namespace boost {
+namespace http { class flat_router; }
+namespace beast2 {
+
+/** A thread-per-core HTTP server.
+
+    This class runs several independent @ref http_server
+    instances, called shards. Each shard owns its own
+    `corosio::io_context`, its own listening socket bound
+    with `SO_REUSEPORT` and its own set of workers, and
+    runs on a dedicated thread which is pinned to a CPU
+    core where the platform allows it. The kernel
+    load-balances incoming connections across the shard
+    listeners. The only state shared between shards on
+    the request path is the immutable routing table.
+
+    @par Thread Safety
+    Distinct objects: Safe.
+    Shared objects: Unsafe.
+
+    @par Example
+    @code
+    http::flat_router router;
+    router.add( http::verb::get, "/", my_handler );
+
+    sharded_http_server srv(
+        0, // one shard per CPU this process may use
+        256, // workers per shard
+        std::move( router ),
+        http::shared_parser_config::make(),
+        http::shared_serializer_config::make() );
+
+    srv.bind( corosio::endpoint( addr, 8080 ) );
+    srv.start();
+    // ...
+    srv.stop();
+    srv.join();
+    @endcode
+
+    @see http_server
+*/
+class BOOST_BEAST2_DECL
+    sharded_http_server
+{
+    struct impl;
+    impl* impl_;
+
+    struct shard;
+
+public:
+    /** Destructor.
+
+        The server must be stopped and joined first.
+    */
+    ~sharded_http_server();
+
+    /** Construct a sharded HTTP server.
+
+        @param num_shards The number of shards, each running
+            one event loop on its own thread. If zero, one
+            shard per CPU in the affinity mask of the
+            process is used.
+        @param num_workers Number of worker objects per shard.
+        @param router The router for dispatching requests to
+            handlers. All shards read the same table.
+        @param parser_cfg Shared configuration for request parsers.
+        @param serializer_cfg Shared configuration for response
+            serializers.
+    */
+    sharded_http_server(
+        std::size_t num_shards,
+        std::size_t num_workers,
+        http::flat_router router,
+        http::shared_parser_config parser_cfg,
+        http::shared_serializer_config serializer_cfg);
+
+    /** Construct a sharded HTTP server.
+
+        @param num_shards The number of shards, each running
+            one event loop on its own thread. If zero, one
+            shard per CPU in the affinity mask of the
+            process is used.
+        @param cfg The configuration applied to each shard.
+        @param router The shared router for dispatching requests
+            to handlers. All shards read the same table.
+        @param parser_cfg Shared configuration for request parsers.
+        @param serializer_cfg Shared configuration for response
+            serializers.
+    */
+    sharded_http_server(
+        std::size_t num_shards,
+        server_config const& cfg,
+        shared_router router,
+        http::shared_parser_config parser_cfg,
+        http::shared_serializer_config serializer_cfg);
+
+    sharded_http_server(sharded_http_server const&) = delete;
+    sharded_http_server& operator=(sharded_http_server const&) = delete;
+
+    /** Return the number of shards.
+    */
+    std::size_t
+    size() const noexcept;
+
+    /** Return the I/O context of a shard.
+
+        @param i The shard index, less than @ref size.
+    */
+    corosio::io_context&
+    get_context(std::size_t i) noexcept;
+
+    /** Return the server of a shard.
+
+        @param i The shard index, less than @ref size.
+    */
+    http_server&
+    get_server(std::size_t i) noexcept;
+
+    /** Replace the routing table of every shard.
+
+        The new table is shared by all shards. Each shard
+        switches over between requests without dropping
+        connections.
+
+        @param router The new router.
+
+        @see http_server::replace_router
+    */
+    void
+    replace_router(http::flat_router router);
+
+    /** Bind every shard to the same endpoint.
+
+        Each shard opens its own listening socket with
+        `SO_REUSEPORT` set, so that the kernel distributes
+        incoming connections between them. The port must
+        not be zero, as each shard would then be given a
+        different ephemeral port.
+
+        @param ep The local endpoint to listen on.
+        @return The first error encountered, if any.
+    */
+    std::error_code
+    bind(corosio::endpoint ep);
+
+    /** Start accepting connections.
+
+        Launches one thread per shard, which runs its
+        shard's I/O context until the shard is stopped.
+        When there are no more shards than CPUs in the
+        affinity mask of the process, the thread of shard
+        `i` is pinned to the `i`-th of those CPUs.
+
+        @return The first error pinning a thread, if any.
+            The server runs either way; a shard which
+            could not be pinned is left to the scheduler.
+    */
+    std::error_code
+    start();
+
+    /** Stop all shards.
+
+        The request is posted to each shard's own
+        event loop. This function may be called from
+        any thread.
+    */
+    void
+    stop();
+
+    /** Stop all shards gracefully.
+
+        Each shard drains its connections as described
+        in @ref http_server::drain. This function may be
+        called from any thread.
+    */
+    void
+    drain();
+
+    /** Return the connection counters, summed over all shards.
+    */
+    connection_stats
+    get_connection_stats() const noexcept;
+
+    /** Return the coroutine frame counters, summed over all shards.
+    */
+    frame_pool_stats
+    get_frame_stats() const noexcept;
+
+    /** Block until every shard thread has exited.
+    */
+    void
+    join();
+};
+
+} // beast2
+} // boost
+
+#endif
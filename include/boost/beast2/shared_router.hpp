@@ -0,0 +1,208 @@
+//
+// Copyright (c) 2026 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/beast2
+//
+
+#ifndef BOOST_BEAST2_SHARED_ROUTER_HPP
+#define BOOST_BEAST2_SHARED_ROUTER_HPP
+
+#include <boost/beast2/detail/config.hpp>
+#include <boost/http/server/flat_router.hpp>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace boost {
+namespace beast2 {
+
+/** A shared, immutable handle to a flat router.
+
+    Every worker of every server built from the same
+    handle dispatches through one routing table. Copying
+    the handle only increments a reference count; the
+    table itself is never copied and never modified
+    after construction, so it may be read concurrently
+    from any number of threads.
+
+    The table is placed on its own cache lines, apart
+    from the reference count, so that workers acquiring
+    and releasing handles do not invalidate the lines
+    being read by concurrent dispatches.
+
+    @par Thread Safety
+    Distinct objects: Safe.
+    Shared objects: Safe for const member functions.
+
+    @see http_worker
+*/
+class BOOST_BEAST2_DECL
+    shared_router
+{
+    std::shared_ptr<http::flat_router const> p_;
+
+public:
+    /** Constructor.
+
+        Default-constructed handles are empty.
+    */
+    shared_router() = default;
+
+    /** Constructor.
+
+        The router is moved into a newly allocated,
+        cache-line aligned block.
+
+        @param fr The router to share.
+    */
+    explicit
+    shared_router(http::flat_router fr);
+
+    /** Return the router.
+
+        @par Preconditions
+        The handle is not empty.
+    */
+    http::flat_router const&
+    operator*() const noexcept
+    {
+        return *p_;
+    }
+
+    /** Return a pointer to the router.
+
+        @par Preconditions
+        The handle is not empty.
+    */
+    http::flat_router const*
+    operator->() const noexcept
+    {
+        return p_.get();
+    }
+
+    /** Return true if the handle refers to a router.
+    */
+    explicit
+    operator bool() const noexcept
+    {
+        return p_ != nullptr;
+    }
+
+    /** Return the number of handles sharing the router.
+    */
+    long
+    use_count() const noexcept
+    {
+        return p_.use_count();
+    }
+};
+
+//------------------------------------------------
+
+/** A publication point for replacing a routing table.
+
+    A slot holds the current @ref shared_router together
+    with a version number. Readers keep a cached handle
+    and the version it was taken at, and call @ref update
+    before each request. When nothing has changed this
+    costs a single atomic load; after @ref replace, each
+    reader picks up the new table on its next call, once.
+    Readers never take a lock.
+
+    A table is destroyed when the last reader still
+    holding it refreshes or goes away, so requests which
+    are already being dispatched always complete on the
+    table they started with. A reader which stops calling
+    @ref update, such as an idle pooled worker, keeps its
+    table alive until it is destroyed or calls again. A
+    replacement which races with a reader copying the
+    handle leaves the old table with the slot, until a
+    later replacement or the slot's destruction.
+
+    @par Thread Safety
+    Distinct objects: Safe.
+    Shared objects: Safe.
+
+    @see http_worker, http_server::replace_router
+*/
+class BOOST_BEAST2_DECL
+    router_slot
+{
+    struct node;
+
+    // Readers poll version_, and on a change copy the
+    // handle out of the published node while counted
+    // in readers_. A replaced node is only freed by a
+    // writer which sees no reader in flight after the
+    // new node is published; until then it is retired.
+    std::atomic<std::uint64_t> version_{1};
+    std::atomic<node*> current_;
+    mutable std::atomic<std::size_t> readers_{0};
+    std::mutex m_;
+    std::vector<node*> retired_;
+
+public:
+    /** Destructor.
+    */
+    ~router_slot();
+
+    /** Constructor.
+
+        @param sr The initial routing table.
+    */
+    explicit
+    router_slot(shared_router sr);
+
+    router_slot(router_slot const&) = delete;
+    router_slot& operator=(router_slot const&) = delete;
+
+    /** Return a handle to the current routing table.
+    */
+    shared_router
+    get() const;
+
+    /** Refresh a cached handle if the table changed.
+
+        @param sr The reader's cached handle.
+        @param version The version `sr` was taken at. A
+            value of zero always refreshes.
+        @return `true` if `sr` was replaced.
+    */
+    bool
+    update(
+        shared_router& sr,
+        std::uint64_t& version) const
+    {
+        if(version_.load(
+            std::memory_order_acquire) == version)
+            return false;
+        return refresh(sr, version);
+    }
+
+    /** Publish a new routing table.
+
+        Subsequent calls to @ref update return the new
+        table. This function may be called from any
+        thread; concurrent calls are serialized.
+
+        @param sr The new routing table.
+    */
+    void
+    replace(shared_router sr);
+
+private:
+    bool
+    refresh(
+        shared_router& sr,
+        std::uint64_t& version) const;
+};
+
+} // beast2
+} // boost
+
+#endif
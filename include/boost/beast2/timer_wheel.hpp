@@ -0,0 +1,225 @@
+//
+// Copyright (c) 2026 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/beast2
+//
+
+#ifndef BOOST_BEAST2_TIMER_WHEEL_HPP
+#define BOOST_BEAST2_TIMER_WHEEL_HPP
+
+#include <boost/beast2/detail/config.hpp>
+#include <boost/corosio/io_context.hpp>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+
+namespace boost {
+namespace beast2 {
+
+/** A hierarchical timer wheel.
+
+    The wheel tracks many coarse deadlines, such as
+    connection timeouts, at constant cost per operation.
+    Time is divided into ticks of a fixed resolution.
+    Entries are kept in four levels of 64 slots each,
+    covering 2^24 ticks; deadlines further out wait on
+    an overflow list which is redistributed each time
+    the top level wraps. Arming, re-arming and
+    cancelling an entry are O(1), and each tick touches
+    only one slot, plus an occasional cascade of a
+    higher level slot into the level below. When the
+    wheel falls more than one level of slots behind,
+    as after a stall, it catches up in a single pass
+    over its entries rather than tick by tick.
+
+    Entries are intrusive: the wheel does not allocate.
+
+    @par Thread Safety
+    Distinct objects: Safe.
+    Shared objects: Safe. An entry is disarmed before
+    its expiry handler runs, and handlers are invoked
+    without the wheel locked, so they may arm or cancel
+    entries, including their own. An entry must not be
+    destroyed on one thread while its handler runs on
+    another.
+
+    @see use_timer_wheel
+*/
+class BOOST_BEAST2_DECL
+    timer_wheel
+{
+public:
+    using clock_type = std::chrono::steady_clock;
+    using duration = clock_type::duration;
+    using time_point = clock_type::time_point;
+
+    class entry;
+
+    /** Destructor.
+
+        Entries still armed are disarmed.
+    */
+    ~timer_wheel();
+
+    /** Constructor.
+
+        @param resolution The length of one tick.
+        @param on_wake A function invoked after an entry
+            is armed on a wheel which was empty, so that
+            a driver can resume calling @ref advance.
+    */
+    explicit
+    timer_wheel(
+        duration resolution,
+        std::function<void()> on_wake = {});
+
+    timer_wheel(timer_wheel const&) = delete;
+    timer_wheel& operator=(timer_wheel const&) = delete;
+
+    /** Return the length of one tick.
+    */
+    duration
+    resolution() const noexcept
+    {
+        return res_;
+    }
+
+    /** Return the number of armed entries.
+    */
+    std::size_t
+    size() const noexcept;
+
+    /** Arm an entry.
+
+        If the entry is already armed, on this or another
+        wheel, it is first cancelled. The entry expires
+        during the first call to @ref advance whose time
+        is at or after `expiry`, rounded up to a tick.
+
+        @param e The entry.
+        @param expiry The deadline.
+    */
+    void
+    arm(entry& e, time_point expiry);
+
+    /** Arm an entry relative to the current time.
+
+        @param e The entry.
+        @param d The time from now until expiry.
+    */
+    void
+    arm(entry& e, duration d)
+    {
+        arm(e, clock_type::now() + d);
+    }
+
+    /** Disarm an entry.
+
+        Nothing happens if the entry is not armed.
+
+        @param e The entry.
+    */
+    void
+    cancel(entry& e) noexcept;
+
+    /** Advance the wheel, invoking expired entries.
+
+        Expired entries are collected under the lock, and
+        their handlers invoked after it is released. An
+        entry cancelled before its handler runs is skipped.
+
+        @param now The current time.
+        @return The number of entries which expired.
+    */
+    std::size_t
+    advance(time_point now);
+
+private:
+    static constexpr unsigned bits = 6;
+    static constexpr unsigned slots = 1u << bits;
+    static constexpr unsigned levels = 4;
+    static constexpr std::uint64_t max_delta =
+        (std::uint64_t(1) << (bits * levels)) - 1;
+
+    struct bucket
+    {
+        entry* head = nullptr;
+    };
+
+    void push(bucket& b, entry& e) noexcept;
+    void link(entry& e) noexcept;
+    void unlink(entry& e) noexcept;
+    void cascade(unsigned level) noexcept;
+    void jump(std::uint64_t target) noexcept;
+    void expire(bucket& b) noexcept;
+
+    mutable std::mutex m_;
+    bucket wheel_[levels][slots];
+    bucket overflow_;
+    bucket expired_;
+    time_point base_;
+    duration res_;
+    std::uint64_t now_ = 0;
+    std::size_t size_ = 0;
+    std::function<void()> on_wake_;
+};
+
+//------------------------------------------------
+
+/** An intrusive timer wheel entry.
+
+    The owner sets @ref on_expire, then arms the entry
+    on a wheel. An entry which is destroyed while armed
+    is cancelled first.
+*/
+class timer_wheel::entry
+{
+    friend class timer_wheel;
+
+    entry* prev_ = nullptr;
+    entry* next_ = nullptr;
+    bucket* bucket_ = nullptr;
+    timer_wheel* owner_ = nullptr;
+    std::uint64_t tick_ = 0;
+
+public:
+    /** The function invoked when the entry expires.
+    */
+    std::function<void()> on_expire;
+
+    entry() = default;
+    entry(entry const&) = delete;
+    entry& operator=(entry const&) = delete;
+
+    ~entry()
+    {
+        if(owner_)
+            owner_->cancel(*this);
+    }
+};
+
+//------------------------------------------------
+
+/** Return the timer wheel of an I/O context.
+
+    The wheel is created on first use, with a resolution
+    of 100 milliseconds, and is driven by a single timer
+    on the context which only runs while entries are
+    armed. Expiry handlers are invoked on the context.
+
+    @param ctx The I/O context.
+    @return The context's timer wheel.
+*/
+BOOST_BEAST2_DECL
+timer_wheel&
+use_timer_wheel(corosio::io_context& ctx);
+
+} // beast2
+} // boost
+
+#endif
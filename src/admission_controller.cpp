@@ -0,0 +1,69 @@
+//
+// Copyright (c) 2026 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/beast2
+//
+
+#include <boost/beast2/admission_controller.hpp>
+
+namespace boost {
+namespace beast2 {
+
+bool
+admission_controller::
+admit(
+    clock_type::duration delay,
+    clock_type::time_point now)
+{
+    std::lock_guard<std::mutex> lock(m_);
+    if( ! cfg_.enabled ||
+        delay < cfg_.target)
+    {
+        // queue drained, or never built up
+        first_above_ = {};
+        st_.dropping = false;
+        ++st_.admitted;
+        return true;
+    }
+    if(! st_.dropping)
+    {
+        if(first_above_ == clock_type::time_point{})
+        {
+            first_above_ = now + cfg_.interval;
+            ++st_.admitted;
+            return true;
+        }
+        if(now < first_above_)
+        {
+            ++st_.admitted;
+            return true;
+        }
+        // above target for a whole interval
+        st_.dropping = true;
+    }
+    ++st_.shed;
+    return false;
+}
+
+void
+admission_controller::
+shed() noexcept
+{
+    std::lock_guard<std::mutex> lock(m_);
+    --st_.admitted;
+    ++st_.shed;
+}
+
+admission_stats
+admission_controller::
+get_stats() const
+{
+    std::lock_guard<std::mutex> lock(m_);
+    return st_;
+}
+
+} // beast2
+} // boost
@@ -0,0 +1,168 @@
+//
+// Copyright (c) 2026 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/beast2
+//
+
+#include <boost/beast2/body_writer.hpp>
+#include <boost/system/errc.hpp>
+#include <cstring>
+#include <span>
+
+namespace boost {
+namespace beast2 {
+
+body_writer::
+body_writer(http::route_params& rp)
+    : sink_(rp.res_body)
+    , discard_(rp.req.method() == http::method::head)
+{
+    rp.res.set_chunked(true);
+}
+
+body_writer::
+body_writer(
+    http::route_params& rp,
+    std::uint64_t size)
+    : sink_(rp.res_body)
+    , remain_(size)
+    , sized_(true)
+    , discard_(rp.req.method() == http::method::head)
+{
+    rp.res.set_payload_size(size);
+}
+
+void
+body_writer::
+append(
+    char const* data,
+    std::size_t size)
+{
+    if(discard_)
+        return;
+    if(sized_)
+    {
+        // never write past the declared length
+        if(size > remain_)
+        {
+            overflow_ = true;
+            size = static_cast<std::size_t>(remain_);
+        }
+        remain_ -= size;
+    }
+    if(spill_.empty())
+    {
+        if(prepare_)
+            prepare();
+        auto const n = fill(data, size);
+        data += n;
+        size -= n;
+    }
+    if(size > 0)
+        spill_.append(data, size);
+}
+
+capy::task<system::error_code>
+body_writer::
+flush()
+{
+    if(overflow_)
+        co_return error::body_length_mismatch;
+    if(written_ > 0)
+    {
+        auto [ec] = co_await sink_.commit(written_);
+        if(ec)
+            co_return ec;
+    }
+    prepare_ = true;
+
+    // bytes which did not fit
+    std::size_t pos = 0;
+    while(pos < spill_.size())
+    {
+        prepare();
+        auto const n = fill(
+            spill_.data() + pos, spill_.size() - pos);
+        if(n == 0)
+            co_return system::errc::make_error_code(
+                system::errc::no_buffer_space);
+        auto [ec] = co_await sink_.commit(n);
+        if(ec)
+            co_return ec;
+        pos += n;
+        prepare_ = true;
+    }
+    spill_.clear();
+    written_ = 0;
+    co_return system::error_code();
+}
+
+capy::task<system::error_code>
+body_writer::
+finish()
+{
+    auto ec = co_await flush();
+    if(ec)
+        co_return ec;
+    if(sized_ && ! discard_ && remain_ != 0)
+        co_return error::body_length_mismatch;
+    auto [ec2] = co_await sink_.commit_eof();
+    co_return ec2;
+}
+
+void
+body_writer::
+prepare()
+{
+    auto const v = sink_.prepare(
+        std::span<capy::mutable_buffer>(bufs_));
+    nbuf_ = v.size();
+    ibuf_ = 0;
+    prepared_ = 0;
+    written_ = 0;
+    for(std::size_t i = 0; i < nbuf_; ++i)
+        prepared_ += bufs_[i].size();
+    p_ = nullptr;
+    end_ = nullptr;
+    if(nbuf_ > 0)
+    {
+        p_ = static_cast<char*>(bufs_[0].data());
+        end_ = p_ + bufs_[0].size();
+    }
+    prepare_ = false;
+}
+
+std::size_t
+body_writer::
+fill(
+    char const* data,
+    std::size_t size) noexcept
+{
+    std::size_t n = 0;
+    while(n < size)
+    {
+        if(p_ == end_)
+        {
+            if(ibuf_ + 1 >= nbuf_)
+                break;
+            ++ibuf_;
+            p_ = static_cast<char*>(bufs_[ibuf_].data());
+            end_ = p_ + bufs_[ibuf_].size();
+            continue;
+        }
+        auto k = static_cast<std::size_t>(end_ - p_);
+        if(k > size - n)
+            k = size - n;
+        std::memcpy(p_, data + n, k);
+        p_ += k;
+        n += k;
+    }
+    written_ += n;
+    return n;
+}
+
+} // beast2
+} // boost
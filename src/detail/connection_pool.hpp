@@ -0,0 +1,312 @@
+//
+// Copyright (c) 2026 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/beast2
+//
+
+#ifndef BOOST_BEAST2_SRC_DETAIL_CONNECTION_POOL_HPP
+#define BOOST_BEAST2_SRC_DETAIL_CONNECTION_POOL_HPP
+
+#include <boost/beast2/server_config.hpp>
+#include <boost/beast2/timer_wheel.hpp>
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+namespace boost {
+namespace beast2 {
+namespace detail {
+
+/** Return a configuration allocating every state up front.
+
+    This is what the constructors taking a number of
+    workers use.
+*/
+inline
+server_config
+fixed_config(std::size_t num_workers) noexcept
+{
+    server_config cfg;
+    cfg.min_workers = num_workers;
+    cfg.max_workers = num_workers;
+    return cfg;
+}
+
+/** An elastic pool of per-connection state objects.
+
+    Objects are created on demand up to a maximum and
+    handed out by unique ownership. Released objects go
+    to the back of an idle list, so `acquire` returns the
+    most recently used (cache-warm) object, while the
+    oldest idle objects at the front are trimmed once
+    they exceed the configured linger time.
+
+    Trimming happens on every acquire and release, and
+    from an entry on a timer wheel which is armed while
+    there are idle objects above the minimum, so that
+    they are given back even when traffic stops.
+*/
+template<class T>
+class connection_pool
+{
+    using clock_type = std::chrono::steady_clock;
+
+    struct idle_entry
+    {
+        std::unique_ptr<T> p;
+        clock_type::time_point since;
+    };
+
+    mutable std::mutex m_;
+    std::deque<idle_entry> idle_;
+    std::function<std::unique_ptr<T>()> make_;
+    server_config cfg_;
+    pool_stats st_;
+    timer_wheel* wheel_;
+    bool armed_ = false;
+
+    // Declared last, so that it is cancelled
+    // before the rest of the pool is destroyed
+    timer_wheel::entry timer_;
+
+    // Arm the timer for the oldest idle object
+    // above the minimum, if there is one. Should
+    // arming fail, trimming still happens on the
+    // next acquire or release.
+    void
+    schedule() noexcept
+    {
+        if( armed_ ||
+            ! wheel_ ||
+            idle_.empty() ||
+            st_.size <= cfg_.min_workers)
+            return;
+        try
+        {
+            wheel_->arm(timer_,
+                idle_.front().since + cfg_.shrink_after);
+            armed_ = true;
+        }
+        catch(...)
+        {
+        }
+    }
+
+    void
+    on_timer() noexcept
+    {
+        // destroyed after the lock is released
+        std::deque<idle_entry> trimmed;
+
+        std::lock_guard<std::mutex> lock(m_);
+        armed_ = false;
+        trim(trimmed, clock_type::now());
+        schedule();
+    }
+
+    // Move expired idle objects into `out`, oldest first
+    void
+    trim(
+        std::deque<idle_entry>& out,
+        clock_type::time_point now)
+    {
+        while(
+            ! idle_.empty() &&
+            st_.size > cfg_.min_workers &&
+            now - idle_.front().since > cfg_.shrink_after)
+        {
+            out.push_back(std::move(idle_.front()));
+            idle_.pop_front();
+            --st_.size;
+            ++st_.shrink_count;
+        }
+    }
+
+public:
+    /** Constructor.
+
+        @param cfg The pool sizes and linger time.
+        @param make A function returning a new object.
+        @param wheel The wheel which times out idle
+            objects, or null to trim only on acquire
+            and release.
+    */
+    template<class Make>
+    connection_pool(
+        server_config const& cfg,
+        Make&& make,
+        timer_wheel* wheel = nullptr)
+        : make_(std::forward<Make>(make))
+        , cfg_(cfg)
+        , wheel_(wheel)
+    {
+        timer_.on_expire = [this]
+            {
+                on_timer();
+            };
+        if(cfg_.max_workers < 1)
+            cfg_.max_workers = 1;
+        if(cfg_.min_workers > cfg_.max_workers)
+            cfg_.min_workers = cfg_.max_workers;
+        auto const now = clock_type::now();
+        for(std::size_t i = 0; i < cfg_.min_workers; ++i)
+            idle_.push_back({ make_(), now });
+        st_.size = cfg_.min_workers;
+        st_.peak = st_.size;
+    }
+
+    server_config const&
+    config() const noexcept
+    {
+        return cfg_;
+    }
+
+    /** Return an object, or null if the pool is at capacity.
+    */
+    std::unique_ptr<T>
+    acquire()
+    {
+        // destroyed after the lock is released
+        std::deque<idle_entry> trimmed;
+
+        std::unique_lock<std::mutex> lock(m_);
+        trim(trimmed, clock_type::now());
+        if(! idle_.empty())
+        {
+            auto p = std::move(idle_.back().p);
+            idle_.pop_back();
+            ++st_.busy;
+            return p;
+        }
+        if(st_.size >= cfg_.max_workers)
+            return nullptr;
+        ++st_.size;
+        ++st_.busy;
+        ++st_.grow_count;
+        if(st_.peak < st_.size)
+            st_.peak = st_.size;
+        lock.unlock();
+
+        // construct outside the lock, it allocates
+        try
+        {
+            return make_();
+        }
+        catch(...)
+        {
+            lock.lock();
+            --st_.size;
+            --st_.busy;
+            throw;
+        }
+    }
+
+    /** Give an object back to the pool.
+    */
+    void
+    release(std::unique_ptr<T> p) noexcept
+    {
+        // destroyed after the lock is released
+        std::deque<idle_entry> trimmed;
+
+        auto const now = clock_type::now();
+        std::lock_guard<std::mutex> lock(m_);
+        --st_.busy;
+        idle_.push_back({ std::move(p), now });
+        trim(trimmed, now);
+        schedule();
+    }
+
+    /** Destroy an object instead of giving it back.
+
+        This is for an object left in an unknown state,
+        for example by an exception.
+    */
+    void
+    discard(std::unique_ptr<T> p) noexcept
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_);
+            --st_.busy;
+            --st_.size;
+        }
+        p.reset();
+    }
+
+    pool_stats
+    get_stats() const
+    {
+        std::lock_guard<std::mutex> lock(m_);
+        return st_;
+    }
+};
+
+//------------------------------------------------
+
+/** An object borrowed from a @ref connection_pool.
+
+    Call @ref release once the object is back in a
+    reusable state. An object still held when the lease
+    is destroyed, as when a session exits by exception,
+    is discarded, so the pool's counts stay correct.
+*/
+template<class T>
+class pool_lease
+{
+    connection_pool<T>& pool_;
+    std::unique_ptr<T> p_;
+
+public:
+    explicit
+    pool_lease(connection_pool<T>& pool)
+        : pool_(pool)
+        , p_(pool.acquire())
+    {
+    }
+
+    pool_lease(pool_lease const&) = delete;
+    pool_lease& operator=(pool_lease const&) = delete;
+
+    ~pool_lease()
+    {
+        if(p_)
+            pool_.discard(std::move(p_));
+    }
+
+    explicit
+    operator bool() const noexcept
+    {
+        return p_ != nullptr;
+    }
+
+    T*
+    get() const noexcept
+    {
+        return p_.get();
+    }
+
+    T*
+    operator->() const noexcept
+    {
+        return p_.get();
+    }
+
+    /** Give the object back to the pool.
+    */
+    void
+    release() noexcept
+    {
+        pool_.release(std::move(p_));
+    }
+};
+
+} // detail
+} // beast2
+} // boost
+
+#endif
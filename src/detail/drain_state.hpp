@@ -0,0 +1,110 @@
+//
+// Copyright (c) 2026 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/beast2
+//
+
+#ifndef BOOST_BEAST2_SRC_DETAIL_DRAIN_STATE_HPP
+#define BOOST_BEAST2_SRC_DETAIL_DRAIN_STATE_HPP
+
+#include <boost/beast2/server_config.hpp>
+#include <boost/capy/task.hpp>
+#include <boost/corosio/io_context.hpp>
+#include <boost/corosio/timer.hpp>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+
+namespace boost {
+namespace beast2 {
+namespace detail {
+
+/** Connection accounting and drain state of one server.
+
+    The counters are atomic so that stats may be read
+    from any thread. Everything else, including the
+    calls to @ref closed, happens on the server's I/O
+    context.
+*/
+class drain_state
+{
+    std::atomic<bool> draining_{false};
+    std::atomic<std::size_t> live_{0};
+    corosio::timer timer_;
+
+public:
+    explicit
+    drain_state(corosio::io_context& ctx)
+        : timer_(ctx)
+    {
+    }
+
+    /** Return the flag sessions poll to close early.
+    */
+    std::atomic<bool> const&
+    closing() const noexcept
+    {
+        return draining_;
+    }
+
+    /** Begin draining.
+
+        @return `false` if a drain had already begun.
+    */
+    bool
+    start() noexcept
+    {
+        return ! draining_.exchange(
+            true, std::memory_order_relaxed);
+    }
+
+    void
+    opened() noexcept
+    {
+        live_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void
+    closed()
+    {
+        // the last connection ends the wait early
+        if( live_.fetch_sub(1, std::memory_order_relaxed) == 1 &&
+            draining_.load(std::memory_order_relaxed))
+            timer_.cancel();
+    }
+
+    /** Wait for every connection to close.
+
+        @return `true` if none remain, `false` if the
+            timeout elapsed first.
+    */
+    capy::task<bool>
+    wait(std::chrono::steady_clock::duration timeout)
+    {
+        if(live_.load(std::memory_order_relaxed) == 0)
+            co_return true;
+        timer_.expires_after(timeout);
+        (void)co_await timer_.wait();
+        co_return live_.load(std::memory_order_relaxed) == 0;
+    }
+
+    connection_stats
+    get_stats() const noexcept
+    {
+        connection_stats st;
+        st.live = live_.load(std::memory_order_relaxed);
+        st.stopping = draining_.load(std::memory_order_relaxed);
+        if(st.stopping)
+            st.draining = st.live;
+        return st;
+    }
+};
+
+} // detail
+} // beast2
+} // boost
+
+#endif
@@ -0,0 +1,85 @@
+//
+// Copyright (c) 2026 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/beast2
+//
+
+#ifndef BOOST_BEAST2_SRC_DETAIL_FRAME_TOTALS_HPP
+#define BOOST_BEAST2_SRC_DETAIL_FRAME_TOTALS_HPP
+
+#include <boost/beast2/frame_pool.hpp>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace boost {
+namespace beast2 {
+namespace detail {
+
+/** Frame pool counters summed over the workers of a server.
+
+    A pool belongs to one worker and is not safe to read
+    from other threads, so each worker adds what changed
+    in its pool when a session ends. The sums may then be
+    read from any thread.
+*/
+class frame_totals
+{
+    std::atomic<std::uint64_t> allocations_{0};
+    std::atomic<std::uint64_t> heap_allocations_{0};
+    std::atomic<std::size_t> cached_bytes_{0};
+
+public:
+    /** Add the change since `last`, then update `last`.
+    */
+    void
+    report(
+        frame_pool const& fp,
+        frame_pool_stats& last) noexcept
+    {
+        auto const now = fp.get_stats();
+        allocations_.fetch_add(
+            now.allocations - last.allocations,
+            std::memory_order_relaxed);
+        heap_allocations_.fetch_add(
+            now.heap_allocations - last.heap_allocations,
+            std::memory_order_relaxed);
+        // wraps around when the pool shrank
+        cached_bytes_.fetch_add(
+            now.cached_bytes - last.cached_bytes,
+            std::memory_order_relaxed);
+        last = now;
+    }
+
+    /** Remove the cached bytes of a pool being destroyed.
+    */
+    void
+    forget(frame_pool_stats const& last) noexcept
+    {
+        cached_bytes_.fetch_sub(
+            last.cached_bytes,
+            std::memory_order_relaxed);
+    }
+
+    frame_pool_stats
+    get() const noexcept
+    {
+        frame_pool_stats st;
+        st.allocations = allocations_.load(
+            std::memory_order_relaxed);
+        st.heap_allocations = heap_allocations_.load(
+            std::memory_order_relaxed);
+        st.cached_bytes = cached_bytes_.load(
+            std::memory_order_relaxed);
+        return st;
+    }
+};
+
+} // detail
+} // beast2
+} // boost
+
+#endif
@@ -0,0 +1,120 @@
+//
+// Copyright (c) 2026 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/beast2
+//
+
+#ifndef BOOST_BEAST2_SRC_DETAIL_HOME_STREAM_HPP
+#define BOOST_BEAST2_SRC_DETAIL_HOME_STREAM_HPP
+
+#include <boost/capy/buffers.hpp>
+#include <boost/capy/ex/run.hpp>
+#include <boost/capy/task.hpp>
+#include <boost/system/errc.hpp>
+#include <cstddef>
+
+namespace boost {
+namespace beast2 {
+namespace detail {
+
+/** A stream whose operations run on the executor of its socket.
+
+    While @ref away is set, the coroutine reading and
+    writing runs elsewhere, such as a TLS handshake on a
+    thread pool. Each operation then moves to the home
+    executor, runs there, and moves back, so the socket
+    is only ever touched by its own event loop, as it is
+    by a deadline cancelling it.
+
+    A deadline which fires while the coroutine is away
+    may find no operation to cancel. It sets @ref expired
+    as well, which is checked on the home executor before
+    each operation starts.
+
+    A stream built over this one may outlive the socket,
+    and be given the next connection's with @ref rebind.
+*/
+template<class Stream, class Executor>
+class home_stream
+{
+    Stream* next_;
+    Executor home_;
+
+    static
+    capy::io_result<std::size_t>
+    canceled() noexcept
+    {
+        return { system::errc::make_error_code(
+            system::errc::operation_canceled), 0 };
+    }
+
+    template<class MutableBufferSequence>
+    capy::task<capy::io_result<std::size_t>>
+    read_home(MutableBufferSequence const& buffers)
+    {
+        if(expired)
+            co_return canceled();
+        co_return co_await next_->read_some(buffers);
+    }
+
+    template<class ConstBufferSequence>
+    capy::task<capy::io_result<std::size_t>>
+    write_home(ConstBufferSequence const& buffers)
+    {
+        if(expired)
+            co_return canceled();
+        co_return co_await next_->write_some(buffers);
+    }
+
+public:
+    // Set and cleared on the home executor
+    bool away = false;
+    bool expired = false;
+
+    home_stream(
+        Stream& next,
+        Executor home) noexcept
+        : next_(&next)
+        , home_(home)
+    {
+    }
+
+    /** Forward to another socket, as for a new connection.
+
+        Both flags are cleared.
+    */
+    void
+    rebind(Stream& next) noexcept
+    {
+        next_ = &next;
+        away = false;
+        expired = false;
+    }
+
+    template<class MutableBufferSequence>
+    capy::task<capy::io_result<std::size_t>>
+    read_some(MutableBufferSequence const& buffers)
+    {
+        if(! away)
+            co_return co_await next_->read_some(buffers);
+        co_return co_await capy::run(home_)(read_home(buffers));
+    }
+
+    template<class ConstBufferSequence>
+    capy::task<capy::io_result<std::size_t>>
+    write_some(ConstBufferSequence const& buffers)
+    {
+        if(! away)
+            co_return co_await next_->write_some(buffers);
+        co_return co_await capy::run(home_)(write_home(buffers));
+    }
+};
+
+} // detail
+} // beast2
+} // boost
+
+#endif
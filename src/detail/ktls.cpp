@@ -0,0 +1,549 @@
+//
+// Copyright (c) 2026 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/beast2
+//
+
+#include "src/detail/ktls.hpp"
+#include <cstring>
+#include <list>
+#include <mutex>
+#include <string_view>
+
+#include <openssl/crypto.h>
+#include <openssl/evp.h>
+#include <openssl/kdf.h>
+#include <openssl/ssl.h>
+
+#ifdef __linux__
+# include <linux/tls.h>
+# include <netinet/in.h>
+# include <netinet/tcp.h>
+# include <sys/socket.h>
+# include <sys/uio.h>
+# ifndef SOL_TLS
+#  define SOL_TLS 282
+# endif
+# ifndef TCP_ULP
+#  define TCP_ULP 31
+# endif
+#endif
+
+namespace boost {
+namespace beast2 {
+namespace detail {
+
+// The key log callback replaced on a context,
+// which is owned until the callback is restored
+struct ktls_ctx_entry
+{
+    SSL_CTX* ctx;
+    SSL_CTX_keylog_cb_func prev;
+};
+
+namespace {
+
+// Finds the ktls_state of a connection
+int
+ssl_index()
+{
+    static int const i = SSL_get_ex_new_index(
+        0, nullptr, nullptr, nullptr, nullptr);
+    return i;
+}
+
+// Finds the key log callback we replaced
+int
+keylog_index()
+{
+    static int const i = SSL_CTX_get_ex_new_index(
+        0, nullptr, nullptr, nullptr, nullptr);
+    return i;
+}
+
+// Counts the records sent and received since each
+// direction last changed keys. Record headers are
+// reported before the message they carry, so the
+// record holding the change itself is not counted.
+void
+on_message(
+    int write_p,
+    int,
+    int content_type,
+    void const* buf,
+    std::size_t len,
+    SSL* ssl,
+    void* arg)
+{
+    auto& st = *static_cast<ktls_state*>(arg);
+    auto& seq = write_p ? st.tx_seq : st.rx_seq;
+    auto const p = static_cast<unsigned char const*>(buf);
+    bool const tls13 = SSL_version(ssl) == TLS1_3_VERSION;
+    switch(content_type)
+    {
+    // TLS 1.2 changes keys after ChangeCipherSpec. The
+    // message is not reported when it is received, so
+    // the type in the record header is used instead.
+    // In TLS 1.3 the message is only for middleboxes.
+    case SSL3_RT_HEADER:
+        if( ! tls13 && len > 0 &&
+            p[0] == SSL3_RT_CHANGE_CIPHER_SPEC)
+            seq = 0;
+        else
+            ++seq;
+        break;
+
+    // TLS 1.3 changes to the traffic keys after Finished
+    case SSL3_RT_HANDSHAKE:
+        if(tls13 && len > 0 && p[0] == SSL3_MT_FINISHED)
+            seq = 0;
+        break;
+
+    default:
+        break;
+    }
+}
+
+int
+unhex(char c) noexcept
+{
+    if(c >= '0' && c <= '9')
+        return c - '0';
+    if(c >= 'a' && c <= 'f')
+        return c - 'a' + 10;
+    if(c >= 'A' && c <= 'F')
+        return c - 'A' + 10;
+    return -1;
+}
+
+std::size_t
+parse_hex(
+    std::string_view s,
+    unsigned char* out,
+    std::size_t cap) noexcept
+{
+    if(s.size() % 2 != 0 || s.size() / 2 > cap)
+        return 0;
+    for(std::size_t i = 0; i < s.size(); i += 2)
+    {
+        auto const hi = unhex(s[i]);
+        auto const lo = unhex(s[i + 1]);
+        if(hi < 0 || lo < 0)
+            return 0;
+        out[i / 2] = static_cast<unsigned char>(hi * 16 + lo);
+    }
+    return s.size() / 2;
+}
+
+// Records the TLS 1.3 application traffic secrets,
+// then passes the line on to any previous callback
+void
+on_keylog(
+    SSL const* ssl,
+    char const* line)
+{
+    auto const e = static_cast<ktls_ctx_entry*>(SSL_CTX_get_ex_data(
+        SSL_get_SSL_CTX(ssl), keylog_index()));
+    if(e && e->prev)
+        e->prev(ssl, line);
+
+    auto const st = static_cast<ktls_state*>(
+        SSL_get_ex_data(ssl, ssl_index()));
+    if(! st)
+        return;
+
+    // LABEL <client random> <secret>
+    std::string_view s(line);
+    auto const sp1 = s.find(' ');
+    auto const sp2 = s.rfind(' ');
+    if(sp1 == s.npos || sp2 == sp1)
+        return;
+    auto const label = s.substr(0, sp1);
+    auto const secret = s.substr(sp2 + 1);
+    bool const server = SSL_is_server(const_cast<SSL*>(ssl)) == 1;
+    if(label == (server
+        ? "SERVER_TRAFFIC_SECRET_0"
+        : "CLIENT_TRAFFIC_SECRET_0"))
+        st->tx_secret_size = parse_hex(
+            secret, st->tx_secret, sizeof(st->tx_secret));
+    else if(label == (server
+        ? "CLIENT_TRAFFIC_SECRET_0"
+        : "SERVER_TRAFFIC_SECRET_0"))
+        st->rx_secret_size = parse_hex(
+            secret, st->rx_secret, sizeof(st->rx_secret));
+}
+
+// HKDF-Expand-Label from RFC 8446 with an empty context
+bool
+expand_label(
+    EVP_MD const* md,
+    unsigned char const* secret,
+    std::size_t secret_size,
+    std::string_view label,
+    unsigned char* out,
+    std::size_t size)
+{
+    unsigned char info[2 + 1 + 6 + 16 + 1];
+    std::size_t n = 0;
+    info[n++] = static_cast<unsigned char>(size >> 8);
+    info[n++] = static_cast<unsigned char>(size);
+    info[n++] = static_cast<unsigned char>(6 + label.size());
+    std::memcpy(info + n, "tls13 ", 6);
+    n += 6;
+    std::memcpy(info + n, label.data(), label.size());
+    n += label.size();
+    info[n++] = 0;
+
+    auto const pc = EVP_PKEY_CTX_new_id(EVP_PKEY_HKDF, nullptr);
+    if(! pc)
+        return false;
+    bool const ok =
+        EVP_PKEY_derive_init(pc) == 1 &&
+        EVP_PKEY_CTX_set_hkdf_mode(pc,
+            EVP_PKEY_HKDEF_MODE_EXPAND_ONLY) == 1 &&
+        EVP_PKEY_CTX_set_hkdf_md(pc, md) == 1 &&
+        EVP_PKEY_CTX_set1_hkdf_key(pc, secret,
+            static_cast<int>(secret_size)) == 1 &&
+        EVP_PKEY_CTX_add1_hkdf_info(pc, info,
+            static_cast<int>(n)) == 1 &&
+        EVP_PKEY_derive(pc, out, &size) == 1;
+    EVP_PKEY_CTX_free(pc);
+    return ok;
+}
+
+// The key block of RFC 5246 section 6.3, for an AEAD
+// cipher: client key, server key, client IV, server IV
+bool
+key_block(
+    SSL* ssl,
+    EVP_MD const* md,
+    unsigned char* out,
+    std::size_t size)
+{
+    unsigned char master[SSL_MAX_MASTER_KEY_LENGTH];
+    unsigned char client_random[SSL3_RANDOM_SIZE];
+    unsigned char server_random[SSL3_RANDOM_SIZE];
+    auto const master_size = SSL_SESSION_get_master_key(
+        SSL_get_session(ssl), master, sizeof(master));
+    SSL_get_client_random(ssl, client_random, sizeof(client_random));
+    SSL_get_server_random(ssl, server_random, sizeof(server_random));
+
+    auto const pc = EVP_PKEY_CTX_new_id(EVP_PKEY_TLS1_PRF, nullptr);
+    bool ok = pc &&
+        EVP_PKEY_derive_init(pc) == 1 &&
+        EVP_PKEY_CTX_set_tls1_prf_md(pc, md) == 1 &&
+        EVP_PKEY_CTX_set1_tls1_prf_secret(pc, master,
+            static_cast<int>(master_size)) == 1 &&
+        EVP_PKEY_CTX_add1_tls1_prf_seed(pc,
+            reinterpret_cast<unsigned char const*>(
+                "key expansion"), 13) == 1 &&
+        EVP_PKEY_CTX_add1_tls1_prf_seed(pc, server_random,
+            sizeof(server_random)) == 1 &&
+        EVP_PKEY_CTX_add1_tls1_prf_seed(pc, client_random,
+            sizeof(client_random)) == 1 &&
+        EVP_PKEY_derive(pc, out, &size) == 1;
+    EVP_PKEY_CTX_free(pc);
+    OPENSSL_cleanse(master, sizeof(master));
+    return ok;
+}
+
+} // (anon)
+
+ktls_keys::
+~ktls_keys()
+{
+    OPENSSL_cleanse(key, sizeof(key));
+    OPENSSL_cleanse(iv, sizeof(iv));
+}
+
+bool
+derive_ktls_keys(
+    ssl_st* ssl,
+    ktls_state const& st,
+    bool tx,
+    ktls_keys& k) noexcept
+{
+    auto const cipher = SSL_get_current_cipher(ssl);
+    if(! cipher)
+        return false;
+    auto const nid = SSL_CIPHER_get_cipher_nid(cipher);
+    switch(nid)
+    {
+    case NID_aes_128_gcm:
+        k.key_size = 16;
+        break;
+    case NID_aes_256_gcm:
+    case NID_chacha20_poly1305:
+        k.key_size = 32;
+        break;
+    default:
+        return false;
+    }
+    auto const md = SSL_CIPHER_get_handshake_digest(cipher);
+    if(! md)
+        return false;
+
+    auto seq = tx ? st.tx_seq : st.rx_seq;
+    for(int i = 7; i >= 0; --i, seq >>= 8)
+        k.rec_seq[i] = static_cast<unsigned char>(seq);
+
+    auto const version = SSL_version(ssl);
+    if(version == TLS1_3_VERSION)
+    {
+        auto const secret = tx ? st.tx_secret : st.rx_secret;
+        auto const size = tx ? st.tx_secret_size : st.rx_secret_size;
+        return size > 0 &&
+            expand_label(md, secret, size, "key", k.key, k.key_size) &&
+            expand_label(md, secret, size, "iv", k.iv, sizeof(k.iv));
+    }
+    if(version != TLS1_2_VERSION)
+        return false;
+
+    // AES-GCM takes four bytes of the IV from the key
+    // block, and an explicit nonce which only has to be
+    // unique; the kernel increments it per record.
+    bool const gcm = nid != NID_chacha20_poly1305;
+    std::size_t const iv_size = gcm ? 4 : 12;
+    unsigned char block[2 * 32 + 2 * 12];
+    if(! key_block(ssl, md, block, 2 * (k.key_size + iv_size)))
+        return false;
+    bool const ours = tx == (SSL_is_server(ssl) == 1);
+    std::memcpy(k.key,
+        block + (ours ? k.key_size : 0), k.key_size);
+    std::memcpy(k.iv,
+        block + 2 * k.key_size + (ours ? iv_size : 0), iv_size);
+    if(gcm)
+        std::memcpy(k.iv + 4, k.rec_seq, 8);
+    OPENSSL_cleanse(block, sizeof(block));
+    return true;
+}
+
+namespace {
+
+#ifdef __linux__
+
+union crypto_info
+{
+    tls12_crypto_info_aes_gcm_128 gcm128;
+    tls12_crypto_info_aes_gcm_256 gcm256;
+#ifdef TLS_CIPHER_CHACHA20_POLY1305
+    tls12_crypto_info_chacha20_poly1305 chacha;
+#endif
+
+    ~crypto_info()
+    {
+        OPENSSL_cleanse(this, sizeof(*this));
+    }
+};
+
+template<class Info>
+std::size_t
+fill_gcm(
+    Info& c,
+    unsigned short version,
+    unsigned short cipher_type,
+    ktls_keys const& k)
+{
+    c.info.version = version;
+    c.info.cipher_type = cipher_type;
+    std::memcpy(c.key, k.key, sizeof(c.key));
+    std::memcpy(c.salt, k.iv, sizeof(c.salt));
+    std::memcpy(c.iv, k.iv + sizeof(c.salt), sizeof(c.iv));
+    std::memcpy(c.rec_seq, k.rec_seq, sizeof(c.rec_seq));
+    return sizeof(c);
+}
+
+// Fill in the argument to TLS_TX or TLS_RX. Returns
+// its size, or zero if the connection is unsupported.
+std::size_t
+make_crypto_info(
+    SSL* ssl,
+    ktls_state const& st,
+    bool tx,
+    crypto_info& ci)
+{
+    unsigned short version;
+    if(SSL_version(ssl) == TLS1_2_VERSION)
+        version = TLS_1_2_VERSION;
+#ifdef TLS_1_3_VERSION
+    else if(SSL_version(ssl) == TLS1_3_VERSION)
+        version = TLS_1_3_VERSION;
+#endif
+    else
+        return 0;
+
+    ktls_keys k;
+    if(! derive_ktls_keys(ssl, st, tx, k))
+        return 0;
+    switch(SSL_CIPHER_get_cipher_nid(SSL_get_current_cipher(ssl)))
+    {
+    case NID_aes_128_gcm:
+        return fill_gcm(ci.gcm128, version,
+            TLS_CIPHER_AES_GCM_128, k);
+
+    case NID_aes_256_gcm:
+        return fill_gcm(ci.gcm256, version,
+            TLS_CIPHER_AES_GCM_256, k);
+
+#ifdef TLS_CIPHER_CHACHA20_POLY1305
+    case NID_chacha20_poly1305:
+    {
+        auto& c = ci.chacha;
+        c.info.version = version;
+        c.info.cipher_type = TLS_CIPHER_CHACHA20_POLY1305;
+        std::memcpy(c.key, k.key, sizeof(c.key));
+        std::memcpy(c.iv, k.iv, sizeof(c.iv));
+        std::memcpy(c.rec_seq, k.rec_seq, sizeof(c.rec_seq));
+        return sizeof(c);
+    }
+#endif
+
+    default:
+        return 0;
+    }
+}
+
+#endif
+
+} // (anon)
+
+struct ktls_offload::impl
+{
+    std::mutex m;
+
+    // stable addresses, pointed to by ex_data
+    std::list<ktls_ctx_entry> installed;
+
+    void
+    install(SSL_CTX* ctx)
+    {
+        // Already hooked, here or by another offload.
+        // Secrets go to the connection's own state, so
+        // either hook serves every connection.
+        std::lock_guard<std::mutex> lock(m);
+        if(SSL_CTX_get_keylog_callback(ctx) == &on_keylog)
+            return;
+        SSL_CTX_up_ref(ctx);
+        auto& e = installed.emplace_back(
+            ktls_ctx_entry{ ctx, SSL_CTX_get_keylog_callback(ctx) });
+        SSL_CTX_set_ex_data(ctx, keylog_index(), &e);
+        SSL_CTX_set_keylog_callback(ctx, &on_keylog);
+    }
+};
+
+ktls_offload::
+~ktls_offload()
+{
+    for(auto const& e : impl_->installed)
+    {
+        if(SSL_CTX_get_ex_data(e.ctx, keylog_index()) == &e)
+        {
+            SSL_CTX_set_keylog_callback(e.ctx, e.prev);
+            SSL_CTX_set_ex_data(e.ctx, keylog_index(), nullptr);
+        }
+        SSL_CTX_free(e.ctx);
+    }
+}
+
+ktls_offload::
+ktls_offload()
+    : impl_(new impl)
+{
+}
+
+void
+ktls_offload::
+prepare(
+    ssl_st* ssl,
+    ktls_state& st)
+{
+    st.reset();
+    impl_->install(SSL_get_SSL_CTX(ssl));
+    SSL_set_ex_data(ssl, ssl_index(), &st);
+    SSL_set_msg_callback(ssl, &on_message);
+    SSL_set_msg_callback_arg(ssl, &st);
+}
+
+ktls_mode
+ktls_offload::
+enable(
+    ssl_st* ssl,
+    ktls_state& st,
+    int fd) noexcept
+{
+    auto mode = ktls_mode::none;
+#ifdef __linux__
+    // OpenSSL must be left with nothing to do: bytes it
+    // has read but not processed, or written but not yet
+    // sent, cannot be handed to the kernel
+    auto const rbio = SSL_get_rbio(ssl);
+    auto const wbio = SSL_get_wbio(ssl);
+    crypto_info tx;
+    crypto_info rx;
+    auto const n = make_crypto_info(ssl, st, true, tx);
+    if( n > 0 &&
+        ! SSL_has_pending(ssl) &&
+        (! rbio || BIO_ctrl_pending(rbio) == 0) &&
+        (! wbio || BIO_ctrl_wpending(wbio) == 0) &&
+        make_crypto_info(ssl, st, false, rx) == n &&
+        ::setsockopt(fd, SOL_TCP, TCP_ULP, "tls", sizeof("tls")) == 0 &&
+        ::setsockopt(fd, SOL_TLS, TLS_RX, &rx, n) == 0)
+    {
+        // Until a direction is installed the socket passes
+        // bytes through unchanged, so receive goes first.
+        // Once it is in, OpenSSL can no longer be used.
+        if(::setsockopt(fd, SOL_TLS, TLS_TX, &tx, n) == 0)
+        {
+            mode = ktls_mode::tx_rx;
+            offloaded_.fetch_add(1, std::memory_order_relaxed);
+        }
+        else
+        {
+            mode = ktls_mode::failed;
+        }
+    }
+#else
+    (void)fd;
+#endif
+    SSL_set_ex_data(ssl, ssl_index(), nullptr);
+    SSL_set_msg_callback(ssl, nullptr);
+    OPENSSL_cleanse(st.tx_secret, sizeof(st.tx_secret));
+    OPENSSL_cleanse(st.rx_secret, sizeof(st.rx_secret));
+    return mode;
+}
+
+void
+ktls_offload::
+close(
+    ssl_st* ssl,
+    int fd) noexcept
+{
+#ifdef __linux__
+    // An alert record: warning, close_notify
+    unsigned char alert[2] = { 1, 0 };
+    char control[CMSG_SPACE(sizeof(unsigned char))] = {};
+    iovec iov{ alert, sizeof(alert) };
+    msghdr msg{};
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+    auto const cm = CMSG_FIRSTHDR(&msg);
+    cm->cmsg_level = SOL_TLS;
+    cm->cmsg_type = TLS_SET_RECORD_TYPE;
+    cm->cmsg_len = CMSG_LEN(sizeof(unsigned char));
+    *CMSG_DATA(cm) = SSL3_RT_ALERT;
+    ::sendmsg(fd, &msg, MSG_DONTWAIT | MSG_NOSIGNAL);
+#else
+    (void)fd;
+#endif
+    SSL_set_shutdown(ssl,
+        SSL_SENT_SHUTDOWN | SSL_RECEIVED_SHUTDOWN);
+}
+
+} // detail
+} // beast2
+} // boost
@@ -0,0 +1,188 @@
+//
+// Copyright (c) 2026 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/beast2
+//
+
+#ifndef BOOST_BEAST2_SRC_DETAIL_KTLS_HPP
+#define BOOST_BEAST2_SRC_DETAIL_KTLS_HPP
+
+#include <boost/beast2/detail/config.hpp>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+struct ssl_st;
+
+namespace boost {
+namespace beast2 {
+namespace detail {
+
+/** Which directions of a connection the kernel encrypts.
+*/
+enum class ktls_mode
+{
+    // OpenSSL keeps the connection
+    none,
+
+    // the kernel encrypts and decrypts
+    tx_rx,
+
+    // the socket was left unusable, and must be closed
+    failed
+};
+
+/** What a connection learns during its handshake.
+
+    The kernel must be given the traffic keys and the
+    sequence number of the next record in each direction.
+    OpenSSL exposes neither, so they are collected from
+    its callbacks while the handshake runs.
+*/
+struct ktls_state
+{
+    // TLS 1.3 traffic secrets, from the key log
+    unsigned char tx_secret[64];
+    unsigned char rx_secret[64];
+    std::size_t tx_secret_size = 0;
+    std::size_t rx_secret_size = 0;
+
+    // Records since the last change of keys
+    std::uint64_t tx_seq = 0;
+    std::uint64_t rx_seq = 0;
+
+    void
+    reset() noexcept
+    {
+        tx_secret_size = 0;
+        rx_secret_size = 0;
+        tx_seq = 0;
+        rx_seq = 0;
+    }
+};
+
+/** The record protection of one direction of a connection.
+
+    This is what the kernel is given. `iv` is the whole
+    nonce of the next record before it is combined with
+    the sequence number; for AES-GCM under TLS 1.2 that
+    is the four byte salt followed by the explicit nonce.
+*/
+struct ktls_keys
+{
+    unsigned char key[32];
+    unsigned char iv[12];
+    unsigned char rec_seq[8];
+    std::size_t key_size = 0;
+
+    ~ktls_keys();
+};
+
+/** Derive the record protection of one direction.
+
+    @param tx `true` for the direction this end writes.
+
+    @return `false` if the version or cipher is not
+        supported, or the keys are unknown.
+*/
+bool
+derive_ktls_keys(
+    ssl_st* ssl,
+    ktls_state const& st,
+    bool tx,
+    ktls_keys& k) noexcept;
+
+/** Moves the record layer of TLS connections into the kernel.
+
+    After the handshake, the keys are installed on the
+    socket with `TLS_RX` and `TLS_TX`, and the socket is
+    then read and written as plain TCP. Both directions
+    move, or neither does: with only transmit in the
+    kernel, OpenSSL would still read, and could answer a
+    KeyUpdate or send an alert through a socket which
+    encrypts everything written to it a second time.
+    A connection is only offloaded when OpenSSL holds no
+    bytes it has read but not processed, nor bytes it has
+    written but not sent. Records the kernel cannot
+    handle after that, such as a TLS 1.3 KeyUpdate, fail
+    the read, and the connection is closed.
+
+    OpenSSL's own `SSL_OP_ENABLE_KTLS` is of no use here:
+    OpenSSL only offloads when its BIOs are the socket
+    itself, while connections are driven through memory
+    BIOs by the TLS stream.
+
+    AES-128-GCM, AES-256-GCM and ChaCha20-Poly1305 are
+    supported, with TLS 1.2 and 1.3. On other platforms,
+    and for other ciphers, nothing is offloaded.
+
+    @par Thread Safety
+    Shared objects: Safe.
+*/
+class ktls_offload
+{
+public:
+    ~ktls_offload();
+
+    ktls_offload();
+
+    ktls_offload(ktls_offload const&) = delete;
+    ktls_offload& operator=(ktls_offload const&) = delete;
+
+    /** Prepare a connection before its handshake.
+
+        The key log callback is installed on the
+        connection's OpenSSL context the first time it is
+        seen. The context is then kept alive until this
+        object is destroyed, which restores the callback.
+    */
+    void
+    prepare(
+        ssl_st* ssl,
+        ktls_state& st);
+
+    /** Install the keys on the socket after the handshake.
+
+        @return The directions offloaded.
+    */
+    ktls_mode
+    enable(
+        ssl_st* ssl,
+        ktls_state& st,
+        int fd) noexcept;
+
+    /** End an offloaded connection.
+
+        A `close_notify` alert is sent through the kernel,
+        and the session is marked as cleanly shut down so
+        that it remains resumable.
+    */
+    static
+    void
+    close(
+        ssl_st* ssl,
+        int fd) noexcept;
+
+    /** Return the number of connections offloaded.
+    */
+    std::uint64_t
+    offloaded() const noexcept
+    {
+        return offloaded_.load(std::memory_order_relaxed);
+    }
+
+private:
+    struct impl;
+    std::unique_ptr<impl> impl_;
+    std::atomic<std::uint64_t> offloaded_{0};
+};
+
+} // detail
+} // beast2
+} // boost
+
+#endif
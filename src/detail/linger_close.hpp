@@ -0,0 +1,64 @@
+//
+// Copyright (c) 2026 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/beast2
+//
+
+#ifndef BOOST_BEAST2_SRC_DETAIL_LINGER_CLOSE_HPP
+#define BOOST_BEAST2_SRC_DETAIL_LINGER_CLOSE_HPP
+
+#include <boost/beast2/timer_wheel.hpp>
+#include <boost/capy/buffers.hpp>
+#include <boost/capy/task.hpp>
+#include <boost/corosio/tcp_socket.hpp>
+#include <cstddef>
+
+namespace boost {
+namespace beast2 {
+namespace detail {
+
+/** Close a connection without discarding what the peer sent.
+
+    Closing a socket whose receive buffer still holds
+    unread bytes makes the kernel answer with a reset,
+    which can destroy a response the peer has not yet
+    read. The sending side is shut down first, so the
+    peer sees the end of the response, then incoming
+    bytes are read and discarded until the peer closes,
+    `limit` bytes have been read, or `timeout` elapses.
+*/
+inline
+capy::task<void>
+linger_close(
+    corosio::tcp_socket& sock,
+    timer_wheel& wheel,
+    timer_wheel::duration timeout,
+    std::size_t limit = 64 * 1024)
+{
+    sock.shutdown(corosio::tcp_socket::shutdown_send);
+    if(timeout == timer_wheel::duration::zero())
+        co_return;
+
+    timer_wheel::entry deadline;
+    deadline.on_expire = [&sock]{ sock.cancel(); };
+    wheel.arm(deadline, timeout);
+    char buf[2048];
+    while(limit > 0)
+    {
+        auto [ec, n] = co_await sock.read_some(
+            capy::mutable_buffer(buf, sizeof(buf)));
+        if(ec)
+            break;
+        limit -= n < limit ? n : limit;
+    }
+    wheel.cancel(deadline);
+}
+
+} // detail
+} // beast2
+} // boost
+
+#endif
@@ -0,0 +1,45 @@
+//
+// Copyright (c) 2026 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/beast2
+//
+
+#ifndef BOOST_BEAST2_SRC_DETAIL_PROGRESS_DEADLINE_HPP
+#define BOOST_BEAST2_SRC_DETAIL_PROGRESS_DEADLINE_HPP
+
+#include <boost/beast2/timer_wheel.hpp>
+
+namespace boost {
+namespace beast2 {
+namespace detail {
+
+/** A deadline which is pushed back whenever bytes move.
+
+    Writers call @ref touch after each write which made
+    progress, so that a transfer is only cut off when it
+    stalls for longer than @ref timeout, however long it
+    takes as a whole.
+*/
+struct progress_deadline
+{
+    timer_wheel* wheel = nullptr;
+    timer_wheel::entry* entry = nullptr;
+    timer_wheel::duration timeout{};
+
+    void
+    touch()
+    {
+        if( wheel &&
+            timeout != timer_wheel::duration::zero())
+            wheel->arm(*entry, timeout);
+    }
+};
+
+} // detail
+} // beast2
+} // boost
+
+#endif
@@ -0,0 +1,125 @@
+//
+// Copyright (c) 2026 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/beast2
+//
+
+#ifndef BOOST_BEAST2_SRC_DETAIL_SENDFILE_HPP
+#define BOOST_BEAST2_SRC_DETAIL_SENDFILE_HPP
+
+#ifdef __linux__
+
+#include "src/detail/progress_deadline.hpp"
+#include <boost/capy/buffers.hpp>
+#include <boost/capy/task.hpp>
+#include <boost/capy/write.hpp>
+#include <boost/corosio/tcp_socket.hpp>
+#include <boost/core/detail/string_view.hpp>
+#include <boost/system/error_code.hpp>
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <memory>
+#include <sys/sendfile.h>
+#include <unistd.h>
+
+namespace boost {
+namespace beast2 {
+namespace detail {
+
+/** Send a header, then a file range, on a socket.
+
+    The header goes out with one write, then the kernel
+    copies the file straight from the page cache into the
+    socket. This is used by plain connections, and by TLS
+    connections whose records the kernel encrypts.
+    Each call which moves bytes pushes back `deadline`.
+
+    When the socket buffer is full, the next chunk is
+    read into memory and written with the socket's own
+    write, which waits for room; `sendfile` then resumes
+    behind it. The socket is only ever waited on through
+    its ordinary write operation.
+*/
+inline
+capy::task<system::error_code>
+sendfile_range(
+    corosio::tcp_socket& sock,
+    core::string_view header,
+    int fd,
+    std::uint64_t offset,
+    std::uint64_t size,
+    progress_deadline& deadline)
+{
+    auto [ec, n] = co_await capy::write(sock,
+        capy::const_buffer(header.data(), header.size()));
+    if(ec)
+        co_return ec;
+    if(n > 0)
+        deadline.touch();
+
+    constexpr std::size_t copy_size = 16 * 1024;
+    std::unique_ptr<char[]> buf;
+    ::off_t off = static_cast<::off_t>(offset);
+    while(size > 0)
+    {
+        // sendfile moves at most 0x7ffff000 bytes per call
+        auto const chunk = static_cast<std::size_t>(
+            (std::min)(size, std::uint64_t(0x7ffff000)));
+        auto const rv = ::sendfile(
+            sock.native_handle(), fd, &off, chunk);
+        if(rv > 0)
+        {
+            size -= static_cast<std::uint64_t>(rv);
+            deadline.touch();
+            continue;
+        }
+        if(rv == 0)
+        {
+            // the file was truncated under us
+            co_return system::errc::make_error_code(
+                system::errc::io_error);
+        }
+        if(errno == EINTR)
+            continue;
+        if(errno != EAGAIN)
+            co_return system::error_code(
+                errno, system::system_category());
+
+        // socket buffer full
+        if(! buf)
+            buf.reset(new char[copy_size]);
+        auto const got = ::pread(fd, buf.get(),
+            static_cast<std::size_t>((std::min)(
+                size, std::uint64_t(copy_size))), off);
+        if(got < 0 && errno == EINTR)
+            continue;
+        if(got < 0)
+            co_return system::error_code(
+                errno, system::system_category());
+        if(got == 0)
+            co_return system::errc::make_error_code(
+                system::errc::io_error);
+        auto [wec, wn] = co_await capy::write(sock,
+            capy::const_buffer(buf.get(),
+                static_cast<std::size_t>(got)));
+        if(wec)
+            co_return wec;
+        (void)wn;
+        off += got;
+        size -= static_cast<std::uint64_t>(got);
+        deadline.touch();
+    }
+    co_return system::error_code();
+}
+
+} // detail
+} // beast2
+} // boost
+
+#endif
+
+#endif
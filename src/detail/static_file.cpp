@@ -0,0 +1,118 @@
+//
+// Copyright (c) 2026 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/beast2
+//
+
+#include "src/detail/static_file.hpp"
+#include <boost/http/field.hpp>
+#include <boost/url/parse_path.hpp>
+
+namespace boost {
+namespace beast2 {
+namespace detail {
+
+bool
+map_path(
+    std::pmr::string& path,
+    core::string_view root,
+    core::string_view rel)
+{
+    auto rv = urls::parse_path(rel);
+    if(rv.has_error())
+        return false;
+    path.assign(root.data(), root.size());
+    if(! path.empty() && path.back() == '/')
+        path.pop_back();
+    for(auto seg : *rv)
+    {
+        path.push_back('/');
+        auto const start = path.size();
+        for(char c : *seg)
+        {
+            // decoded, a separator or NUL would
+            // escape the segment
+            if(c == '/' || c == '\\' || c == '\0')
+                return false;
+            path.push_back(c);
+        }
+        core::string_view const s(
+            path.data() + start, path.size() - start);
+        if(s.empty() || s == "." || s == "..")
+            return false;
+    }
+    return true;
+}
+
+bool
+is_partial_or_conditional(
+    http::request const& req) noexcept
+{
+    return
+        req.exists(http::field::range) ||
+        req.exists(http::field::if_range) ||
+        req.exists(http::field::if_match) ||
+        req.exists(http::field::if_none_match) ||
+        req.exists(http::field::if_modified_since) ||
+        req.exists(http::field::if_unmodified_since);
+}
+
+core::string_view
+content_type(core::string_view path) noexcept
+{
+    auto const dot = path.rfind('.');
+    if(dot == core::string_view::npos)
+        return "application/octet-stream";
+    auto const ext = path.substr(dot + 1);
+    struct entry { core::string_view ext, type; };
+    static constexpr entry types[] = {
+        { "htm",  "text/html; charset=utf-8" },
+        { "html", "text/html; charset=utf-8" },
+        { "css",  "text/css" },
+        { "js",   "application/javascript" },
+        { "mjs",  "application/javascript" },
+        { "json", "application/json" },
+        { "map",  "application/json" },
+        { "xml",  "application/xml" },
+        { "txt",  "text/plain; charset=utf-8" },
+        { "csv",  "text/csv" },
+        { "png",  "image/png" },
+        { "jpg",  "image/jpeg" },
+        { "jpeg", "image/jpeg" },
+        { "gif",  "image/gif" },
+        { "svg",  "image/svg+xml" },
+        { "ico",  "image/x-icon" },
+        { "webp", "image/webp" },
+        { "woff2","font/woff2" },
+        { "mp4",  "video/mp4" },
+        { "webm", "video/webm" },
+        { "pdf",  "application/pdf" },
+        { "zip",  "application/zip" },
+        { "gz",   "application/gzip" },
+        { "wasm", "application/wasm" },
+    };
+    for(auto const& e : types)
+        if(e.ext == ext)
+            return e.type;
+    return "application/octet-stream";
+}
+
+bool
+is_compressible(core::string_view type) noexcept
+{
+    return
+        type.starts_with("text/") ||
+        type == "application/javascript" ||
+        type == "application/json" ||
+        type == "application/xml" ||
+        type == "application/wasm" ||
+        type == "image/svg+xml" ||
+        type == "image/x-icon";
+}
+
+} // detail
+} // beast2
+} // boost
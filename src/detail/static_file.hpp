@@ -0,0 +1,85 @@
+//
+// Copyright (c) 2026 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/beast2
+//
+
+#ifndef BOOST_BEAST2_SRC_DETAIL_STATIC_FILE_HPP
+#define BOOST_BEAST2_SRC_DETAIL_STATIC_FILE_HPP
+
+#include <boost/beast2/detail/config.hpp>
+#include <boost/core/detail/string_view.hpp>
+#include <boost/http/server/router.hpp>
+#include <memory_resource>
+#include <string>
+
+#ifndef _WIN32
+# include <unistd.h>
+#endif
+
+namespace boost {
+namespace beast2 {
+namespace detail {
+
+/** Map a request path onto a document root.
+
+    The path is the percent-encoded part of the target
+    below the mount point of the route, such as
+    `route_params::path`, so that a handler mounted on
+    `/static` maps `/static/a.css` to `<root>/a.css`.
+
+    @return `false` if the path could climb out of the
+        root, or names a directory.
+*/
+BOOST_BEAST2_DECL
+bool
+map_path(
+    std::pmr::string& path,
+    core::string_view root,
+    core::string_view rel);
+
+/** Return true if a request is for a range, or is conditional.
+
+    Such requests are left to `http::serve_static`, which
+    answers them with `206` or `304` as appropriate.
+*/
+BOOST_BEAST2_DECL
+bool
+is_partial_or_conditional(
+    http::request const& req) noexcept;
+
+#ifndef _WIN32
+
+/** Closes a file descriptor on scope exit.
+*/
+struct file_handle
+{
+    int fd;
+
+    ~file_handle()
+    {
+        if(fd >= 0)
+            ::close(fd);
+    }
+};
+
+#endif
+
+/** Return the media type for a file name.
+*/
+core::string_view
+content_type(core::string_view path) noexcept;
+
+/** Return true if a media type benefits from compression.
+*/
+bool
+is_compressible(core::string_view type) noexcept;
+
+} // detail
+} // beast2
+} // boost
+
+#endif
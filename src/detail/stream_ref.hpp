@@ -0,0 +1,56 @@
+//
+// Copyright (c) 2026 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/beast2
+//
+
+#ifndef BOOST_BEAST2_SRC_DETAIL_STREAM_REF_HPP
+#define BOOST_BEAST2_SRC_DETAIL_STREAM_REF_HPP
+
+namespace boost {
+namespace beast2 {
+namespace detail {
+
+/** A stream which forwards each operation to another.
+
+    A stream built over this one, such as a TLS stream,
+    may outlive the socket it was first given, and be
+    pointed at the next connection's with @ref rebind.
+    The operations of the socket are returned as they
+    are, so no coroutine frame is added.
+*/
+template<class Stream>
+class stream_ref
+{
+    Stream* next_ = nullptr;
+
+public:
+    void
+    rebind(Stream& next) noexcept
+    {
+        next_ = &next;
+    }
+
+    template<class MutableBufferSequence>
+    auto
+    read_some(MutableBufferSequence const& buffers)
+    {
+        return next_->read_some(buffers);
+    }
+
+    template<class ConstBufferSequence>
+    auto
+    write_some(ConstBufferSequence const& buffers)
+    {
+        return next_->write_some(buffers);
+    }
+};
+
+} // detail
+} // beast2
+} // boost
+
+#endif
@@ -0,0 +1,60 @@
+//
+// Copyright (c) 2026 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/beast2
+//
+
+#ifndef BOOST_BEAST2_SRC_DETAIL_STRING_UTIL_HPP
+#define BOOST_BEAST2_SRC_DETAIL_STRING_UTIL_HPP
+
+#include <boost/core/detail/string_view.hpp>
+#include <cstddef>
+
+namespace boost {
+namespace beast2 {
+namespace detail {
+
+// Field names and tokens are case-insensitive ASCII,
+// so these do not depend on the locale
+
+inline
+char
+to_lower(char c) noexcept
+{
+    if(c >= 'A' && c <= 'Z')
+        return static_cast<char>(c + ('a' - 'A'));
+    return c;
+}
+
+inline
+bool
+iequals(core::string_view a, core::string_view b) noexcept
+{
+    if(a.size() != b.size())
+        return false;
+    for(std::size_t i = 0; i < a.size(); ++i)
+        if(to_lower(a[i]) != to_lower(b[i]))
+            return false;
+    return true;
+}
+
+// Remove optional whitespace, RFC 9110 section 5.6.3
+inline
+core::string_view
+trim(core::string_view s) noexcept
+{
+    while(! s.empty() && (s.front() == ' ' || s.front() == '\t'))
+        s.remove_prefix(1);
+    while(! s.empty() && (s.back() == ' ' || s.back() == '\t'))
+        s.remove_suffix(1);
+    return s;
+}
+
+} // detail
+} // beast2
+} // boost
+
+#endif
@@ -0,0 +1,98 @@
+//
+// Copyright (c) 2026 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/beast2
+//
+
+#ifndef BOOST_BEAST2_SRC_DETAIL_TAP_STREAM_HPP
+#define BOOST_BEAST2_SRC_DETAIL_TAP_STREAM_HPP
+
+#include "src/detail/progress_deadline.hpp"
+#include <boost/beast2/metrics_service.hpp>
+#include <boost/beast2/request_trace.hpp>
+#include <boost/beast2/response_tap.hpp>
+#include <boost/capy/buffers.hpp>
+#include <boost/capy/task.hpp>
+#include <boost/capy/write.hpp>
+#include <cstddef>
+
+namespace boost {
+namespace beast2 {
+namespace detail {
+
+/** A write stream which forwards to another and records.
+
+    The serializer writes through this stream, so that
+    a @ref response_tap sees exactly the bytes which go
+    out on the wire. If @ref trace is set, each write
+    stamps @ref trace_point::last_byte. Bytes written are
+    added to @ref bytes, and each write which makes
+    progress pushes back @ref deadline.
+*/
+template<class Stream>
+class tap_stream : public response_tap
+{
+    Stream* next_ = nullptr;
+
+    // Called after each write which moved bytes
+    void
+    progress() noexcept
+    {
+        deadline.touch();
+#ifndef BOOST_BEAST2_NO_REQUEST_TRACE
+        if(trace)
+            trace->mark(trace_point::last_byte);
+#endif
+    }
+
+public:
+    request_trace* trace = nullptr;
+    counter bytes;
+    progress_deadline deadline;
+
+    void
+    attach(Stream& next) noexcept
+    {
+        next_ = &next;
+    }
+
+    template<class ConstBufferSequence>
+    capy::task<capy::io_result<std::size_t>>
+    write_some(ConstBufferSequence const& buffers)
+    {
+        auto [ec, n] = co_await next_->write_some(buffers);
+        auto left = n;
+        for(auto it = capy::begin(buffers);
+            left > 0 && it != capy::end(buffers); ++it)
+        {
+            capy::const_buffer b(*it);
+            auto const k = b.size() < left ? b.size() : left;
+            record(b.data(), k);
+            left -= k;
+        }
+        bytes.add(n);
+        if(n > 0)
+            progress();
+        co_return {ec, n};
+    }
+
+    capy::task<system::error_code>
+    write(core::string_view s) override
+    {
+        auto [ec, n] = co_await capy::write(*next_,
+            capy::const_buffer(s.data(), s.size()));
+        bytes.add(n);
+        if(n > 0)
+            progress();
+        co_return ec;
+    }
+};
+
+} // detail
+} // beast2
+} // boost
+
+#endif
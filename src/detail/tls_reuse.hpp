@@ -0,0 +1,58 @@
+//
+// Copyright (c) 2026 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/beast2
+//
+
+#ifndef BOOST_BEAST2_SRC_DETAIL_TLS_REUSE_HPP
+#define BOOST_BEAST2_SRC_DETAIL_TLS_REUSE_HPP
+
+#include <openssl/bio.h>
+#include <openssl/ssl.h>
+
+namespace boost {
+namespace beast2 {
+namespace detail {
+
+/** Ready the SSL object of a finished connection for the next.
+
+    The object keeps its BIOs, options and mode, and
+    `SSL_clear` discards the state of the connection,
+    such as its keys and handshake progress. Record
+    buffers are kept for the next connection, unless
+    `SSL_MODE_RELEASE_BUFFERS` frees them while idle.
+    The object is left waiting for a server handshake.
+
+    Bytes of the old connection still held by the object
+    or either BIO would be taken as part of the new one,
+    so the object is not reused then. Neither is it after
+    a handshake failure or an unclean shutdown; the caller
+    decides those, and frees the object instead.
+
+    @return `true` if the object may serve another
+        connection.
+*/
+inline
+bool
+reuse_tls(SSL* ssl) noexcept
+{
+    auto const rbio = SSL_get_rbio(ssl);
+    auto const wbio = SSL_get_wbio(ssl);
+    if( SSL_has_pending(ssl) ||
+        (rbio && BIO_ctrl_pending(rbio) != 0) ||
+        (wbio && BIO_ctrl_pending(wbio) != 0))
+        return false;
+    if(SSL_clear(ssl) != 1)
+        return false;
+    SSL_set_accept_state(ssl);
+    return true;
+}
+
+} // detail
+} // beast2
+} // boost
+
+#endif
@@ -0,0 +1,522 @@
+//
+// Copyright (c) 2026 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/beast2
+//
+
+#include "src/detail/tls_session_cache.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <openssl/evp.h>
+#include <openssl/rand.h>
+#include <openssl/ssl.h>
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+# include <openssl/core_names.h>
+#else
+# include <openssl/hmac.h>
+#endif
+
+namespace boost {
+namespace beast2 {
+namespace detail {
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+constexpr std::size_t shard_count = 16;
+
+// Marks an SSL_CTX as using a cache, and finds it
+int
+ctx_index()
+{
+    static int const i = SSL_CTX_get_ex_new_index(
+        0, nullptr, nullptr, nullptr, nullptr);
+    return i;
+}
+
+unsigned char const session_context[] = "beast2";
+
+} // (anon)
+
+struct tls_session_cache::impl
+{
+    struct entry
+    {
+        std::string der;
+        clock_type::time_point expires;
+        std::list<std::string>::iterator lru;
+    };
+
+    // Sessions are spread over shards by id, so that
+    // handshakes on different threads rarely contend
+    struct shard
+    {
+        std::mutex m;
+        std::unordered_map<std::string, entry> map;
+
+        // least recently stored at the front
+        std::list<std::string> lru;
+    };
+
+    struct ticket_key
+    {
+        unsigned char name[16];
+        unsigned char aes[32];
+        unsigned char hmac[32];
+        clock_type::time_point created;
+    };
+
+    tls_session_config const cfg;
+    std::size_t const shard_capacity;
+    shard shards[shard_count];
+
+    std::mutex keys_m;
+    ticket_key current;
+    ticket_key previous;
+    bool has_previous = false;
+
+    // Each context is owned until the cache is destroyed,
+    // so an address seen here is never reused by another
+    std::mutex ctx_m;
+    std::vector<SSL_CTX*> installed;
+
+    std::atomic<std::uint64_t> full{0};
+    std::atomic<std::uint64_t> resumed{0};
+    std::atomic<std::uint64_t> failed{0};
+    std::atomic<std::uint64_t> hits{0};
+    std::atomic<std::uint64_t> misses{0};
+    std::atomic<std::uint64_t> rotations{0};
+
+    explicit
+    impl(tls_session_config const& cfg_)
+        : cfg(cfg_)
+        , shard_capacity(
+            (cfg_.cache_size + shard_count - 1) / shard_count)
+    {
+        make_key(current);
+    }
+
+    ~impl()
+    {
+        for(auto ctx : installed)
+        {
+            // another cache may have been installed since
+            if(from(ctx) == this)
+                uninstall(ctx);
+            SSL_CTX_free(ctx);
+        }
+    }
+
+    static
+    impl*
+    from(SSL* ssl) noexcept
+    {
+        return static_cast<impl*>(SSL_CTX_get_ex_data(
+            SSL_get_SSL_CTX(ssl), ctx_index()));
+    }
+
+    static
+    impl*
+    from(SSL_CTX* ctx) noexcept
+    {
+        return static_cast<impl*>(
+            SSL_CTX_get_ex_data(ctx, ctx_index()));
+    }
+
+    shard&
+    shard_for(std::string const& id) noexcept
+    {
+        return shards[std::hash<std::string>()(id) % shard_count];
+    }
+
+    static
+    void
+    make_key(ticket_key& k) noexcept
+    {
+        RAND_bytes(k.name, sizeof(k.name));
+        RAND_bytes(k.aes, sizeof(k.aes));
+        RAND_bytes(k.hmac, sizeof(k.hmac));
+        k.created = clock_type::now();
+    }
+
+    //--------------------------------------------
+
+    void
+    install(SSL_CTX* ctx)
+    {
+        std::lock_guard<std::mutex> lock(ctx_m);
+        if(from(ctx) == this)
+            return;
+        if(std::find(installed.begin(), installed.end(),
+                ctx) == installed.end())
+        {
+            SSL_CTX_up_ref(ctx);
+            installed.push_back(ctx);
+        }
+        SSL_CTX_set_ex_data(ctx, ctx_index(), this);
+        SSL_CTX_set_timeout(ctx, static_cast<long>(
+            cfg.lifetime.count()));
+        SSL_CTX_set_session_id_context(ctx,
+            session_context, sizeof(session_context) - 1);
+        if(cfg.cache)
+        {
+            SSL_CTX_set_session_cache_mode(ctx,
+                SSL_SESS_CACHE_SERVER |
+                SSL_SESS_CACHE_NO_INTERNAL);
+            SSL_CTX_sess_set_new_cb(ctx, &on_new);
+            SSL_CTX_sess_set_get_cb(ctx, &on_get);
+            SSL_CTX_sess_set_remove_cb(ctx, &on_remove);
+        }
+        else
+        {
+            SSL_CTX_set_session_cache_mode(ctx,
+                SSL_SESS_CACHE_OFF);
+        }
+        if(cfg.tickets)
+        {
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+            SSL_CTX_set_tlsext_ticket_key_evp_cb(ctx, &on_ticket);
+#else
+            SSL_CTX_set_tlsext_ticket_key_cb(ctx, &on_ticket);
+#endif
+        }
+    }
+
+    // Leave the context as OpenSSL makes it
+    static
+    void
+    uninstall(SSL_CTX* ctx) noexcept
+    {
+        SSL_CTX_set_ex_data(ctx, ctx_index(), nullptr);
+        SSL_CTX_sess_set_new_cb(ctx, nullptr);
+        SSL_CTX_sess_set_get_cb(ctx, nullptr);
+        SSL_CTX_sess_set_remove_cb(ctx, nullptr);
+        SSL_CTX_set_session_cache_mode(ctx,
+            SSL_SESS_CACHE_SERVER);
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+        SSL_CTX_set_tlsext_ticket_key_evp_cb(ctx, nullptr);
+#else
+        SSL_CTX_set_tlsext_ticket_key_cb(ctx, nullptr);
+#endif
+    }
+
+    //--------------------------------------------
+
+    static
+    int
+    on_new(SSL* ssl, SSL_SESSION* sess)
+    {
+        auto const self = from(ssl);
+        if(! self)
+            return 0;
+        unsigned int n = 0;
+        auto const id = SSL_SESSION_get_id(sess, &n);
+        int const len = i2d_SSL_SESSION(sess, nullptr);
+        if(len <= 0)
+            return 0;
+        std::string der(static_cast<std::size_t>(len), '\0');
+        auto p = reinterpret_cast<unsigned char*>(&der[0]);
+        i2d_SSL_SESSION(sess, &p);
+        self->store(std::string(
+            reinterpret_cast<char const*>(id), n), std::move(der));
+
+        // the session is not kept by reference
+        return 0;
+    }
+
+    static
+    SSL_SESSION*
+    on_get(
+        SSL* ssl,
+        unsigned char const* id,
+        int len,
+        int* copy)
+    {
+        *copy = 0;
+        auto const self = from(ssl);
+        if(! self)
+            return nullptr;
+        std::string const key(
+            reinterpret_cast<char const*>(id),
+            static_cast<std::size_t>(len));
+        std::string der;
+        if(! self->find(key, der))
+        {
+            self->misses.fetch_add(1, std::memory_order_relaxed);
+            return nullptr;
+        }
+        self->hits.fetch_add(1, std::memory_order_relaxed);
+        auto p = reinterpret_cast<unsigned char const*>(der.data());
+        return d2i_SSL_SESSION(nullptr, &p,
+            static_cast<long>(der.size()));
+    }
+
+    static
+    void
+    on_remove(SSL_CTX* ctx, SSL_SESSION* sess)
+    {
+        auto const self = from(ctx);
+        if(! self)
+            return;
+        unsigned int n = 0;
+        auto const id = SSL_SESSION_get_id(sess, &n);
+        self->erase(std::string(
+            reinterpret_cast<char const*>(id), n));
+    }
+
+    void
+    store(std::string id, std::string der)
+    {
+        auto& s = shard_for(id);
+        auto const expires = clock_type::now() + cfg.lifetime;
+        std::lock_guard<std::mutex> lock(s.m);
+        auto it = s.map.find(id);
+        if(it != s.map.end())
+        {
+            it->second.der = std::move(der);
+            it->second.expires = expires;
+            s.lru.splice(s.lru.end(), s.lru, it->second.lru);
+            return;
+        }
+        while(! s.lru.empty() && s.map.size() >= shard_capacity)
+        {
+            s.map.erase(s.lru.front());
+            s.lru.pop_front();
+        }
+        s.lru.push_back(id);
+        s.map.emplace(std::move(id),
+            entry{ std::move(der), expires, std::prev(s.lru.end()) });
+    }
+
+    bool
+    find(
+        std::string const& id,
+        std::string& der)
+    {
+        auto& s = shard_for(id);
+        std::lock_guard<std::mutex> lock(s.m);
+        auto it = s.map.find(id);
+        if(it == s.map.end())
+            return false;
+        if(it->second.expires <= clock_type::now())
+        {
+            s.lru.erase(it->second.lru);
+            s.map.erase(it);
+            return false;
+        }
+        der = it->second.der;
+        return true;
+    }
+
+    void
+    erase(std::string const& id)
+    {
+        auto& s = shard_for(id);
+        std::lock_guard<std::mutex> lock(s.m);
+        auto it = s.map.find(id);
+        if(it == s.map.end())
+            return;
+        s.lru.erase(it->second.lru);
+        s.map.erase(it);
+    }
+
+    //--------------------------------------------
+
+    // Return the key to seal a new ticket with,
+    // rotating it when it is old enough
+    ticket_key
+    sealing_key()
+    {
+        std::lock_guard<std::mutex> lock(keys_m);
+        if(clock_type::now() - current.created >= cfg.ticket_rotation)
+        {
+            previous = current;
+            has_previous = true;
+            make_key(current);
+            rotations.fetch_add(1, std::memory_order_relaxed);
+        }
+        return current;
+    }
+
+    // Find the key a ticket was sealed with. Returns
+    // 1 for the current key, 2 for the previous one,
+    // or 0 if the key is unknown.
+    int
+    opening_key(
+        unsigned char const* name,
+        ticket_key& k)
+    {
+        std::lock_guard<std::mutex> lock(keys_m);
+        if(std::memcmp(name, current.name, sizeof(current.name)) == 0)
+        {
+            k = current;
+            return 1;
+        }
+        if( has_previous &&
+            std::memcmp(name, previous.name, sizeof(previous.name)) == 0)
+        {
+            k = previous;
+            return 2;
+        }
+        return 0;
+    }
+
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+    static
+    bool
+    init_mac(
+        EVP_MAC_CTX* hctx,
+        ticket_key& k)
+    {
+        char digest[] = "SHA256";
+        OSSL_PARAM params[] = {
+            OSSL_PARAM_construct_octet_string(
+                OSSL_MAC_PARAM_KEY, k.hmac, sizeof(k.hmac)),
+            OSSL_PARAM_construct_utf8_string(
+                OSSL_MAC_PARAM_DIGEST, digest, 0),
+            OSSL_PARAM_construct_end() };
+        return EVP_MAC_CTX_set_params(hctx, params) == 1;
+    }
+
+    static
+    int
+    on_ticket(
+        SSL* ssl,
+        unsigned char* name,
+        unsigned char* iv,
+        EVP_CIPHER_CTX* cctx,
+        EVP_MAC_CTX* hctx,
+        int enc)
+#else
+    static
+    bool
+    init_mac(
+        HMAC_CTX* hctx,
+        ticket_key& k)
+    {
+        return HMAC_Init_ex(hctx, k.hmac,
+            sizeof(k.hmac), EVP_sha256(), nullptr) == 1;
+    }
+
+    static
+    int
+    on_ticket(
+        SSL* ssl,
+        unsigned char* name,
+        unsigned char* iv,
+        EVP_CIPHER_CTX* cctx,
+        HMAC_CTX* hctx,
+        int enc)
+#endif
+    {
+        auto const self = from(ssl);
+        if(! self)
+            return -1;
+        if(enc)
+        {
+            auto k = self->sealing_key();
+            std::memcpy(name, k.name, sizeof(k.name));
+            if(RAND_bytes(iv, 16) != 1)
+                return -1;
+            if(EVP_EncryptInit_ex(cctx,
+                    EVP_aes_256_cbc(), nullptr, k.aes, iv) != 1)
+                return -1;
+            if(! init_mac(hctx, k))
+                return -1;
+            return 1;
+        }
+
+        ticket_key k;
+        int const which = self->opening_key(name, k);
+        if(which == 0)
+            return 0; // full handshake
+        if(EVP_DecryptInit_ex(cctx,
+                EVP_aes_256_cbc(), nullptr, k.aes, iv) != 1)
+            return -1;
+        if(! init_mac(hctx, k))
+            return -1;
+
+        // 2 asks for a ticket under the current key
+        return which;
+    }
+};
+
+tls_session_cache::
+~tls_session_cache() = default;
+
+tls_session_cache::
+tls_session_cache(tls_session_config const& cfg)
+    : impl_(new impl(cfg))
+{
+}
+
+void
+tls_session_cache::
+prepare(ssl_st* ssl)
+{
+    impl_->install(SSL_get_SSL_CTX(ssl));
+
+    // These were copied from the context when
+    // the connection was created
+    SSL_set_session_id_context(ssl,
+        session_context, sizeof(session_context) - 1);
+    if(! impl_->cfg.tickets)
+        SSL_set_options(ssl, SSL_OP_NO_TICKET);
+}
+
+bool
+tls_session_cache::
+on_handshake(
+    ssl_st* ssl,
+    bool ok) noexcept
+{
+    if(! ok)
+    {
+        impl_->failed.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    if(SSL_session_reused(ssl))
+    {
+        impl_->resumed.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+    impl_->full.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+tls_stats
+tls_session_cache::
+get_stats() const noexcept
+{
+    tls_stats st;
+    st.full_handshakes = impl_->full.load(std::memory_order_relaxed);
+    st.resumed_handshakes = impl_->resumed.load(std::memory_order_relaxed);
+    st.failed_handshakes = impl_->failed.load(std::memory_order_relaxed);
+    st.cache_hits = impl_->hits.load(std::memory_order_relaxed);
+    st.cache_misses = impl_->misses.load(std::memory_order_relaxed);
+    st.key_rotations = impl_->rotations.load(std::memory_order_relaxed);
+    for(auto& s : impl_->shards)
+    {
+        std::lock_guard<std::mutex> lock(s.m);
+        st.cached_sessions += s.map.size();
+    }
+    return st;
+}
+
+} // detail
+} // beast2
+} // boost
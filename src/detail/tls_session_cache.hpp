@@ -0,0 +1,79 @@
+//
+// Copyright (c) 2026 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/beast2
+//
+
+#ifndef BOOST_BEAST2_SRC_DETAIL_TLS_SESSION_CACHE_HPP
+#define BOOST_BEAST2_SRC_DETAIL_TLS_SESSION_CACHE_HPP
+
+#include <boost/beast2/server_config.hpp>
+#include <memory>
+
+struct ssl_st;
+
+namespace boost {
+namespace beast2 {
+namespace detail {
+
+/** Session resumption state shared by the connections of a server.
+
+    Sessions are kept in a sharded cache outside of
+    OpenSSL, and session tickets are sealed with keys
+    held here, so that a client may resume on any
+    connection whatever OpenSSL context it uses. Ticket
+    keys are replaced every @ref
+    tls_session_config::ticket_rotation; tickets sealed
+    with the previous key are still accepted, and renewed.
+
+    @par Thread Safety
+    Shared objects: Safe.
+*/
+class tls_session_cache
+{
+public:
+    ~tls_session_cache();
+
+    explicit
+    tls_session_cache(tls_session_config const& cfg);
+
+    tls_session_cache(tls_session_cache const&) = delete;
+    tls_session_cache& operator=(tls_session_cache const&) = delete;
+
+    /** Prepare a connection before its handshake.
+
+        The callbacks are installed on the connection's
+        OpenSSL context the first time it is seen. The
+        context is then kept alive by the cache, whose
+        destructor removes the callbacks again.
+    */
+    void
+    prepare(ssl_st* ssl);
+
+    /** Count a finished handshake.
+
+        @return `true` if the session was resumed.
+    */
+    bool
+    on_handshake(
+        ssl_st* ssl,
+        bool ok) noexcept;
+
+    /** Return the counters.
+    */
+    tls_stats
+    get_stats() const noexcept;
+
+private:
+    struct impl;
+    std::unique_ptr<impl> impl_;
+};
+
+} // detail
+} // beast2
+} // boost
+
+#endif
@@ -40,6 +40,7 @@ message(
     switch(static_cast<error>(code))
     {
     case error::success: return "http::error::success";
+    case error::body_length_mismatch: return "http::error::body_length_mismatch";
     default:
         return "http::error::?";
     }
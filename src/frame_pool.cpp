@@ -0,0 +1,138 @@
+//
+// Copyright (c) 2026 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/beast2
+//
+
+#include <boost/beast2/frame_pool.hpp>
+
+namespace boost {
+namespace beast2 {
+
+frame_pool::
+~frame_pool()
+{
+    release();
+}
+
+frame_pool::
+frame_pool(
+    std::size_t max_cached,
+    std::pmr::memory_resource* upstream) noexcept
+    : max_cached_(max_cached)
+    , upstream_(upstream)
+{
+}
+
+frame_pool_stats
+frame_pool::
+get_stats() const noexcept
+{
+    return st_;
+}
+
+void
+frame_pool::
+release() noexcept
+{
+    for(std::size_t i = 0; i < classes; ++i)
+    {
+        auto& fl = lists_[i];
+        auto const size = min_size << i;
+        while(fl.head)
+        {
+            auto* b = fl.head;
+            fl.head = b->next;
+            upstream_->deallocate(b, size, alignof(std::max_align_t));
+        }
+        fl.count = 0;
+    }
+    st_.cached_bytes = 0;
+}
+
+// Index of the smallest class holding `bytes`
+std::size_t
+frame_pool::
+class_of(std::size_t bytes) noexcept
+{
+    std::size_t i = 0;
+    std::size_t size = min_size;
+    while(size < bytes)
+    {
+        size <<= 1;
+        ++i;
+    }
+    return i;
+}
+
+void*
+frame_pool::
+do_allocate(
+    std::size_t bytes,
+    std::size_t alignment)
+{
+    ++st_.allocations;
+    if( bytes > max_size ||
+        alignment > alignof(std::max_align_t))
+    {
+        ++st_.heap_allocations;
+        return upstream_->allocate(bytes, alignment);
+    }
+
+    auto const i = class_of(bytes);
+    auto& fl = lists_[i];
+    if(fl.head)
+    {
+        auto* b = fl.head;
+        fl.head = b->next;
+        --fl.count;
+        st_.cached_bytes -= min_size << i;
+        return b;
+    }
+    ++st_.heap_allocations;
+    return upstream_->allocate(
+        min_size << i, alignof(std::max_align_t));
+}
+
+void
+frame_pool::
+do_deallocate(
+    void* p,
+    std::size_t bytes,
+    std::size_t alignment)
+{
+    if( bytes > max_size ||
+        alignment > alignof(std::max_align_t))
+    {
+        upstream_->deallocate(p, bytes, alignment);
+        return;
+    }
+
+    auto const i = class_of(bytes);
+    auto const size = min_size << i;
+    auto& fl = lists_[i];
+    if(fl.count >= max_cached_)
+    {
+        upstream_->deallocate(p, size, alignof(std::max_align_t));
+        return;
+    }
+    auto* b = static_cast<free_block*>(p);
+    b->next = fl.head;
+    fl.head = b;
+    ++fl.count;
+    st_.cached_bytes += size;
+}
+
+bool
+frame_pool::
+do_is_equal(
+    std::pmr::memory_resource const& other) const noexcept
+{
+    return this == &other;
+}
+
+} // beast2
+} // boost
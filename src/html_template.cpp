@@ -0,0 +1,234 @@
+//
+// Copyright (c) 2026 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/beast2
+//
+
+#include <boost/beast2/html_template.hpp>
+#include <boost/beast2/detail/except.hpp>
+#include "src/detail/string_util.hpp"
+
+namespace boost {
+namespace beast2 {
+
+namespace {
+
+constexpr std::size_t npos = std::size_t(-1);
+
+
+core::string_view
+entity(char c) noexcept
+{
+    switch(c)
+    {
+    case '&':  return "&amp;";
+    case '<':  return "&lt;";
+    case '>':  return "&gt;";
+    case '"':  return "&quot;";
+    case '\'': return "&#39;";
+    default:
+        return {};
+    }
+}
+
+} // (anon)
+
+void
+html_writer::
+append(
+    char const* data,
+    std::size_t size)
+{
+    if(! escape_)
+        return append_(dest_, data, size);
+
+    // write runs of ordinary characters whole
+    char const* const end = data + size;
+    char const* p = data;
+    while(p != end)
+    {
+        auto const e = entity(*p);
+        if(e.empty())
+        {
+            ++p;
+            continue;
+        }
+        if(p != data)
+            append_(dest_, data,
+                static_cast<std::size_t>(p - data));
+        append_(dest_, e.data(), e.size());
+        data = ++p;
+    }
+    if(p != data)
+        append_(dest_, data,
+            static_cast<std::size_t>(p - data));
+}
+
+//------------------------------------------------
+
+html_template::
+html_template(core::string_view text)
+    : text_(text)
+{
+    // open sections, as indexes into ops_
+    std::vector<std::size_t> open;
+
+    auto const get_slot =
+        [&](core::string_view name, bool section)
+        {
+            if(name.empty())
+                detail::throw_invalid_argument(
+                    "html_template: empty slot name");
+            for(std::size_t i = 0; i < names_.size(); ++i)
+            {
+                if(names_[i] != name)
+                    continue;
+                if(is_section_[i] != section)
+                    detail::throw_invalid_argument(
+                        "html_template: slot used as section and value");
+                return static_cast<std::uint32_t>(i);
+            }
+            names_.emplace_back(name);
+            is_section_.push_back(section);
+            return static_cast<std::uint32_t>(names_.size() - 1);
+        };
+
+    core::string_view const s = text_;
+    std::size_t pos = 0;
+    for(;;)
+    {
+        auto const i = s.find("{{", pos);
+        auto const lit_end = i == s.npos ? s.size() : i;
+        if(lit_end > pos)
+            ops_.push_back({ op::literal,
+                static_cast<std::uint32_t>(pos),
+                static_cast<std::uint32_t>(lit_end - pos) });
+        if(i == s.npos)
+            break;
+
+        bool const raw = s.substr(i).starts_with("{{{");
+        core::string_view const close = raw ? "}}}" : "}}";
+        auto const first = i + (raw ? 3 : 2);
+        auto const j = s.find(close, first);
+        if(j == s.npos)
+            detail::throw_invalid_argument(
+                "html_template: unterminated slot");
+        auto tag = detail::trim(s.substr(first, j - first));
+        pos = j + close.size();
+
+        if(raw)
+        {
+            ops_.push_back({ op::raw, get_slot(tag, false), 0 });
+        }
+        else if(tag.starts_with('#'))
+        {
+            tag = detail::trim(tag.substr(1));
+            open.push_back(ops_.size());
+            if(open.size() > depth_)
+                depth_ = open.size();
+            ops_.push_back({ op::section, get_slot(tag, true), 0 });
+        }
+        else if(tag.starts_with('/'))
+        {
+            tag = detail::trim(tag.substr(1));
+            if( open.empty() ||
+                names_[ops_[open.back()].a] != tag)
+                detail::throw_invalid_argument(
+                    "html_template: mismatched section end");
+            ops_[open.back()].b =
+                static_cast<std::uint32_t>(ops_.size());
+            open.pop_back();
+        }
+        else
+        {
+            ops_.push_back({ op::text, get_slot(tag, false), 0 });
+        }
+    }
+    if(! open.empty())
+        detail::throw_invalid_argument(
+            "html_template: unterminated section");
+}
+
+std::size_t
+html_template::
+slot(core::string_view name) const
+{
+    for(std::size_t i = 0; i < names_.size(); ++i)
+        if(names_[i] == name)
+            return i;
+    detail::throw_invalid_argument(
+        "html_template: no such slot");
+}
+
+html_template::
+cursor::
+cursor(html_template const& t)
+{
+    stack.reserve(t.depth_ + 1);
+    stack.push_back({ 0, t.ops_.size(), 0, npos });
+}
+
+bool
+html_template::
+render_some(
+    cursor& c,
+    html_writer& out,
+    void* f,
+    fill_fn fn,
+    body_writer const* w) const
+{
+    auto& stack = c.stack;
+    while(! stack.empty())
+    {
+        if(w && w->full())
+            return false;
+
+        auto& fr = stack.back();
+        if(fr.next == fr.last)
+        {
+            // the end of a row, or of the template
+            if(fr.sec != npos)
+            {
+                out.escape_ = true;
+                if(fn(f, ops_[fr.sec].a, fr.row + 1, out))
+                {
+                    ++fr.row;
+                    fr.next = fr.sec + 1;
+                    continue;
+                }
+            }
+            stack.pop_back();
+            continue;
+        }
+
+        auto const i = fr.next++;
+        auto const& o = ops_[i];
+        switch(o.kind)
+        {
+        case op::literal:
+            out.append_(out.dest_, text_.data() + o.a, o.b);
+            break;
+
+        case op::text:
+        case op::raw:
+            out.escape_ = o.kind == op::text;
+            fn(f, o.a, fr.row, out);
+            break;
+
+        case op::section:
+            // the parent resumes after the section
+            fr.next = o.b;
+            out.escape_ = true;
+            if(fn(f, o.a, 0, out))
+                stack.push_back({ i + 1, o.b, 0, i });
+            break;
+        }
+    }
+    return true;
+}
+
+} // beast2
+} // boost
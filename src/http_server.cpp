@@ -9,13 +9,23 @@
 
 #include <boost/beast2/http_server.hpp>
 #include <boost/beast2/http_worker.hpp>
+#include <boost/beast2/admission_controller.hpp>
+#include <boost/beast2/metrics_service.hpp>
+#include "src/detail/connection_pool.hpp"
+#include "src/detail/drain_state.hpp"
+#include "src/detail/frame_totals.hpp"
+#include "src/detail/linger_close.hpp"
+#include "src/detail/sendfile.hpp"
+#include "src/detail/tap_stream.hpp"
 #include <boost/http/server/flat_router.hpp>
 #include <boost/capy/task.hpp>
 #include <boost/capy/cond.hpp>
+#include <boost/capy/ex/run_async.hpp>
 #include <boost/capy/ex/strand.hpp>
 #include <boost/capy/io/any_read_source.hpp>
 #include <boost/capy/io/any_read_stream.hpp>
 #include <boost/capy/io/any_buffer_sink.hpp>
+#include <boost/capy/write.hpp>
 #include <boost/http/request_parser.hpp>
 #include <boost/http/response.hpp>
 #include <boost/http/server/router.hpp>
@@ -25,67 +35,265 @@
 #include <boost/http/error.hpp>
 #include <boost/url/parse.hpp>
 #include <iostream>
+#include <string>
+#include <vector>
 
 namespace boost {
 namespace beast2 {
 
+namespace {
+
+// Pooled per-connection state. The parser and
+// serializer buffers are the bulk of the memory
+// used by a connection, so they are only allocated
+// while there is a connection to serve.
+struct connection
+    : http_worker
+#ifdef __linux__
+    , file_sender
+#endif
+{
+    corosio::tcp_socket* sock_ = nullptr;
+    detail::tap_stream<corosio::tcp_socket> out;
+
+    using http_worker::http_worker;
+
+    // The server's frame counters, and what this
+    // connection last added to them
+    detail::frame_totals* frame_totals = nullptr;
+    frame_pool_stats frames_reported;
+
+    ~connection()
+    {
+        if(frame_totals)
+            frame_totals->forget(frames_reported);
+    }
+
+    // Wire the parser, serializer and deadline to a socket
+    void
+    attach(
+        corosio::tcp_socket& sock,
+        timer_wheel& w)
+    {
+        out.attach(sock);
+        rp.req_body = capy::any_buffer_source(parser.source_for(sock));
+        rp.res_body = capy::any_buffer_sink(serializer.sink_for(out));
+        stream = capy::any_read_stream(&sock);
+        wheel = &w;
+        deadline.on_expire = [&sock]{ sock.cancel(); };
+        sock_ = &sock;
+        tap = &out;
+        out.trace = tracing() ? &trace : nullptr;
+        out.bytes = metrics ? metrics->response_bytes : counter();
+        out.deadline = { &w, &deadline, timeouts.write };
+#ifdef __linux__
+        sender = this;
+#endif
+    }
+
+#ifdef __linux__
+    // The serializer is bypassed, and the kernel copies
+    // the file straight from the page cache
+    capy::task<system::error_code>
+    send(
+        core::string_view header,
+        int fd,
+        std::uint64_t offset,
+        std::uint64_t size) override
+    {
+        auto ec = co_await detail::sendfile_range(
+            *sock_, header, fd, offset, size, out.deadline);
+        if(ec)
+            co_return ec;
+        mark(trace_point::last_byte);
+        if(metrics)
+            metrics->response_bytes.add(header.size() + size);
+        co_return system::error_code();
+    }
+#endif
+};
+
+// Sent to shed connections. No parser, serializer
+// or route is involved in producing it.
+std::string
+make_shed_response(unsigned retry_after)
+{
+    std::string s =
+        "HTTP/1.1 503 Service Unavailable\r\n"
+        "Retry-After: ";
+    s += std::to_string(retry_after);
+    s += "\r\n"
+        "Content-Length: 0\r\n"
+        "Connection: close\r\n"
+        "\r\n";
+    return s;
+}
+
+} // (anon)
+
 struct http_server::impl
 {
-    http::flat_router router;
+    server_config cfg;
+    router_slot routes;
     http::shared_parser_config parser_cfg;
     http::shared_serializer_config serializer_cfg;
+    corosio::io_context& ctx;
+    detail::drain_state drain;
+    detail::frame_totals frames;
+    std::unique_ptr<server_metrics> metrics;
+    detail::connection_pool<connection> pool;
+    admission_controller admission;
+    std::vector<worker*> slots;
+    std::string const shed_response;
 
-    impl(http::flat_router r)
-        : router(std::move(r))
+    impl(
+        corosio::io_context& ctx_,
+        server_config const& cfg_,
+        shared_router r,
+        http::shared_parser_config pc,
+        http::shared_serializer_config sc)
+        : cfg(cfg_)
+        , routes(std::move(r))
+        , parser_cfg(std::move(pc))
+        , serializer_cfg(std::move(sc))
+        , ctx(ctx_)
+        , drain(ctx_)
+        , metrics(cfg_.metrics
+            ? std::make_unique<server_metrics>()
+            : nullptr)
+        , pool(cfg, [this]
+            {
+                auto c = std::make_unique<connection>(
+                    routes, parser_cfg, serializer_cfg);
+                c->timeouts = cfg.timeouts;
+                c->unread_body_limit = cfg.unread_body_limit;
+                c->closing = &drain.closing();
+                c->tracer = cfg.tracer.get();
+                c->metrics = metrics.get();
+                c->frame_totals = &frames;
+                return c;
+            },
+            &use_timer_wheel(ctx_))
+        , admission(cfg.admission)
+        , shed_response(make_shed_response(
+            cfg.admission.retry_after))
     {
     }
 };
 
-// Each worker owns its own socket and parser/serializer state,
-// allowing concurrent connection handling without synchronization.
+// Each worker is a lightweight slot owning only its
+// socket. Parser/serializer state is borrowed from the
+// pool for the lifetime of a connection.
 struct http_server::
     worker
     : tcp_server::worker_base
-    , http_worker
 {
     corosio::io_context& ctx;
-    capy::strand<corosio::io_context::executor_type> strand;
+    http_server* srv;
+    timer_wheel& wheel;
     corosio::tcp_socket sock;
+    admission_controller::clock_type::time_point accepted;
+    connection* active = nullptr;
 
     worker(
         corosio::io_context& ctx_,
         http_server* srv_)
-        : http_worker(
-            srv_->impl_->router,
-            srv_->impl_->parser_cfg,
-            srv_->impl_->serializer_cfg)
-        , ctx(ctx_)
-        , strand(ctx_.get_executor())
+        : ctx(ctx_)
+        , srv(srv_)
+        , wheel(use_timer_wheel(ctx_))
         , sock(ctx_)
     {
-        sock.open();
-
-        rp.req_body = capy::any_buffer_source(parser.source_for(sock));
-        rp.res_body = capy::any_buffer_sink(serializer.sink_for(sock));
-        stream = capy::any_read_stream(&sock);
     }
 
+    // Opened on first use, so that idle slots
+    // do not hold a descriptor
     corosio::tcp_socket& socket() override
     {
+        if(! sock.is_open())
+            sock.open();
         return sock;
     }
 
     void run(launcher launch) override
     {
+        accepted = admission_controller::clock_type::now();
         launch(ctx.get_executor(), do_session());
     }
 
+    // Marks the worker as serving a connection, and
+    // counts it as open, until the session ends,
+    // however it ends
+    struct active_scope
+    {
+        worker& w;
+
+        active_scope(
+            worker& w_,
+            connection* c)
+            : w(w_)
+        {
+            w.active = c;
+            w.srv->impl_->drain.opened();
+            if(auto const& m = w.srv->impl_->metrics)
+                m->connections_active.add();
+        }
+
+        ~active_scope()
+        {
+            w.active->frame_totals->report(
+                w.active->frames, w.active->frames_reported);
+            if(auto const& m = w.srv->impl_->metrics)
+                m->connections_active.sub();
+            w.srv->impl_->drain.closed();
+            w.active = nullptr;
+        }
+    };
+
     capy::task<void>
     do_session()
     {
-        co_await do_http_session();
+        auto& impl = *srv->impl_;
+        if(impl.metrics)
+            impl.metrics->connections_accepted.add();
+
+        // Accepted while the listener was being closed
+        if(impl.drain.closing().load(std::memory_order_relaxed))
+        {
+            sock.shutdown(corosio::tcp_socket::shutdown_both);
+            co_return;
+        }
 
-        sock.shutdown(corosio::tcp_socket::shutdown_both); // VFALCO too wordy
+        // The time between the accept and the session
+        // starting on the event loop is our queueing delay
+        auto const now = admission_controller::clock_type::now();
+        if(impl.admission.admit(now - accepted, now))
+        {
+            detail::pool_lease<connection> c(impl.pool);
+            if(c)
+            {
+                c->attach(sock, wheel);
+                {
+                    active_scope scope(*this, c.get());
+                    co_await c->do_http_session();
+                }
+                c.release();
+                sock.shutdown(corosio::tcp_socket::shutdown_both); // VFALCO too wordy
+                co_return;
+            }
+            impl.admission.shed();
+        }
+
+        // Shed: answer without parsing the request, then
+        // drain it so that the close does not reset the
+        // connection before the client reads the answer
+        if(impl.metrics)
+            impl.metrics->connections_shed.add();
+        (void)co_await capy::write(sock, capy::const_buffer(
+            impl.shed_response.data(),
+            impl.shed_response.size()));
+        co_await detail::linger_close(
+            sock, wheel, impl.cfg.admission.linger);
+        sock.shutdown(corosio::tcp_socket::shutdown_both);
     }
 };
 
@@ -102,18 +310,121 @@ http_server(
     http::flat_router router,
     http::shared_parser_config parser_cfg,
     http::shared_serializer_config serializer_cfg)
-    : tcp_server(ctx, ctx.get_executor())
-    , impl_(new impl(std::move(router)))
+    : http_server(
+        ctx,
+        detail::fixed_config(num_workers),
+        shared_router(std::move(router)),
+        std::move(parser_cfg),
+        std::move(serializer_cfg))
 {
-    impl_->parser_cfg = std::move(parser_cfg);
-    impl_->serializer_cfg = std::move(serializer_cfg);
+}
 
+http_server::
+http_server(
+    corosio::io_context& ctx,
+    server_config const& cfg,
+    shared_router router,
+    http::shared_parser_config parser_cfg,
+    http::shared_serializer_config serializer_cfg)
+    : tcp_server(ctx, ctx.get_executor())
+    , impl_(new impl(
+        ctx,
+        cfg,
+        std::move(router),
+        std::move(parser_cfg),
+        std::move(serializer_cfg)))
+{
+    auto const n =
+        impl_->pool.config().max_workers +
+        impl_->cfg.admission.shed_workers;
     std::vector<std::unique_ptr<tcp_server::worker_base>> workers;
-    workers.reserve(num_workers);
-    for(std::size_t i = 0; i < num_workers; ++i)
-        workers.push_back(std::make_unique<worker>(ctx, this));
+    workers.reserve(n);
+    impl_->slots.reserve(n);
+    for(std::size_t i = 0; i < n; ++i)
+    {
+        auto w = std::make_unique<worker>(ctx, this);
+        impl_->slots.push_back(w.get());
+        workers.push_back(std::move(w));
+    }
     set_workers(std::move(workers));
 }
 
+pool_stats
+http_server::
+get_pool_stats() const
+{
+    return impl_->pool.get_stats();
+}
+
+admission_stats
+http_server::
+get_admission_stats() const
+{
+    return impl_->admission.get_stats();
+}
+
+connection_stats
+http_server::
+get_connection_stats() const noexcept
+{
+    return impl_->drain.get_stats();
+}
+
+frame_pool_stats
+http_server::
+get_frame_stats() const noexcept
+{
+    return impl_->frames.get();
+}
+
+void
+http_server::
+drain()
+{
+    // tcp_server::stop and the sockets belong to
+    // the thread running the server's event loop
+    capy::run_async(impl_->ctx.get_executor())(
+        [](http_server& srv) -> capy::task<void>
+        {
+            auto& impl = *srv.impl_;
+            if(! impl.drain.start())
+                co_return;
+
+            // Closes the listener. Sessions already running
+            // were launched on the executor and are not owned
+            // by the listener, so they carry on; a connection
+            // which slipped in meanwhile sees the closing flag
+            // and is closed without being served.
+            srv.stop();
+
+            // No request is in flight on an idle
+            // keep-alive connection
+            for(auto* w : impl.slots)
+                if(w->active && w->active->is_idle())
+                    w->sock.cancel();
+
+            if(co_await impl.drain.wait(impl.cfg.drain_timeout))
+                co_return;
+
+            for(auto* w : impl.slots)
+                if(w->active)
+                    w->sock.cancel();
+        }(*this));
+}
+
+void
+http_server::
+replace_router(http::flat_router router)
+{
+    impl_->routes.replace(shared_router(std::move(router)));
+}
+
+void
+http_server::
+replace_router(shared_router router)
+{
+    impl_->routes.replace(std::move(router));
+}
+
 } // beast2
 } // boost
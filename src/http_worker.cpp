@@ -8,16 +8,75 @@
 //
 
 #include <boost/beast2/http_worker.hpp>
+#include <boost/capy/buffers.hpp>
+#include <boost/capy/ex/frame_allocator.hpp>
+#include <boost/capy/read.hpp>
 #include <boost/http/error.hpp>
 #include <boost/url/parse.hpp>
+#include <algorithm>
 #include <iostream>
+#include <memory_resource>
 
 namespace boost {
 namespace beast2 {
 
+namespace {
+
+// Reads through to another stream. The first byte
+// of each request ends the wait for it, and is
+// stamped in the trace when there is one.
+struct request_stream
+{
+    capy::any_read_stream* next;
+    bool* idle;
+    request_trace* trace;
+
+    template<class MutableBufferSequence>
+    capy::task<capy::io_result<std::size_t>>
+    read_some(MutableBufferSequence const& buffers)
+    {
+        auto [ec, n] = co_await next->read_some(buffers);
+        if(n > 0)
+        {
+            *idle = false;
+#ifndef BOOST_BEAST2_NO_REQUEST_TRACE
+            if(trace && ! trace->has(trace_point::first_byte))
+                trace->mark(trace_point::first_byte);
+#endif
+        }
+        co_return {ec, n};
+    }
+};
+
+// Makes a frame allocator current for the lifetime
+// of the scope, and restores the previous one after
+class frame_allocator_scope
+{
+    decltype(capy::get_current_frame_allocator()) prev_;
+
+public:
+    explicit
+    frame_allocator_scope(
+        std::pmr::memory_resource* mr) noexcept
+        : prev_(capy::get_current_frame_allocator())
+    {
+        capy::set_current_frame_allocator(mr);
+    }
+
+    frame_allocator_scope(frame_allocator_scope const&) = delete;
+    frame_allocator_scope& operator=(frame_allocator_scope const&) = delete;
+
+    ~frame_allocator_scope()
+    {
+        capy::set_current_frame_allocator(prev_);
+    }
+};
+
+} // (anon)
+
 http_worker::
 http_worker(
-    http::flat_router fr_,
+    shared_router fr_,
     http::shared_parser_config parser_cfg,
     http::shared_serializer_config serializer_cfg)
     : fr(std::move(fr_))
@@ -27,6 +86,112 @@ http_worker(
     serializer.set_message(rp.res);
 }
 
+http_worker::
+http_worker(
+    http::flat_router fr_,
+    http::shared_parser_config parser_cfg,
+    http::shared_serializer_config serializer_cfg)
+    : http_worker(
+        shared_router(std::move(fr_)),
+        std::move(parser_cfg),
+        std::move(serializer_cfg))
+{
+}
+
+http_worker::
+http_worker(
+    router_slot const& slot,
+    http::shared_parser_config parser_cfg,
+    http::shared_serializer_config serializer_cfg)
+    : http_worker(
+        shared_router(),
+        std::move(parser_cfg),
+        std::move(serializer_cfg))
+{
+    slot_ = &slot;
+    slot_->update(fr, version_);
+}
+
+// Re-arm the deadline, or disarm it for zero
+void
+http_worker::
+set_deadline(timer_wheel::duration d) noexcept
+{
+    if(! wheel)
+        return;
+    if(d == timer_wheel::duration::zero())
+        wheel->cancel(deadline);
+    else
+        wheel->arm(deadline, d);
+}
+
+// Defined here rather than in the header, so that the
+// choice of BOOST_BEAST2_NO_REQUEST_TRACE is made once,
+// when the library is compiled. Calls from this file
+// still inline, and compile out when tracing is off.
+bool
+http_worker::
+tracing() const noexcept
+{
+#ifndef BOOST_BEAST2_NO_REQUEST_TRACE
+    return tracer != nullptr;
+#else
+    return false;
+#endif
+}
+
+void
+http_worker::
+mark(trace_point p) noexcept
+{
+    if(tracing())
+        trace.mark(p);
+}
+
+bool
+http_worker::
+is_closing() const noexcept
+{
+    return closing &&
+        closing->load(std::memory_order_relaxed);
+}
+
+void
+http_worker::
+record_metrics(
+    std::chrono::steady_clock::time_point started) noexcept
+{
+    auto const us = std::chrono::duration_cast<
+        std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - started).count();
+    metrics->on_response(rp.res.status_int());
+    (slots_.latency ? *slots_.latency : metrics->latency).observe(
+        static_cast<std::uint64_t>(us));
+}
+
+// Read and throw away what a handler left of the
+// request body, so that the next request can be found.
+// Returns false if more than the limit remains.
+capy::task<bool>
+http_worker::
+discard_body()
+{
+    set_deadline(timeouts.body);
+    std::size_t left = unread_body_limit;
+    char buf[2048];
+    while(! parser.is_complete())
+    {
+        if(left == 0)
+            co_return false;
+        auto [ec, n] = co_await capy::read(rp.req_body,
+            capy::mutable_buffer(buf, (std::min)(left, sizeof(buf))));
+        left -= n;
+        if(ec && ! parser.is_complete())
+            co_return false;
+    }
+    co_return true;
+}
+
 capy::task<void>
 http_worker::
 do_http_session()
@@ -42,36 +207,90 @@ do_http_session()
 
         ~guard()
         {
+            self.set_deadline(timer_wheel::duration::zero());
+            self.idle_ = false;
+            if(self.tap)
+                self.tap->discard();
             self.parser.reset();
             self.parser.start();
             self.rp.session_data.clear();
+            self.rp.route_data.clear();
+            self.arena.reset();
+            self.trace = {};
         }
     };
 
     guard g(*this); // clear things when session ends
 
+    // Discard state left over from the previous
+    // connection. Within a session the parser is only
+    // restarted, which keeps any bytes read past the
+    // end of the current request: pipelined requests
+    // are then parsed straight from the buffer, in
+    // order, without waiting on another read.
+    parser.reset();
+
+    // Headers are read through a stream which notes
+    // the first byte of each request
+    request_stream rs{ &stream, &idle_,
+        tracing() ? &trace : nullptr };
+    capy::any_read_stream in(&rs);
+    if(tracing() && ! trace.has(trace_point::accept))
+        trace.mark(trace_point::accept);
+
     // read request, send response loop
-    for(;;)
+    for(bool first = true;; first = false)
     {
-        parser.reset();
         parser.start();
+
+        // Objects left by the previous request may
+        // live in the arena, so they are destroyed
+        // before it is rewound
         rp.session_data.clear();
+        rp.route_data.clear();
+        arena.reset();
+        if(tracing())
+        {
+            auto const accepted = trace[trace_point::accept];
+            trace = {};
+            trace[trace_point::accept] = accepted;
+        }
+
+        // A slow or idle client must deliver the
+        // complete header before the deadline
+        set_deadline(first ? timeouts.header : timeouts.idle);
 
-        // Read HTTP request header
-        auto [ec] = co_await parser.read_header(stream);
+        // Read HTTP request header. The session is idle
+        // until a byte of the request arrives.
+        idle_ = true;
+        auto [ec] = co_await parser.read_header(in);
+        idle_ = false;
         if(ec)
         {
             std::cerr << "read_header error: " << ec.message() << "\n";
             break;
         }
+        mark(trace_point::header_parsed);
+
+        // Latency is measured from the parsed header
+        std::chrono::steady_clock::time_point started;
+        if(metrics)
+            started = std::chrono::steady_clock::now();
+
+        // A pipelined request was already buffered
+        if(tracing() && ! trace.has(trace_point::first_byte))
+            trace[trace_point::first_byte] =
+                trace[trace_point::header_parsed];
 
         // Process headers and dispatch
         // Set up Request and Response objects
         rp.req = parser.get();
-        rp.route_data.clear();
+        slots_ = { &arena, sender, tap, nullptr };
+        rp.route_data.emplace<detail::request_slots*>(&slots_);
         rp.res.set_start_line(
             http::status::ok, rp.req.version());
-        rp.res.set_keep_alive(rp.req.keep_alive());
+        rp.res.set_keep_alive(
+            rp.req.keep_alive() && ! is_closing());
         serializer.reset();
 
         // Parse the URL
@@ -83,9 +302,45 @@ do_http_session()
             }
             rp.url = rv.value();
         }
+        mark(trace_point::url_parsed);
+
+        // Pick up a replaced routing table. Requests
+        // already dispatched keep the table they hold.
+        if(slot_)
+            slot_->update(fr, version_);
+
+        // The handler must read the body and begin the
+        // response in time. From then on the deadline is
+        // pushed back by every write, so a large response
+        // is only cut off when it stops making progress.
+        set_deadline(timeouts.body);
 
         {
-            auto rv = co_await fr.dispatch(rp.req.method(), rp.url, rp);
+            // The frame of the dispatch comes from this
+            // worker's free lists, and the handlers it
+            // awaits inherit the allocator from it. The
+            // pool is current only while the frame is
+            // created: once the dispatch suspends, the
+            // thread goes on to run other connections.
+            auto task = [&]
+            {
+                frame_allocator_scope fa(&frames);
+                return fr->dispatch(rp.req.method(), rp.url, rp);
+            }();
+            mark(trace_point::dispatch_begin);
+            auto rv = co_await std::move(task);
+            mark(trace_point::dispatch_end);
+            if(tap)
+            {
+                if(rv.failed())
+                    tap->discard();
+                else
+                    tap->complete();
+            }
+            if(tracing())
+                tracer->on_request(trace, rp);
+            if(metrics)
+                record_metrics(started);
             if(rv.failed())
             {
                 // VFALCO log rv.error()
@@ -94,6 +349,20 @@ do_http_session()
 
             if(! rp.res.keep_alive())
                 break;
+
+            // Closing began while the response was
+            // being written with keep-alive
+            if(is_closing())
+                break;
+
+            // The handler left part of the request body
+            // unread. The response promised keep-alive,
+            // so a bounded remainder is discarded to find
+            // the next request; past that, the connection
+            // is closed.
+            if(! parser.is_complete() &&
+                ! co_await discard_body())
+                break;
         }
     }
 }
@@ -9,10 +9,26 @@
 
 #include <boost/beast2/https_server.hpp>
 #include <boost/beast2/http_worker.hpp>
+#include <boost/beast2/admission_controller.hpp>
+#include <boost/beast2/metrics_service.hpp>
+#include "src/detail/connection_pool.hpp"
+#include "src/detail/drain_state.hpp"
+#include "src/detail/frame_totals.hpp"
+#include "src/detail/home_stream.hpp"
+#include "src/detail/linger_close.hpp"
+#include "src/detail/ktls.hpp"
+#include "src/detail/sendfile.hpp"
+#include "src/detail/stream_ref.hpp"
+#include "src/detail/tap_stream.hpp"
+#include "src/detail/tls_reuse.hpp"
+#include "src/detail/tls_session_cache.hpp"
 #include <boost/http/server/flat_router.hpp>
 #include <boost/capy/task.hpp>
 #include <boost/capy/cond.hpp>
+#include <boost/capy/ex/run.hpp>
+#include <boost/capy/ex/run_async.hpp>
 #include <boost/capy/ex/strand.hpp>
+#include <boost/capy/ex/thread_pool.hpp>
 #include <boost/capy/io/any_read_source.hpp>
 #include <boost/capy/io/any_read_stream.hpp>
 #include <boost/capy/io/any_buffer_sink.hpp>
@@ -25,98 +41,439 @@
 #include <boost/http/server/basic_router.hpp>
 #include <boost/http/error.hpp>
 #include <boost/url/parse.hpp>
+#include <openssl/ssl.h>
 #include <iostream>
 #include <memory>
+#include <optional>
+#include <vector>
 
 namespace boost {
 namespace beast2 {
 
+namespace {
+
+// Pooled per-connection state: the parser and serializer
+// buffers are only allocated while there is a connection
+// to serve. The TLS stream and its SSL object are kept
+// too: the stream is built over an indirection which is
+// pointed at each connection's socket in turn, and the
+// SSL object is cleared between connections.
+//
+// Every connection uses the server's one TLS context,
+// so that sessions established on one connection can
+// be resumed on any other.
+struct connection
+    : http_worker
+#ifdef __linux__
+    , file_sender
+#endif
+{
+    corosio::tls_context& tls_ctx;
+    detail::tls_session_cache& sessions;
+    detail::ktls_offload* ktls = nullptr;
+    detail::ktls_state ktls_st;
+    capy::thread_pool* handshake_pool = nullptr;
+
+    // The socket as seen by the TLS stream: through
+    // `home` for a handshake on the pool, else `ref`
+    using home_socket = detail::home_stream<
+        corosio::tcp_socket, corosio::io_context::executor_type>;
+    std::optional<home_socket> home;
+    detail::stream_ref<corosio::tcp_socket> ref;
+
+    // Built on the first connection, and built again
+    // only after one which could not be ended cleanly
+    std::optional<corosio::openssl_stream> ssl;
+    bool release_buffers = false;
+    detail::tap_stream<corosio::openssl_stream> out;
+
+    // Used instead of the TLS stream when the
+    // kernel encrypts the records
+    corosio::tcp_socket* sock_ = nullptr;
+    detail::tap_stream<corosio::tcp_socket> plain_out;
+
+    // The server's frame counters, and what this
+    // connection last added to them
+    detail::frame_totals* frame_totals = nullptr;
+    frame_pool_stats frames_reported;
+
+    ~connection()
+    {
+        if(frame_totals)
+            frame_totals->forget(frames_reported);
+    }
+
+    connection(
+        corosio::tls_context& tc,
+        detail::tls_session_cache& sc,
+        router_slot const& routes,
+        http::shared_parser_config const& parser_cfg,
+        http::shared_serializer_config const& serializer_cfg)
+        : http_worker(routes, parser_cfg, serializer_cfg)
+        , tls_ctx(tc)
+        , sessions(sc)
+    {
+    }
+
+    void
+    count_handshake(bool ok) noexcept
+    {
+        bool const resumed =
+            sessions.on_handshake(ssl->native_handle(), ok);
+        if(metrics)
+            metrics->tls_handshakes[
+                ! ok ? 2 : resumed ? 1 : 0].add();
+    }
+
+    capy::task<system::error_code>
+    handshake()
+    {
+        auto [ec] = co_await ssl->handshake(corosio::tls_stream::server);
+        co_return ec;
+    }
+
+    // Wire the serializer to a stream
+    template<class Stream>
+    void
+    attach_output(
+        detail::tap_stream<Stream>& t,
+        Stream& s)
+    {
+        t.attach(s);
+        tap = &t;
+        t.trace = tracing() ? &trace : nullptr;
+        t.bytes = metrics ? metrics->response_bytes : counter();
+        t.deadline = { wheel, &deadline, timeouts.write };
+        rp.res_body = capy::any_buffer_sink(serializer.sink_for(t));
+    }
+
+    // Wire the parser to a stream
+    template<class Stream>
+    void
+    attach_input(Stream& s)
+    {
+        rp.req_body = capy::any_buffer_source(parser.source_for(s));
+        stream = capy::any_read_stream(&s);
+    }
+
+    capy::task<void>
+    do_session(
+        corosio::tcp_socket& sock,
+        timer_wheel& w,
+        corosio::io_context::executor_type ex)
+    {
+        // The handshake counts as waiting for the request
+        mark(trace_point::accept);
+
+        // Bound the handshake by the header deadline
+        wheel = &w;
+        deadline.on_expire = [this, &sock]
+            {
+                if(home)
+                    home->expired = true;
+                sock.cancel();
+            };
+        if(timeouts.header != timer_wheel::duration::zero())
+            w.arm(deadline, timeouts.header);
+
+        // Point the TLS stream at this socket. With a
+        // pool, the socket is reached through a stream
+        // which performs each operation on this executor.
+        if(! handshake_pool)
+            ref.rebind(sock);
+        else if(home)
+            home->rebind(sock);
+        else
+            home.emplace(sock, ex);
+        if(! ssl)
+        {
+            if(handshake_pool)
+                ssl.emplace(&*home, tls_ctx);
+            else
+                ssl.emplace(&ref, tls_ctx);
+        }
+        sessions.prepare(ssl->native_handle());
+        if(release_buffers)
+            SSL_set_mode(ssl->native_handle(),
+                SSL_MODE_RELEASE_BUFFERS);
+        if(ktls)
+            ktls->prepare(ssl->native_handle(), ktls_st);
+
+        // Perform TLS handshake as server. On a pool, the
+        // public-key operations do not hold up the other
+        // connections of this event loop, while reads and
+        // writes still happen here.
+        system::error_code hs_ec;
+        if(handshake_pool)
+        {
+            home->away = true;
+            hs_ec = co_await capy::run(
+                handshake_pool->get_executor())(handshake());
+            home->away = false;
+        }
+        else
+        {
+            hs_ec = co_await handshake();
+        }
+        count_handshake(! hs_ec);
+        if(hs_ec)
+        {
+            std::cerr << "TLS handshake error: " << hs_ec.message() << "\n";
+            w.cancel(deadline);
+            ssl.reset();
+            co_return;
+        }
+
+        // Once the kernel encrypts, the socket is written
+        // as plain TCP and file bodies can use sendfile
+        auto const mode = ktls
+            ? ktls->enable(ssl->native_handle(),
+                ktls_st, sock.native_handle())
+            : detail::ktls_mode::none;
+        if(mode == detail::ktls_mode::failed)
+        {
+            w.cancel(deadline);
+            ssl.reset();
+            co_return;
+        }
+        if(mode == detail::ktls_mode::none)
+        {
+            attach_output(out, *ssl);
+            attach_input(*ssl);
+        }
+        else
+        {
+            attach_output(plain_out, sock);
+            attach_input(sock);
+#ifdef __linux__
+            sock_ = &sock;
+            sender = this;
+#endif
+        }
+
+        // Process HTTP requests over TLS
+        co_await do_http_session();
+
+        // Perform TLS shutdown
+        bool reusable = true;
+        if(mode == detail::ktls_mode::none)
+        {
+            if(timeouts.write != timer_wheel::duration::zero())
+                w.arm(deadline, timeouts.write);
+            auto [shut_ec] = co_await ssl->shutdown();
+            w.cancel(deadline);
+            if(shut_ec)
+            {
+                // TLS shutdown errors are common (peer may close
+                // abruptly), and leave the stream in an unknown state
+                reusable = false;
+            }
+        }
+        else
+        {
+            detail::ktls_offload::close(
+                ssl->native_handle(), sock.native_handle());
+        }
+
+        // Ready the TLS stream for the next connection
+        // before TCP shutdown, or free it
+        tap = nullptr;
+        sender = nullptr;
+        sock_ = nullptr;
+        if(! reusable || ! detail::reuse_tls(ssl->native_handle()))
+            ssl.reset();
+    }
+
+#ifdef __linux__
+    // The kernel encrypts the file as it sends it
+    capy::task<system::error_code>
+    send(
+        core::string_view header,
+        int fd,
+        std::uint64_t offset,
+        std::uint64_t size) override
+    {
+        auto ec = co_await detail::sendfile_range(
+            *sock_, header, fd, offset, size,
+            plain_out.deadline);
+        if(ec)
+            co_return ec;
+        mark(trace_point::last_byte);
+        if(metrics)
+            metrics->response_bytes.add(header.size() + size);
+        co_return system::error_code();
+    }
+#endif
+};
+
+} // (anon)
+
 struct https_server::impl
 {
+    server_config cfg;
     corosio::tls_context tls_ctx;
-    http::flat_router router;
+    detail::tls_session_cache sessions;
+    std::unique_ptr<detail::ktls_offload> ktls;
+    router_slot routes;
     http::shared_parser_config parser_cfg;
     http::shared_serializer_config serializer_cfg;
+    corosio::io_context& ctx;
+    detail::drain_state drain;
+    detail::frame_totals frames;
+    std::unique_ptr<server_metrics> metrics;
+    detail::connection_pool<connection> pool;
+    admission_controller admission;
+    std::vector<worker*> slots;
 
     impl(
+        corosio::io_context& ctx_,
+        server_config const& cfg_,
         corosio::tls_context tc,
-        http::flat_router r)
-        : tls_ctx(std::move(tc))
-        , router(std::move(r))
+        shared_router r,
+        http::shared_parser_config pc,
+        http::shared_serializer_config sc)
+        : cfg(cfg_)
+        , tls_ctx(std::move(tc))
+        , sessions(cfg_.tls)
+        , ktls(cfg_.ktls
+            ? std::make_unique<detail::ktls_offload>()
+            : nullptr)
+        , routes(std::move(r))
+        , parser_cfg(std::move(pc))
+        , serializer_cfg(std::move(sc))
+        , ctx(ctx_)
+        , drain(ctx_)
+        , metrics(cfg_.metrics
+            ? std::make_unique<server_metrics>()
+            : nullptr)
+        , pool(cfg, [this]
+            {
+                auto c = std::make_unique<connection>(
+                    tls_ctx, sessions, routes,
+                    parser_cfg, serializer_cfg);
+                c->timeouts = cfg.timeouts;
+                c->unread_body_limit = cfg.unread_body_limit;
+                c->closing = &drain.closing();
+                c->tracer = cfg.tracer.get();
+                c->metrics = metrics.get();
+                c->frame_totals = &frames;
+                c->ktls = ktls.get();
+                c->handshake_pool = cfg.handshake_pool.get();
+                c->release_buffers = cfg.tls_release_buffers;
+                return c;
+            },
+            &use_timer_wheel(ctx_))
+        , admission(cfg.admission)
     {
     }
 };
 
+// Each worker is a lightweight slot owning only its
+// socket. TLS and HTTP state is borrowed from the pool
+// for the lifetime of a connection.
 struct https_server::
     worker
     : tcp_server::worker_base
-    , http_worker
 {
     corosio::io_context& ctx;
-    capy::strand<corosio::io_context::executor_type> strand;
+    https_server* srv;
+    timer_wheel& wheel;
     corosio::tcp_socket sock;
-    corosio::tls_context tls_ctx;
-    std::unique_ptr<corosio::openssl_stream> ssl;
+    admission_controller::clock_type::time_point accepted;
+    connection* active = nullptr;
 
     worker(
         corosio::io_context& ctx_,
         https_server* srv_)
-        : http_worker(
-            srv_->impl_->router,
-            srv_->impl_->parser_cfg,
-            srv_->impl_->serializer_cfg)
-        , ctx(ctx_)
-        , strand(ctx_.get_executor())
+        : ctx(ctx_)
+        , srv(srv_)
+        , wheel(use_timer_wheel(ctx_))
         , sock(ctx_)
-        , tls_ctx(srv_->impl_->tls_ctx)
     {
-        sock.open();
     }
 
+    // Opened on first use, so that idle slots
+    // do not hold a descriptor
     corosio::tcp_socket& socket() override
     {
+        if(! sock.is_open())
+            sock.open();
         return sock;
     }
 
     void run(launcher launch) override
     {
+        accepted = admission_controller::clock_type::now();
         launch(ctx.get_executor(), do_session());
     }
 
+    // Marks the worker as serving a connection, and
+    // counts it as open, until the session ends,
+    // however it ends
+    struct active_scope
+    {
+        worker& w;
+
+        active_scope(
+            worker& w_,
+            connection* c)
+            : w(w_)
+        {
+            w.active = c;
+            w.srv->impl_->drain.opened();
+            if(auto const& m = w.srv->impl_->metrics)
+                m->connections_active.add();
+        }
+
+        ~active_scope()
+        {
+            w.active->frame_totals->report(
+                w.active->frames, w.active->frames_reported);
+            if(auto const& m = w.srv->impl_->metrics)
+                m->connections_active.sub();
+            w.srv->impl_->drain.closed();
+            w.active = nullptr;
+        }
+    };
+
     capy::task<void>
     do_session()
     {
-        // Create TLS stream wrapping the socket
-        ssl = std::make_unique<corosio::openssl_stream>(&sock, tls_ctx);
+        auto& impl = *srv->impl_;
+        if(impl.metrics)
+            impl.metrics->connections_accepted.add();
 
-        // Perform TLS handshake as server
-        auto [hs_ec] = co_await ssl->handshake(corosio::tls_stream::server);
-        if(hs_ec)
+        // Accepted while the listener was being closed
+        if(impl.drain.closing().load(std::memory_order_relaxed))
         {
-            std::cerr << "TLS handshake error: " << hs_ec.message() << "\n";
             sock.shutdown(corosio::tcp_socket::shutdown_both);
-            ssl.reset();
             co_return;
         }
 
-        // Wire parser and serializer to the TLS stream
-        rp.req_body = capy::any_buffer_source(parser.source_for(*ssl));
-        rp.res_body = capy::any_buffer_sink(serializer.sink_for(*ssl));
-        stream = capy::any_read_stream(ssl.get());
-
-        // Process HTTP requests over TLS
-        co_await do_http_session();
-
-        // Perform TLS shutdown
-        auto [shut_ec] = co_await ssl->shutdown();
-        if(shut_ec)
+        // A shed connection is closed before the handshake,
+        // which is the expensive part of a TLS connection
+        auto const now = admission_controller::clock_type::now();
+        if(impl.admission.admit(now - accepted, now))
         {
-            // TLS shutdown errors are common (peer may close abruptly)
+            detail::pool_lease<connection> c(impl.pool);
+            if(c)
+            {
+                {
+                    active_scope scope(*this, c.get());
+                    co_await c->do_session(
+                        sock, wheel, ctx.get_executor());
+                }
+                c.release();
+                sock.shutdown(corosio::tcp_socket::shutdown_both);
+                co_return;
+            }
+            impl.admission.shed();
         }
 
-        // Clean up TLS stream before TCP shutdown
-        ssl.reset();
-
+        if(impl.metrics)
+            impl.metrics->connections_shed.add();
+        co_await detail::linger_close(
+            sock, wheel, impl.cfg.admission.linger);
         sock.shutdown(corosio::tcp_socket::shutdown_both);
     }
 };
@@ -135,18 +492,134 @@ https_server(
     http::flat_router router,
     http::shared_parser_config parser_cfg,
     http::shared_serializer_config serializer_cfg)
-    : tcp_server(ctx, ctx.get_executor())
-    , impl_(new impl(std::move(tls_ctx), std::move(router)))
+    : https_server(
+        ctx,
+        detail::fixed_config(num_workers),
+        std::move(tls_ctx),
+        shared_router(std::move(router)),
+        std::move(parser_cfg),
+        std::move(serializer_cfg))
 {
-    impl_->parser_cfg = std::move(parser_cfg);
-    impl_->serializer_cfg = std::move(serializer_cfg);
+}
 
+https_server::
+https_server(
+    corosio::io_context& ctx,
+    server_config const& cfg,
+    corosio::tls_context tls_ctx,
+    shared_router router,
+    http::shared_parser_config parser_cfg,
+    http::shared_serializer_config serializer_cfg)
+    : tcp_server(ctx, ctx.get_executor())
+    , impl_(new impl(
+        ctx,
+        cfg,
+        std::move(tls_ctx),
+        std::move(router),
+        std::move(parser_cfg),
+        std::move(serializer_cfg)))
+{
+    auto const n =
+        impl_->pool.config().max_workers +
+        impl_->cfg.admission.shed_workers;
     std::vector<std::unique_ptr<tcp_server::worker_base>> workers;
-    workers.reserve(num_workers);
-    for(std::size_t i = 0; i < num_workers; ++i)
-        workers.push_back(std::make_unique<worker>(ctx, this));
+    workers.reserve(n);
+    impl_->slots.reserve(n);
+    for(std::size_t i = 0; i < n; ++i)
+    {
+        auto w = std::make_unique<worker>(ctx, this);
+        impl_->slots.push_back(w.get());
+        workers.push_back(std::move(w));
+    }
     set_workers(std::move(workers));
 }
 
+pool_stats
+https_server::
+get_pool_stats() const
+{
+    return impl_->pool.get_stats();
+}
+
+admission_stats
+https_server::
+get_admission_stats() const
+{
+    return impl_->admission.get_stats();
+}
+
+connection_stats
+https_server::
+get_connection_stats() const noexcept
+{
+    return impl_->drain.get_stats();
+}
+
+frame_pool_stats
+https_server::
+get_frame_stats() const noexcept
+{
+    return impl_->frames.get();
+}
+
+tls_stats
+https_server::
+get_tls_stats() const
+{
+    auto st = impl_->sessions.get_stats();
+    if(impl_->ktls)
+        st.ktls_connections = impl_->ktls->offloaded();
+    return st;
+}
+
+void
+https_server::
+drain()
+{
+    // tcp_server::stop and the sockets belong to
+    // the thread running the server's event loop
+    capy::run_async(impl_->ctx.get_executor())(
+        [](https_server& srv) -> capy::task<void>
+        {
+            auto& impl = *srv.impl_;
+            if(! impl.drain.start())
+                co_return;
+
+            // Closes the listener. Sessions already running
+            // were launched on the executor and are not owned
+            // by the listener, so they carry on; a connection
+            // which slipped in meanwhile sees the closing flag
+            // and is closed without being served.
+            srv.stop();
+
+            // No request is in flight on an idle
+            // keep-alive connection
+            for(auto* w : impl.slots)
+                if(w->active && w->active->is_idle())
+                    w->sock.cancel();
+
+            if(co_await impl.drain.wait(impl.cfg.drain_timeout))
+                co_return;
+
+            for(auto* w : impl.slots)
+                if(w->active)
+                    w->sock.cancel();
+        }(*this));
+}
+
+void
+https_server::
+replace_router(http::flat_router router)
+{
+    impl_->routes.replace(shared_router(std::move(router)));
+}
+
+void
+https_server::
+replace_router(shared_router router)
+{
+    impl_->routes.replace(std::move(router));
+}
+
 } // beast2
 } // boost
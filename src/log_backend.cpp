@@ -0,0 +1,469 @@
+//
+// Copyright (c) 2026 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/beast2
+//
+
+#include <boost/beast2/log_backend.hpp>
+#include <boost/system/system_error.hpp>
+#include <boost/throw_exception.hpp>
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <new>
+#include <string>
+#include <thread>
+
+#ifdef _WIN32
+# include <fcntl.h>
+# include <io.h>
+#else
+# include <fcntl.h>
+# include <unistd.h>
+#endif
+
+#ifdef __linux__
+# include <sys/mman.h>
+#endif
+
+namespace boost {
+namespace beast2 {
+
+namespace {
+
+[[noreturn]]
+void
+throw_errno(char const* what)
+{
+    throw_exception(system::system_error(
+        system::error_code(errno, system::system_category()),
+        what));
+}
+
+} // (anon)
+
+fd_log_sink::
+~fd_log_sink()
+{
+    if(! owned_)
+        return;
+#ifdef _WIN32
+    ::_close(fd_);
+#else
+    ::close(fd_);
+#endif
+}
+
+fd_log_sink::
+fd_log_sink(
+    int fd,
+    bool owned) noexcept
+    : fd_(fd)
+    , owned_(owned)
+{
+}
+
+std::shared_ptr<fd_log_sink>
+fd_log_sink::
+stderr_sink()
+{
+    return std::make_shared<fd_log_sink>(2);
+}
+
+std::shared_ptr<fd_log_sink>
+fd_log_sink::
+open(core::string_view path)
+{
+    std::string const s(path);
+#ifdef _WIN32
+    int const fd = ::_open(s.c_str(),
+        _O_WRONLY | _O_CREAT | _O_APPEND | _O_BINARY, 0644);
+#else
+    int const fd = ::open(s.c_str(),
+        O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+#endif
+    if(fd < 0)
+        throw_errno("fd_log_sink::open");
+    return std::make_shared<fd_log_sink>(fd, true);
+}
+
+#ifdef __linux__
+std::shared_ptr<fd_log_sink>
+fd_log_sink::
+memfd(core::string_view name)
+{
+    std::string const s(name);
+    int const fd = ::memfd_create(s.c_str(), MFD_CLOEXEC);
+    if(fd < 0)
+        throw_errno("fd_log_sink::memfd");
+    return std::make_shared<fd_log_sink>(fd, true);
+}
+#endif
+
+void
+fd_log_sink::
+write(
+    char const* data,
+    std::size_t size)
+{
+    while(size > 0)
+    {
+#ifdef _WIN32
+        auto const n = ::_write(fd_, data,
+            static_cast<unsigned>(size));
+#else
+        auto const n = ::write(fd_, data, size);
+#endif
+        if(n < 0)
+        {
+            if(errno == EINTR)
+                continue;
+            // nowhere to report it
+            return;
+        }
+        data += n;
+        size -= static_cast<std::size_t>(n);
+    }
+}
+
+//------------------------------------------------
+
+struct log_backend::impl
+{
+    // Records up to this size are copied into the slot
+    static constexpr std::size_t inline_size = 216;
+
+    // Records are handed to the sink in batches of
+    // about this size
+    static constexpr std::size_t batch_size = 64 * 1024;
+
+    struct alignas(64) slot
+    {
+        std::atomic<std::size_t> seq;
+        std::size_t size;
+        char* heap;
+        log_decoder decode;
+        char data[inline_size];
+    };
+
+    std::unique_ptr<slot[]> ring;
+    std::size_t const mask;
+
+    alignas(64) std::atomic<std::size_t> tail{0};
+    alignas(64) std::atomic<std::size_t> done{0};
+
+    // Written by the logging thread only when it goes to
+    // sleep or wakes, so while it is busy producers only
+    // read this line
+    alignas(64) std::atomic<bool> sleeping{false};
+    std::atomic<std::uint32_t> wake{0};
+    std::atomic<bool> stop{false};
+    std::atomic<log_overflow> policy{log_overflow::drop};
+
+    std::atomic<std::uint64_t> written{0};
+    std::atomic<std::uint64_t> dropped{0};
+    std::atomic<std::uint64_t> blocked{0};
+    std::atomic<std::uint64_t> batches{0};
+
+    std::mutex sink_m;
+    std::shared_ptr<log_sink> sink;
+
+    std::thread t;
+
+    static
+    std::size_t
+    round_up(std::size_t n) noexcept
+    {
+        std::size_t r = 2;
+        while(r < n)
+            r <<= 1;
+        return r;
+    }
+
+    impl(
+        std::size_t capacity,
+        std::shared_ptr<log_sink> sink_)
+        : ring(new slot[round_up(capacity)])
+        , mask(round_up(capacity) - 1)
+        , sink(sink_ ? std::move(sink_) :
+            fd_log_sink::stderr_sink())
+    {
+        for(std::size_t i = 0; i <= mask; ++i)
+        {
+            ring[i].seq.store(i, std::memory_order_relaxed);
+            ring[i].heap = nullptr;
+        }
+        t = std::thread([this]{ run(); });
+    }
+
+    ~impl()
+    {
+        stop.store(true);
+        notify();
+        t.join();
+    }
+
+    // Wake the logging thread
+    void
+    notify() noexcept
+    {
+        wake.fetch_add(1);
+        wake.notify_one();
+    }
+
+    // Wake the logging thread if it sleeps. The caller
+    // has just published a record with a sequentially
+    // consistent store; the thread stores `sleeping`
+    // before looking at the ring one last time, so
+    // either it sees the record or this sees it asleep.
+    void
+    signal() noexcept
+    {
+        if(sleeping.load())
+            notify();
+    }
+
+    bool
+    push(
+        core::string_view rec,
+        log_decoder decode) noexcept
+    {
+        char* heap = nullptr;
+        if(rec.size() > inline_size)
+        {
+            heap = new(std::nothrow) char[rec.size()];
+            if(! heap)
+            {
+                dropped.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+            std::memcpy(heap, rec.data(), rec.size());
+        }
+
+        // Claim a slot
+        bool waited = false;
+        auto pos = tail.load(std::memory_order_relaxed);
+        slot* s;
+        for(;;)
+        {
+            s = &ring[pos & mask];
+            auto const seq = s->seq.load(std::memory_order_acquire);
+            auto const diff =
+                static_cast<std::intptr_t>(seq) -
+                static_cast<std::intptr_t>(pos);
+            if(diff == 0)
+            {
+                if(tail.compare_exchange_weak(
+                    pos, pos + 1, std::memory_order_relaxed))
+                    break;
+            }
+            else if(diff < 0)
+            {
+                // full
+                if(policy.load(std::memory_order_relaxed) ==
+                    log_overflow::drop)
+                {
+                    delete[] heap;
+                    dropped.fetch_add(1, std::memory_order_relaxed);
+                    return false;
+                }
+                if(! waited)
+                {
+                    waited = true;
+                    blocked.fetch_add(1, std::memory_order_relaxed);
+                }
+                signal();
+                std::this_thread::yield();
+                pos = tail.load(std::memory_order_relaxed);
+            }
+            else
+            {
+                pos = tail.load(std::memory_order_relaxed);
+            }
+        }
+
+        s->size = rec.size();
+        s->heap = heap;
+        s->decode = decode;
+        if(! heap)
+            std::memcpy(s->data, rec.data(), rec.size());
+        s->seq.store(pos + 1);
+        signal();
+        return true;
+    }
+
+    // Hand `n` records to the sink. If the sink throws,
+    // they are counted as dropped.
+    void
+    write_batch(
+        std::string& batch,
+        std::size_t& n) noexcept
+    {
+        if(n == 0)
+            return;
+        std::shared_ptr<log_sink> p;
+        {
+            std::lock_guard<std::mutex> lock(sink_m);
+            p = sink;
+        }
+        try
+        {
+            p->write(batch.data(), batch.size());
+            written.fetch_add(n, std::memory_order_relaxed);
+        }
+        catch(...)
+        {
+            dropped.fetch_add(n, std::memory_order_relaxed);
+        }
+        batches.fetch_add(1, std::memory_order_relaxed);
+        batch.clear();
+        n = 0;
+    }
+
+    // The logging thread
+    void
+    run()
+    {
+        std::string batch;
+        batch.reserve(batch_size + inline_size + 1);
+        std::size_t batched = 0;
+        std::size_t head = 0;
+        for(;;)
+        {
+            auto const w = wake.load();
+            std::size_t n = 0;
+            for(;;)
+            {
+                auto& s = ring[head & mask];
+                if(s.seq.load(std::memory_order_acquire) != head + 1)
+                    break;
+                char const* p = s.heap ? s.heap : s.data;
+                if(! s.decode)
+                {
+                    batch.append(p, s.size);
+                    batch.push_back('\n');
+                    ++batched;
+                }
+                else
+                {
+                    // binary records are formatted here,
+                    // off the producer's thread. A record
+                    // whose decoder throws is dropped.
+                    auto const size = batch.size();
+                    try
+                    {
+                        s.decode(p, s.size, batch);
+                        batch.push_back('\n');
+                        ++batched;
+                    }
+                    catch(...)
+                    {
+                        batch.resize(size);
+                        dropped.fetch_add(1, std::memory_order_relaxed);
+                    }
+                }
+                if(s.heap)
+                {
+                    delete[] s.heap;
+                    s.heap = nullptr;
+                }
+                s.seq.store(head + mask + 1, std::memory_order_release);
+                ++head;
+                ++n;
+                if(batch.size() >= batch_size)
+                {
+                    write_batch(batch, batched);
+                    done.store(head);
+                }
+            }
+            write_batch(batch, batched);
+            done.store(head);
+            if(n > 0)
+                continue;
+            if(stop.load())
+                break;
+
+            // Announce the sleep, then look at the ring
+            // once more, so that a producer which did not
+            // see `sleeping` has its record found here. A
+            // notification sent since `w` was read
+            // prevents the wait.
+            sleeping.store(true);
+            if( ring[head & mask].seq.load() == head + 1 ||
+                stop.load())
+            {
+                sleeping.store(false);
+                continue;
+            }
+            wake.wait(w);
+            sleeping.store(false);
+        }
+    }
+};
+
+log_backend::
+~log_backend() = default;
+
+log_backend::
+log_backend(
+    std::size_t capacity,
+    std::shared_ptr<log_sink> sink)
+    : impl_(new impl(capacity, std::move(sink)))
+{
+}
+
+void
+log_backend::
+set_sink(std::shared_ptr<log_sink> sink)
+{
+    if(! sink)
+        sink = fd_log_sink::stderr_sink();
+    std::lock_guard<std::mutex> lock(impl_->sink_m);
+    impl_->sink = std::move(sink);
+}
+
+void
+log_backend::
+set_overflow(log_overflow policy) noexcept
+{
+    impl_->policy.store(policy, std::memory_order_relaxed);
+}
+
+bool
+log_backend::
+push(
+    core::string_view record,
+    log_decoder decode) noexcept
+{
+    return impl_->push(record, decode);
+}
+
+void
+log_backend::
+flush()
+{
+    auto const target = impl_->tail.load();
+    impl_->notify();
+    while(impl_->done.load() < target)
+        std::this_thread::yield();
+}
+
+log_backend_stats
+log_backend::
+get_stats() const noexcept
+{
+    log_backend_stats st;
+    st.written = impl_->written.load(std::memory_order_relaxed);
+    st.dropped = impl_->dropped.load(std::memory_order_relaxed);
+    st.blocked = impl_->blocked.load(std::memory_order_relaxed);
+    st.batches = impl_->batches.load(std::memory_order_relaxed);
+    return st;
+}
+
+} // beast2
+} // boost
@@ -42,6 +42,28 @@ public:
         return ls_.get_sections();
     }
 
+    bool
+    set_threshold(
+        core::string_view name,
+        int level) override
+    {
+        for(auto& sect : ls_.get_sections())
+        {
+            if(sect.name() == name)
+            {
+                sect.set_threshold(level);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    log_backend&
+    get_backend() noexcept override
+    {
+        return ls_.backend();
+    }
+
     void shutdown() override {}
 
 private:
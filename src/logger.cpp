@@ -8,7 +8,6 @@
 //
 
 #include <boost/beast2/logger.hpp>
-#include <iostream>
 #include <mutex>
 #include <unordered_map>
 #include <vector>
@@ -26,17 +25,20 @@ write(
     std::string s)
 {
     (void)level;
-    // VFALCO NO! This is just for demo purposes
-    static std::mutex m;
-    std::lock_guard<std::mutex> lock(m);
-    std::cerr << s << std::endl;
+    // copied into the backend's ring; the
+    // caller does not wait for the write
+    if(impl_->backend)
+        impl_->backend->push(s);
 }
 
 section::
-section(core::string_view name)
+section(
+    core::string_view name,
+    std::shared_ptr<log_backend> backend)
     : impl_(std::make_shared<impl>())
 {
     impl_->name = name;
+    impl_->backend = std::move(backend);
 }
 
 //------------------------------------------------
@@ -64,6 +66,8 @@ struct log_sections::impl
     std::mutex m;
     std::unordered_map<core::string_view, section, hash> map;
     std::vector<section> vec;
+    std::shared_ptr<log_backend> backend =
+        std::make_shared<log_backend>();
 };
 
 log_sections::
@@ -91,7 +95,7 @@ get(core::string_view name)
     // the map stores a string_view; make sure
     // the string data it references does not
     // move after creation.
-    auto v = section(name);
+    auto v = section(name, impl_->backend);
     impl_->map.emplace(
         core::string_view(v.impl_->name), v);
     impl_->vec.push_back(v);
@@ -107,5 +111,12 @@ get_sections() const noexcept ->
     return impl_->vec;
 }
 
+log_backend&
+log_sections::
+backend() noexcept
+{
+    return *impl_->backend;
+}
+
 } // beast2
 } // boost
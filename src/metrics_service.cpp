@@ -0,0 +1,537 @@
+//
+// Copyright (c) 2026 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/beast2
+//
+
+#include <boost/beast2/metrics_service.hpp>
+#include <boost/beast2/body_writer.hpp>
+#include <boost/beast2/detail/except.hpp>
+#include <boost/beast2/detail/request_slots.hpp>
+#include <boost/capy/ex/system_context.hpp>
+#include <cmath>
+#include <cstdio>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace boost {
+namespace beast2 {
+
+namespace {
+
+using detail::histogram_impl;
+
+// The largest value counted in bucket `i`
+std::uint64_t
+upper_bound_of(std::size_t i) noexcept
+{
+    constexpr std::uint64_t sub =
+        1u << histogram_impl::sub_bits;
+    if(i < sub)
+        return i;
+    auto const e = (i >> histogram_impl::sub_bits) - 1;
+    auto const s = i & (sub - 1);
+    return ((sub + s + 1) << e) - 1;
+}
+
+// Sum the slots of a histogram
+void
+snapshot(
+    histogram_impl const& h,
+    std::uint64_t (&b)[histogram_impl::buckets],
+    std::uint64_t& sum) noexcept
+{
+    sum = 0;
+    for(auto& x : b)
+        x = 0;
+    h.shards.for_each(
+        [&](histogram_impl::shard const& s)
+        {
+            for(std::size_t i = 0; i < histogram_impl::buckets; ++i)
+                b[i] += s.b[i].load(std::memory_order_relaxed);
+            sum += s.sum.load(std::memory_order_relaxed);
+        });
+}
+
+// Hands out the slot indexes of threads, reusing
+// those of threads which have exited. Never destroyed,
+// as threads may exit after static destruction.
+struct slot_registry
+{
+    std::mutex m;
+    std::vector<std::size_t> free;
+    std::size_t next = 0;
+
+    static
+    slot_registry&
+    get() noexcept
+    {
+        static slot_registry* const r = new slot_registry;
+        return *r;
+    }
+};
+
+void
+append_number(std::string& dest, double v)
+{
+    char buf[32];
+    auto const n = std::snprintf(buf, sizeof(buf), "%.9g", v);
+    dest.append(buf, static_cast<std::size_t>(n));
+}
+
+// Escape a label value as the text format requires
+void
+append_label_value(
+    std::string& dest,
+    core::string_view v)
+{
+    for(char c : v)
+    {
+        switch(c)
+        {
+        case '\\': dest.append("\\\\"); break;
+        case '"': dest.append("\\\""); break;
+        case '\n': dest.append("\\n"); break;
+        default: dest.push_back(c); break;
+        }
+    }
+}
+
+void
+append_sample(
+    std::string& dest,
+    core::string_view name,
+    core::string_view suffix,
+    core::string_view labels,
+    core::string_view le)
+{
+    dest.append(name.data(), name.size());
+    dest.append(suffix.data(), suffix.size());
+    if(! labels.empty() || ! le.empty())
+    {
+        dest.push_back('{');
+        dest.append(labels.data(), labels.size());
+        if(! le.empty())
+        {
+            if(! labels.empty())
+                dest.push_back(',');
+            dest.append("le=\"");
+            dest.append(le.data(), le.size());
+            dest.push_back('"');
+        }
+        dest.push_back('}');
+    }
+    dest.push_back(' ');
+}
+
+class metrics_service_impl
+    : public metrics_service
+    , public capy::execution_context::service
+{
+public:
+    using key_type = metrics_service;
+
+    explicit
+    metrics_service_impl(capy::execution_context&) noexcept
+    {
+    }
+
+    counter
+    get_counter(
+        core::string_view name,
+        core::string_view help,
+        core::string_view labels) override
+    {
+        std::lock_guard<std::mutex> lock(m_);
+        auto& f = get_family(name, help, kind::counter);
+        auto& p = f.counters[std::string(labels)];
+        if(! p)
+            p = std::make_unique<detail::counter_impl>();
+        return make(p.get());
+    }
+
+    gauge
+    get_gauge(
+        core::string_view name,
+        core::string_view help,
+        core::string_view labels) override
+    {
+        std::lock_guard<std::mutex> lock(m_);
+        auto& f = get_family(name, help, kind::gauge);
+        auto& p = f.gauges[std::string(labels)];
+        if(! p)
+            p = std::make_unique<detail::gauge_impl>();
+        return make(p.get());
+    }
+
+    histogram
+    get_histogram(
+        core::string_view name,
+        core::string_view help,
+        core::string_view labels,
+        double unit) override
+    {
+        std::lock_guard<std::mutex> lock(m_);
+        auto& f = get_family(name, help, kind::histogram);
+        auto& p = f.histograms[std::string(labels)];
+        if(! p)
+        {
+            p = std::make_unique<histogram_impl>();
+            p->unit = unit;
+        }
+        return make(p.get());
+    }
+
+    void
+    render(std::string& dest) const override
+    {
+        // Writers never take this lock; it only keeps
+        // the maps stable while they are walked
+        std::lock_guard<std::mutex> lock(m_);
+        for(auto const& [name, f] : families_)
+        {
+            dest.append("# HELP ");
+            dest.append(name);
+            dest.push_back(' ');
+            dest.append(f.help);
+            dest.append("\n# TYPE ");
+            dest.append(name);
+            switch(f.k)
+            {
+            case kind::counter:
+                dest.append(" counter\n");
+                for(auto const& [labels, p] : f.counters)
+                {
+                    append_sample(dest, name, {}, labels, {});
+                    dest.append(std::to_string(
+                        make(p.get()).value()));
+                    dest.push_back('\n');
+                }
+                break;
+
+            case kind::gauge:
+                dest.append(" gauge\n");
+                for(auto const& [labels, p] : f.gauges)
+                {
+                    append_sample(dest, name, {}, labels, {});
+                    dest.append(std::to_string(
+                        make(p.get()).value()));
+                    dest.push_back('\n');
+                }
+                break;
+
+            case kind::histogram:
+                dest.append(" histogram\n");
+                for(auto const& [labels, p] : f.histograms)
+                    render_histogram(dest, name, labels, *p);
+                break;
+            }
+        }
+    }
+
+    void shutdown() override {}
+
+private:
+    enum class kind
+    {
+        counter,
+        gauge,
+        histogram
+    };
+
+    struct family
+    {
+        kind k;
+        std::string help;
+        std::map<std::string,
+            std::unique_ptr<detail::counter_impl>> counters;
+        std::map<std::string,
+            std::unique_ptr<detail::gauge_impl>> gauges;
+        std::map<std::string,
+            std::unique_ptr<histogram_impl>> histograms;
+    };
+
+    family&
+    get_family(
+        core::string_view name,
+        core::string_view help,
+        kind k)
+    {
+        auto it = families_.find(name);
+        if(it == families_.end())
+        {
+            it = families_.emplace(
+                std::string(name), family{}).first;
+            it->second.k = k;
+            it->second.help = help;
+        }
+        else if(it->second.k != k)
+        {
+            detail::throw_invalid_argument(
+                "metric name in use by another type");
+        }
+        return it->second;
+    }
+
+    // The bounds of each power of two are rendered,
+    // so every series has the same fixed set of `le`
+    // labels. The last bucket also counts every value
+    // beyond it, so it is only counted in `+Inf`.
+    static
+    void
+    render_histogram(
+        std::string& dest,
+        std::string const& name,
+        std::string const& labels,
+        histogram_impl const& h)
+    {
+        std::uint64_t b[histogram_impl::buckets];
+        std::uint64_t sum;
+        snapshot(h, b, sum);
+
+        constexpr std::size_t sub_mask =
+            (std::size_t(1) << histogram_impl::sub_bits) - 1;
+        std::uint64_t cum = 0;
+        std::string le;
+        for(std::size_t i = 0; i < histogram_impl::buckets - 1; ++i)
+        {
+            cum += b[i];
+            if((i & sub_mask) != sub_mask)
+                continue;
+            le.clear();
+            append_number(le, static_cast<double>(
+                upper_bound_of(i)) * h.unit);
+            append_sample(dest, name, "_bucket", labels, le);
+            dest.append(std::to_string(cum));
+            dest.push_back('\n');
+        }
+        cum += b[histogram_impl::buckets - 1];
+        append_sample(dest, name, "_bucket", labels, "+Inf");
+        dest.append(std::to_string(cum));
+        dest.push_back('\n');
+        append_sample(dest, name, "_sum", labels, {});
+        append_number(dest, static_cast<double>(sum) * h.unit);
+        dest.push_back('\n');
+        append_sample(dest, name, "_count", labels, {});
+        dest.append(std::to_string(cum));
+        dest.push_back('\n');
+    }
+
+    mutable std::mutex m_;
+    std::map<std::string, family, std::less<>> families_;
+};
+
+} // (anon)
+
+//------------------------------------------------
+
+namespace detail {
+
+metric_thread::
+metric_thread() noexcept
+    : index([]
+        {
+            auto& r = slot_registry::get();
+            std::lock_guard<std::mutex> lock(r.m);
+            if(r.free.empty())
+                return r.next++;
+            auto const i = r.free.back();
+            r.free.pop_back();
+            return i;
+        }())
+{
+}
+
+metric_thread::
+~metric_thread()
+{
+    auto& r = slot_registry::get();
+    std::lock_guard<std::mutex> lock(r.m);
+    try
+    {
+        r.free.push_back(index);
+    }
+    catch(...)
+    {
+        // the index is not reused
+    }
+}
+
+} // detail
+
+//------------------------------------------------
+
+std::uint64_t
+counter::
+value() const noexcept
+{
+    if(! p_)
+        return 0;
+    std::uint64_t n = 0;
+    p_->shards.for_each(
+        [&](detail::counter_shard const& s)
+        {
+            n += s.v.load(std::memory_order_relaxed);
+        });
+    return n;
+}
+
+std::uint64_t
+histogram::
+count() const noexcept
+{
+    if(! p_)
+        return 0;
+    std::uint64_t n = 0;
+    p_->shards.for_each(
+        [&](histogram_impl::shard const& s)
+        {
+            n += s.count.load(std::memory_order_relaxed);
+        });
+    return n;
+}
+
+std::uint64_t
+histogram::
+quantile(double q) const noexcept
+{
+    if(! p_)
+        return 0;
+    std::uint64_t b[histogram_impl::buckets];
+    std::uint64_t sum;
+    snapshot(*p_, b, sum);
+    std::uint64_t total = 0;
+    for(auto x : b)
+        total += x;
+    if(total == 0)
+        return 0;
+
+    if(q < 0)
+        q = 0;
+    if(q > 1)
+        q = 1;
+    auto rank = static_cast<std::uint64_t>(
+        std::ceil(q * static_cast<double>(total)));
+    if(rank == 0)
+        rank = 1;
+    std::uint64_t cum = 0;
+    for(std::size_t i = 0; i < histogram_impl::buckets; ++i)
+    {
+        cum += b[i];
+        if(cum >= rank)
+            return upper_bound_of(i);
+    }
+    return upper_bound_of(histogram_impl::buckets - 1);
+}
+
+//------------------------------------------------
+
+metrics_service&
+use_metrics_service()
+{
+    return capy::get_system_context().use_service<metrics_service_impl>();
+}
+
+//------------------------------------------------
+
+server_metrics::
+server_metrics(metrics_service& svc)
+    : connections_accepted(svc.get_counter(
+        "beast2_connections_accepted_total",
+        "Connections accepted."))
+    , connections_shed(svc.get_counter(
+        "beast2_connections_shed_total",
+        "Connections refused by admission control."))
+    , connections_active(svc.get_gauge(
+        "beast2_connections_active",
+        "Connections open."))
+    , requests{
+        svc.get_counter("beast2_requests_total",
+            "Requests handled, by status class.", "code=\"1xx\""),
+        svc.get_counter("beast2_requests_total",
+            "Requests handled, by status class.", "code=\"2xx\""),
+        svc.get_counter("beast2_requests_total",
+            "Requests handled, by status class.", "code=\"3xx\""),
+        svc.get_counter("beast2_requests_total",
+            "Requests handled, by status class.", "code=\"4xx\""),
+        svc.get_counter("beast2_requests_total",
+            "Requests handled, by status class.", "code=\"5xx\"") }
+    , response_bytes(svc.get_counter(
+        "beast2_response_bytes_total",
+        "Bytes of responses written."))
+    , tls_handshakes{
+        svc.get_counter("beast2_tls_handshakes_total",
+            "TLS handshakes, by outcome.", "type=\"full\""),
+        svc.get_counter("beast2_tls_handshakes_total",
+            "TLS handshakes, by outcome.", "type=\"resumed\""),
+        svc.get_counter("beast2_tls_handshakes_total",
+            "TLS handshakes, by outcome.", "type=\"failed\"") }
+    , latency(svc.get_histogram(
+        "beast2_route_latency_seconds",
+        "Time from a parsed request header to the end of dispatch.",
+        "route=\"\"", 1e-6))
+{
+}
+
+//------------------------------------------------
+
+http::route_task
+serve_metrics::
+operator()(http::route_params& rp) const
+{
+    auto const method = rp.req.method();
+    if( method != http::method::get &&
+        method != http::method::head)
+        co_return http::route_next;
+
+    std::string body;
+    svc_->render(body);
+    rp.res.set(http::field::content_type,
+        "text/plain; version=0.0.4; charset=utf-8");
+    if(method == http::method::head)
+    {
+        // the header a GET would get
+        body_writer w(rp, body.size());
+        if(auto ec = co_await w.finish())
+            co_return http::route_error(ec);
+        co_return http::route_done;
+    }
+    auto [ec] = co_await rp.send(body);
+    if(ec)
+        co_return http::route_error(ec);
+    co_return http::route_done;
+}
+
+measure_route::
+measure_route(
+    core::string_view name,
+    metrics_service& svc)
+    : h_([&]
+        {
+            std::string labels = "route=\"";
+            append_label_value(labels, name);
+            labels.push_back('"');
+            return svc.get_histogram(
+                "beast2_route_latency_seconds",
+                "Time from a parsed request header to the end of dispatch.",
+                labels, 1e-6);
+        }())
+{
+}
+
+http::route_task
+measure_route::
+operator()(http::route_params& rp) const
+{
+    if(auto const s = detail::find_slots(rp))
+        s->latency = &h_;
+    co_return http::route_next;
+}
+
+} // beast2
+} // boost
@@ -0,0 +1,73 @@
+//
+// Copyright (c) 2026 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/beast2
+//
+
+#include <boost/beast2/request_arena.hpp>
+#include <boost/beast2/detail/request_slots.hpp>
+
+namespace boost {
+namespace beast2 {
+
+request_arena::
+request_arena(
+    std::size_t initial_size)
+    : buf_(new unsigned char[initial_size > 0 ? initial_size : 1])
+    , size_(initial_size > 0 ? initial_size : 1)
+    , mr_(buf_.get(), size_, std::pmr::new_delete_resource())
+{
+}
+
+void
+request_arena::
+reset() noexcept
+{
+    // rewinds to the start of buf_, and frees
+    // every block obtained from the heap
+    mr_.release();
+    used_ = 0;
+}
+
+void*
+request_arena::
+do_allocate(
+    std::size_t bytes,
+    std::size_t alignment)
+{
+    void* p = mr_.allocate(bytes, alignment);
+    used_ += bytes;
+    return p;
+}
+
+void
+request_arena::
+do_deallocate(
+    void*,
+    std::size_t,
+    std::size_t)
+{
+}
+
+bool
+request_arena::
+do_is_equal(
+    std::pmr::memory_resource const& other) const noexcept
+{
+    return this == &other;
+}
+
+std::pmr::memory_resource*
+get_arena(http::route_params& rp) noexcept
+{
+    auto const s = detail::find_slots(rp);
+    if(s && s->arena)
+        return s->arena;
+    return std::pmr::new_delete_resource();
+}
+
+} // beast2
+} // boost
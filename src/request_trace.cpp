@@ -0,0 +1,72 @@
+//
+// Copyright (c) 2026 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/beast2
+//
+
+#include <boost/beast2/request_trace.hpp>
+#include <utility>
+
+namespace boost {
+namespace beast2 {
+
+namespace {
+
+long long
+to_us(request_trace::clock_type::duration d) noexcept
+{
+    return static_cast<long long>(
+        std::chrono::duration_cast<
+            std::chrono::microseconds>(d).count());
+}
+
+} // (anon)
+
+slow_request_reporter::
+slow_request_reporter(
+    section sect,
+    request_trace::clock_type::duration threshold)
+    : sect_(std::move(sect))
+    , threshold_(threshold)
+{
+}
+
+void
+slow_request_reporter::
+on_request(
+    request_trace const& t,
+    http::route_params const& rp)
+{
+    using tp = trace_point;
+
+    if(! t.has(tp::first_byte) || ! t.has(tp::dispatch_end))
+        return;
+
+    // The handler usually writes the response itself,
+    // so the last byte may precede the end of dispatch
+    auto end = t[tp::dispatch_end];
+    if(t.has(tp::last_byte) && end < t[tp::last_byte])
+        end = t[tp::last_byte];
+    auto const total = end - t[tp::first_byte];
+    if(total < threshold_)
+        return;
+
+    LOG_WRN(sect_)(
+        "slow request: {} {} status={} total={}us"
+        " wait={}us header={}us url={}us handler={}us write={}us",
+        rp.req.method_text(),
+        rp.req.target(),
+        rp.res.status_int(),
+        to_us(total),
+        to_us(t.between(tp::accept, tp::first_byte)),
+        to_us(t.between(tp::first_byte, tp::header_parsed)),
+        to_us(t.between(tp::header_parsed, tp::url_parsed)),
+        to_us(t.between(tp::dispatch_begin, tp::dispatch_end)),
+        to_us(end - t[tp::dispatch_end]));
+}
+
+} // beast2
+} // boost
@@ -0,0 +1,554 @@
+//
+// Copyright (c) 2026 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/beast2
+//
+
+#include <boost/beast2/response_cache.hpp>
+#include <boost/beast2/request_arena.hpp>
+#include <boost/beast2/detail/request_slots.hpp>
+#include <boost/beast2/response_tap.hpp>
+#include "src/detail/string_util.hpp"
+#include <boost/http/field.hpp>
+#include <boost/url/url.hpp>
+#include <charconv>
+#include <functional>
+#include <list>
+#include <memory_resource>
+#include <mutex>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace boost {
+namespace beast2 {
+
+namespace {
+
+using detail::iequals;
+using detail::to_lower;
+using detail::trim;
+
+struct string_hash
+{
+    using is_transparent = void;
+
+    std::size_t
+    operator()(core::string_view s) const noexcept
+    {
+        return std::hash<std::string_view>()(
+            std::string_view(s.data(), s.size()));
+    }
+};
+
+template<class T>
+using string_map = std::unordered_map<
+    std::string, T, string_hash, std::equal_to<>>;
+
+// Invoke f on each trimmed element of a comma separated list
+template<class F>
+void
+for_each_element(core::string_view list, F const& f)
+{
+    while(! list.empty())
+    {
+        auto const comma = list.find(',');
+        f(trim(list.substr(0, comma)));
+        if(comma == core::string_view::npos)
+            break;
+        list.remove_prefix(comma + 1);
+    }
+}
+
+// Return the value of a Cache-Control directive:
+// empty if present without a value, null if absent
+bool
+find_directive(
+    core::string_view cc,
+    core::string_view name,
+    core::string_view* value = nullptr)
+{
+    bool found = false;
+    for_each_element(cc, [&](core::string_view d)
+        {
+            if(found)
+                return;
+            auto const eq = d.find('=');
+            if(! iequals(trim(d.substr(0, eq)), name))
+                return;
+            found = true;
+            if(value)
+            {
+                *value = eq == core::string_view::npos ?
+                    core::string_view() : trim(d.substr(eq + 1));
+                if( value->size() >= 2 &&
+                    value->front() == '"' && value->back() == '"')
+                    *value = value->substr(1, value->size() - 2);
+            }
+        });
+    return found;
+}
+
+bool
+directive_seconds(
+    core::string_view cc,
+    core::string_view name,
+    std::chrono::seconds& result)
+{
+    core::string_view v;
+    if(! find_directive(cc, name, &v))
+        return false;
+    std::uint32_t n = 0;
+    auto const rv = std::from_chars(
+        v.data(), v.data() + v.size(), n);
+    if(rv.ec != std::errc() || rv.ptr != v.data() + v.size())
+        return false;
+    result = std::chrono::seconds(n);
+    return true;
+}
+
+bool
+etag_matches(
+    core::string_view if_none_match,
+    core::string_view etag) noexcept
+{
+    // weak comparison, RFC 9110 section 13.1.2
+    auto const strip = [](core::string_view s)
+        {
+            if(s.starts_with("W/"))
+                s.remove_prefix(2);
+            return s;
+        };
+    bool match = false;
+    for_each_element(if_none_match, [&](core::string_view t)
+        {
+            if(t == "*" || strip(t) == strip(etag))
+                match = true;
+        });
+    return match;
+}
+
+// Host and normalized target
+std::string
+cache_url(http::route_params const& rp)
+{
+    std::string s;
+    for(char c : rp.req.value_or(http::field::host, ""))
+        s.push_back(to_lower(c));
+    urls::url u(rp.url);
+    u.normalize();
+    u.remove_fragment();
+    s.append(u.buffer());
+    return s;
+}
+
+template<class String>
+void
+vary_values(
+    String& s,
+    http::request const& req,
+    core::string_view names)
+{
+    for_each_element(names, [&](core::string_view name)
+        {
+            s.append(req.value_or(name, ""));
+            s.push_back('\0');
+        });
+}
+
+// Called with the recorded bytes of a response. Only
+// responses to GET are stored, so the method is not
+// part of the key.
+void
+store(
+    response_cache& cache,
+    http::route_params const& rp,
+    std::string const& url,
+    core::string_view bytes)
+{
+    auto const& res = rp.res;
+    if( rp.req.method() != http::method::get ||
+        res.status() != http::status::ok ||
+        ! res.keep_alive() ||
+        res.count(http::field::set_cookie) != 0 ||
+        res.count(http::field::age) != 0)
+        return;
+
+    auto const cc = res.value_or(http::field::cache_control, "");
+    if( find_directive(cc, "no-store") ||
+        find_directive(cc, "no-cache") ||
+        find_directive(cc, "private"))
+        return;
+
+    // RFC 9111 section 3.5
+    if( rp.req.count(http::field::authorization) != 0 &&
+        ! find_directive(cc, "public") &&
+        ! find_directive(cc, "must-revalidate") &&
+        ! find_directive(cc, "s-maxage"))
+        return;
+
+    std::chrono::seconds ttl{};
+    response_cache::clock_type::duration life =
+        cache.config().default_ttl;
+    if( directive_seconds(cc, "s-maxage", ttl) ||
+        directive_seconds(cc, "max-age", ttl))
+        life = ttl;
+    if(life <= response_cache::clock_type::duration::zero())
+        return;
+
+    std::string names;
+    bool any = false;
+    for_each_element(
+        res.value_or(http::field::vary, ""),
+        [&](core::string_view name)
+        {
+            if(name == "*")
+                any = true;
+            if(! names.empty())
+                names.push_back(',');
+            for(char c : name)
+                names.push_back(to_lower(c));
+        });
+    if(any)
+        return;
+
+    auto const header_size = res.buffer().size();
+    if(header_size > bytes.size())
+        return;
+
+    auto e = std::make_shared<response_cache::entry>();
+    e->bytes.assign(bytes.data(), bytes.size());
+    e->header_size = header_size;
+    e->etag = res.value_or(http::field::etag, "");
+    e->stored = response_cache::clock_type::now();
+    e->expires = e->stored + life;
+    std::string vary;
+    vary_values(vary, rp.req, names);
+    cache.insert(url, names, vary, std::move(e));
+}
+
+} // (anon)
+
+//------------------------------------------------
+
+struct response_cache::shard
+{
+    struct node
+    {
+        std::string key;
+        std::size_t url_size;
+        std::shared_ptr<entry const> e;
+    };
+
+    struct vary_info
+    {
+        std::string names;
+        std::size_t refs = 0;
+    };
+
+    mutable std::mutex m;
+    std::list<node> lru; // most recent first
+    string_map<std::list<node>::iterator> index;
+    string_map<vary_info> vary;
+    std::size_t limit = 0;
+    response_cache_stats st;
+
+    static
+    std::size_t
+    cost(node const& n) noexcept
+    {
+        return n.key.size() + n.e->bytes.size();
+    }
+
+    // Precondition: lock held
+    void
+    erase(std::list<node>::iterator it)
+    {
+        auto const url = core::string_view(
+            it->key).substr(0, it->url_size);
+        auto const v = vary.find(url);
+        if(v != vary.end() && --v->second.refs == 0)
+            vary.erase(v);
+        index.erase(index.find(core::string_view(it->key)));
+        st.bytes -= cost(*it);
+        --st.entries;
+        lru.erase(it);
+    }
+};
+
+struct response_cache::impl
+{
+    response_cache_config cfg;
+    std::vector<shard> shards;
+
+    explicit
+    impl(response_cache_config const& cfg_)
+        : cfg(cfg_)
+        , shards(cfg_.shards > 0 ? cfg_.shards : 1)
+    {
+        for(auto& s : shards)
+            s.limit = cfg.max_bytes / shards.size();
+    }
+};
+
+response_cache::
+~response_cache()
+{
+    delete impl_;
+}
+
+response_cache::
+response_cache(
+    response_cache_config const& cfg)
+    : impl_(new impl(cfg))
+{
+}
+
+response_cache_config const&
+response_cache::
+config() const noexcept
+{
+    return impl_->cfg;
+}
+
+auto
+response_cache::
+shard_for(core::string_view url) const noexcept ->
+    shard&
+{
+    auto const h = string_hash()(url);
+    return impl_->shards[h % impl_->shards.size()];
+}
+
+std::shared_ptr<response_cache::entry const>
+response_cache::
+find(
+    core::string_view url,
+    core::string_view vary,
+    clock_type::time_point now)
+{
+    std::string key;
+    key.reserve(url.size() + 1 + vary.size());
+    key.append(url);
+    key.push_back('\0');
+    key.append(vary);
+
+    auto& s = shard_for(url);
+    std::lock_guard<std::mutex> lock(s.m);
+    auto const it = s.index.find(core::string_view(key));
+    if(it == s.index.end())
+    {
+        ++s.st.misses;
+        return nullptr;
+    }
+    if(it->second->e->expires <= now)
+    {
+        s.erase(it->second);
+        ++s.st.misses;
+        return nullptr;
+    }
+    s.lru.splice(s.lru.begin(), s.lru, it->second);
+    ++s.st.hits;
+    return it->second->e;
+}
+
+std::string
+response_cache::
+vary_of(core::string_view url) const
+{
+    auto& s = shard_for(url);
+    std::lock_guard<std::mutex> lock(s.m);
+    auto const it = s.vary.find(url);
+    if(it == s.vary.end())
+        return {};
+    return it->second.names;
+}
+
+void
+response_cache::
+insert(
+    core::string_view url,
+    core::string_view vary_names,
+    core::string_view vary,
+    std::shared_ptr<entry const> e)
+{
+    shard::node n;
+    n.key.reserve(url.size() + 1 + vary.size());
+    n.key.append(url);
+    n.key.push_back('\0');
+    n.key.append(vary);
+    n.url_size = url.size();
+    n.e = std::move(e);
+
+    auto& s = shard_for(url);
+    if(shard::cost(n) > s.limit)
+        return;
+
+    std::lock_guard<std::mutex> lock(s.m);
+    auto const it = s.index.find(core::string_view(n.key));
+    if(it != s.index.end())
+        s.erase(it->second);
+
+    // A response which varies differently replaces
+    // every variant stored under the old names
+    auto v = s.vary.find(url);
+    if(v != s.vary.end() && v->second.names != vary_names)
+    {
+        for(auto p = s.lru.begin(); p != s.lru.end();)
+        {
+            auto const q = p++;
+            if(core::string_view(q->key).substr(0, q->url_size) == url)
+                s.erase(q);
+        }
+        v = s.vary.find(url);
+    }
+    if(v == s.vary.end())
+        v = s.vary.emplace(std::string(url),
+            shard::vary_info{ std::string(vary_names), 0 }).first;
+    ++v->second.refs;
+
+    s.st.bytes += shard::cost(n);
+    ++s.st.entries;
+    ++s.st.stores;
+    s.lru.push_front(std::move(n));
+    s.index.emplace(s.lru.front().key, s.lru.begin());
+
+    while(s.st.bytes > s.limit)
+    {
+        s.erase(std::prev(s.lru.end()));
+        ++s.st.evictions;
+    }
+}
+
+void
+response_cache::
+clear()
+{
+    for(auto& s : impl_->shards)
+    {
+        std::lock_guard<std::mutex> lock(s.m);
+        s.lru.clear();
+        s.index.clear();
+        s.vary.clear();
+        s.st.entries = 0;
+        s.st.bytes = 0;
+    }
+}
+
+response_cache_stats
+response_cache::
+get_stats() const
+{
+    response_cache_stats st;
+    for(auto& s : impl_->shards)
+    {
+        std::lock_guard<std::mutex> lock(s.m);
+        st.hits += s.st.hits;
+        st.misses += s.st.misses;
+        st.stores += s.st.stores;
+        st.evictions += s.st.evictions;
+        st.entries += s.st.entries;
+        st.bytes += s.st.bytes;
+    }
+    return st;
+}
+
+//------------------------------------------------
+
+http::route_task
+cache_responses::
+operator()(http::route_params& rp) const
+{
+    auto const method = rp.req.method();
+    if( method != http::method::get &&
+        method != http::method::head)
+        co_return http::route_next;
+
+    // Stored bytes can only go out on a connection
+    // with a tap, and they describe a persistent
+    // HTTP/1.1 connection
+    auto const s = detail::find_slots(rp);
+    if( ! s || ! s->tap ||
+        rp.req.version() != http::version::http_1_1 ||
+        ! rp.res.keep_alive())
+        co_return http::route_next;
+    response_tap& tap = *s->tap;
+
+    auto const cc = rp.req.value_or(http::field::cache_control, "");
+    if(find_directive(cc, "no-store"))
+        co_return http::route_next;
+
+    // Stored responses may have been made for another
+    // user, or for none
+    bool const lookup =
+        ! find_directive(cc, "no-cache") &&
+        rp.req.count(http::field::authorization) == 0;
+
+    auto url = cache_url(rp);
+    if(lookup)
+    {
+        std::pmr::string vary(get_arena(rp));
+        vary_values(vary, rp.req, cache_->vary_of(url));
+        auto const now = response_cache::clock_type::now();
+        if(auto e = cache_->find(url, vary, now))
+        {
+            // RFC 9111 section 5.1
+            auto const age = std::chrono::duration_cast<
+                std::chrono::seconds>(now - e->stored).count();
+            char age_buf[24];
+            auto const age_end = std::to_chars(age_buf,
+                age_buf + sizeof(age_buf), age < 0 ? 0 : age).ptr;
+            core::string_view const age_str(
+                age_buf, static_cast<std::size_t>(age_end - age_buf));
+
+            system::error_code ec;
+            std::pmr::string s(get_arena(rp));
+            auto const inm = rp.req.value_or(
+                http::field::if_none_match, "");
+            if(! e->etag.empty() && etag_matches(inm, e->etag))
+            {
+                s.append(
+                    "HTTP/1.1 304 Not Modified\r\n"
+                    "ETag: ");
+                s.append(e->etag);
+                s.append("\r\nAge: ");
+                s.append(age_str);
+                s.append("\r\n\r\n");
+                ec = co_await tap.write(s);
+            }
+            else
+            {
+                // the stored header, less its final empty line
+                s.append(core::string_view(
+                    e->bytes).substr(0, e->header_size - 2));
+                s.append("Age: ");
+                s.append(age_str);
+                s.append("\r\n\r\n");
+                ec = co_await tap.write(s);
+                if(! ec && method == http::method::get)
+                    ec = co_await tap.write(core::string_view(
+                        e->bytes).substr(e->header_size));
+            }
+            if(ec)
+                co_return http::route_error(ec);
+            co_return http::route_done;
+        }
+    }
+
+    if(method == http::method::get)
+    {
+        tap.capture(cache_->config().max_entry,
+            [cache = cache_, &rp, url = std::move(url)](
+                core::string_view bytes)
+            {
+                store(*cache, rp, url, bytes);
+            });
+    }
+    co_return http::route_next;
+}
+
+} // beast2
+} // boost
@@ -0,0 +1,66 @@
+//
+// Copyright (c) 2026 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/beast2
+//
+
+#include <boost/beast2/response_tap.hpp>
+
+namespace boost {
+namespace beast2 {
+
+void
+response_tap::
+capture(
+    std::size_t limit,
+    std::function<void(core::string_view)> done)
+{
+    buf_.clear();
+    limit_ = limit;
+    done_ = std::move(done);
+    active_ = true;
+}
+
+void
+response_tap::
+complete()
+{
+    if(! active_)
+        return;
+    active_ = false;
+    auto done = std::move(done_);
+    done_ = nullptr;
+    if(done && ! buf_.empty())
+        done(buf_);
+    buf_.clear();
+}
+
+void
+response_tap::
+discard() noexcept
+{
+    active_ = false;
+    done_ = nullptr;
+    buf_.clear();
+}
+
+void
+response_tap::
+record(void const* data, std::size_t size)
+{
+    if(! active_)
+        return;
+    if(size > limit_ - buf_.size())
+    {
+        // too large to keep
+        discard();
+        return;
+    }
+    buf_.append(static_cast<char const*>(data), size);
+}
+
+} // beast2
+} // boost
@@ -0,0 +1,100 @@
+//
+// Copyright (c) 2026 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/beast2
+//
+
+#include <boost/beast2/send_file.hpp>
+#include <boost/beast2/request_arena.hpp>
+#include <boost/beast2/detail/request_slots.hpp>
+#include "src/detail/static_file.hpp"
+#include <boost/http/field.hpp>
+#include <boost/system/errc.hpp>
+
+#ifndef _WIN32
+# include <fcntl.h>
+# include <sys/stat.h>
+#endif
+
+namespace boost {
+namespace beast2 {
+
+capy::task<system::error_code>
+send_file(
+    http::route_params& rp,
+    int fd,
+    std::uint64_t offset,
+    std::uint64_t size)
+{
+    auto const s = detail::find_slots(rp);
+    if(! s || ! s->sender)
+        co_return system::errc::make_error_code(
+            system::errc::operation_not_supported);
+
+    rp.res.set_payload_size(size);
+    if(rp.req.method() == http::method::head)
+        size = 0;
+    co_return co_await s->sender->send(
+        rp.res.buffer(), fd, offset, size);
+}
+
+sendfile_static::
+sendfile_static(
+    core::string_view root,
+    std::uint64_t min_size)
+    : root_(root)
+    , min_size_(min_size)
+{
+    if(! root_.empty() && root_.back() == '/')
+        root_.pop_back();
+}
+
+http::route_task
+sendfile_static::
+operator()(http::route_params& rp) const
+{
+#ifdef _WIN32
+    (void)rp;
+    co_return http::route_next;
+#else
+    if( rp.req.method() != http::method::get &&
+        rp.req.method() != http::method::head)
+        co_return http::route_next;
+
+    // Ranges and revalidations are answered by the
+    // handler which follows
+    if(detail::is_partial_or_conditional(rp.req))
+        co_return http::route_next;
+
+    std::pmr::string path(get_arena(rp));
+    if(! detail::map_path(path, root_, rp.path))
+        co_return http::route_next;
+
+    detail::file_handle f{ ::open(path.c_str(), O_RDONLY | O_CLOEXEC) };
+    if(f.fd < 0)
+        co_return http::route_next;
+    struct ::stat st;
+    if( ::fstat(f.fd, &st) != 0 ||
+        ! S_ISREG(st.st_mode) ||
+        static_cast<std::uint64_t>(st.st_size) < min_size_)
+        co_return http::route_next;
+
+    rp.res.set(http::field::content_type, detail::content_type(path));
+    auto ec = co_await send_file(
+        rp, f.fd, 0, static_cast<std::uint64_t>(st.st_size));
+    if(ec == system::errc::operation_not_supported)
+    {
+        rp.res.erase(http::field::content_type);
+        co_return http::route_next;
+    }
+    if(ec)
+        co_return http::route_error(ec);
+    co_return http::route_done;
+#endif
+}
+
+} // beast2
+} // boost
@@ -0,0 +1,581 @@
+//
+// Copyright (c) 2026 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/beast2
+//
+
+#include <boost/beast2/serve_precompressed.hpp>
+#include <boost/beast2/request_arena.hpp>
+#include <boost/beast2/detail/request_slots.hpp>
+#include <boost/beast2/response_tap.hpp>
+#include <boost/beast2/send_file.hpp>
+#include "src/detail/static_file.hpp"
+#include "src/detail/string_util.hpp"
+#include <boost/capy/ex/system_context.hpp>
+#include <boost/http/field.hpp>
+#include <boost/system/errc.hpp>
+#ifdef BOOST_HTTP_HAS_BROTLI
+# include <boost/http/brotli/encode.hpp>
+#endif
+#ifdef BOOST_HTTP_HAS_ZLIB
+# include <boost/http/zlib/deflate.hpp>
+#endif
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <list>
+#include <memory_resource>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+
+#ifndef _WIN32
+# include <fcntl.h>
+# include <sys/stat.h>
+#endif
+
+namespace boost {
+namespace beast2 {
+
+namespace {
+
+using detail::iequals;
+using detail::to_lower;
+using detail::trim;
+
+// Parse a weight into thousandths, RFC 9110 section 12.4.2
+int
+parse_qvalue(core::string_view s) noexcept
+{
+    if(s.empty() || (s[0] != '0' && s[0] != '1'))
+        return -1;
+    int q = (s[0] - '0') * 1000;
+    s.remove_prefix(1);
+    if(s.empty())
+        return q;
+    if(s[0] != '.' || s.size() > 4)
+        return -1;
+    int scale = 100;
+    for(char c : s.substr(1))
+    {
+        if(c < '0' || c > '9')
+            return -1;
+        q += (c - '0') * scale;
+        scale /= 10;
+    }
+    return q > 1000 ? -1 : q;
+}
+
+core::string_view
+coding_name(content_coding c) noexcept
+{
+    switch(c)
+    {
+    case content_coding::br:
+        return "br";
+    case content_coding::gzip:
+        return "gzip";
+    default:
+        return "identity";
+    }
+}
+
+core::string_view
+sidecar_suffix(content_coding c) noexcept
+{
+    return c == content_coding::br ? ".br" : ".gz";
+}
+
+#ifdef BOOST_HTTP_HAS_BROTLI
+bool
+compress_br(
+    precompressed_config const& cfg,
+    core::string_view in,
+    std::string& out)
+{
+    auto* svc = capy::get_system_context().find_service<
+        http::brotli::encode_service>();
+    if(! svc)
+        return false;
+    std::size_t n = svc->max_compressed_size(in.size());
+    out.resize(n);
+    if(! svc->compress(
+        cfg.brotli_quality,
+        http::brotli::default_window,
+        http::brotli::encoder_mode::text,
+        in.size(),
+        reinterpret_cast<std::uint8_t const*>(in.data()),
+        &n,
+        reinterpret_cast<std::uint8_t*>(&out[0])))
+        return false;
+    out.resize(n);
+    return true;
+}
+#endif
+
+#ifdef BOOST_HTTP_HAS_ZLIB
+bool
+compress_gzip(
+    precompressed_config const& cfg,
+    core::string_view in,
+    std::string& out)
+{
+    auto* svc = capy::get_system_context().find_service<
+        http::zlib::deflate_service>();
+    if(! svc)
+        return false;
+    http::zlib::stream zs{};
+    // 16 added to the window bits selects the gzip wrapper
+    if(svc->init2(zs, cfg.gzip_level, http::zlib::deflated,
+        15 + 16, 8, http::zlib::default_strategy) != 0)
+        return false;
+    out.resize(svc->bound(zs, in.size()));
+    zs.next_in = reinterpret_cast<unsigned char const*>(in.data());
+    zs.avail_in = static_cast<unsigned>(in.size());
+    zs.next_out = reinterpret_cast<unsigned char*>(&out[0]);
+    zs.avail_out = static_cast<unsigned>(out.size());
+    auto const rc = svc->deflate(zs, http::zlib::finish);
+    svc->deflate_end(zs);
+    if(rc != http::zlib::stream_end)
+        return false;
+    out.resize(zs.total_out);
+    return true;
+}
+#endif
+
+// Compress with the service installed for a coding
+bool
+compress(
+    content_coding c,
+    precompressed_config const& cfg,
+    core::string_view in,
+    std::string& out)
+{
+#ifdef BOOST_HTTP_HAS_BROTLI
+    if(c == content_coding::br)
+        return compress_br(cfg, in, out);
+#endif
+#ifdef BOOST_HTTP_HAS_ZLIB
+    if(c == content_coding::gzip)
+        return compress_gzip(cfg, in, out);
+#endif
+    (void)c;
+    (void)cfg;
+    (void)in;
+    (void)out;
+    return false;
+}
+
+template<class String>
+bool
+read_file(
+    char const* path,
+    std::uintmax_t size,
+    String& out)
+{
+    std::ifstream f(path, std::ios::binary);
+    if(! f)
+        return false;
+    out.resize(static_cast<std::size_t>(size));
+    f.read(&out[0], static_cast<std::streamsize>(size));
+    return static_cast<std::uintmax_t>(f.gcount()) == size;
+}
+
+} // (anon)
+
+content_coding
+negotiate_encoding(
+    core::string_view accept_encoding,
+    content_coding* second) noexcept
+{
+    int q_br = -1;
+    int q_gzip = -1;
+    int q_any = -1;
+    while(! accept_encoding.empty())
+    {
+        auto const comma = accept_encoding.find(',');
+        auto elem = trim(accept_encoding.substr(0, comma));
+        accept_encoding.remove_prefix(
+            comma == core::string_view::npos ?
+                accept_encoding.size() : comma + 1);
+
+        int q = 1000;
+        auto const semi = elem.find(';');
+        if(semi != core::string_view::npos)
+        {
+            auto param = trim(elem.substr(semi + 1));
+            elem = trim(elem.substr(0, semi));
+            if( param.size() < 2 ||
+                to_lower(param[0]) != 'q' || param[1] != '=')
+                continue;
+            q = parse_qvalue(trim(param.substr(2)));
+            if(q < 0)
+                continue;
+        }
+        if(iequals(elem, "br"))
+            q_br = q;
+        else if(iequals(elem, "gzip") || iequals(elem, "x-gzip"))
+            q_gzip = q;
+        else if(elem == "*")
+            q_any = q;
+    }
+    if(q_br < 0)
+        q_br = q_any;
+    if(q_gzip < 0)
+        q_gzip = q_any;
+
+    content_coding first = content_coding::identity;
+    content_coding next = content_coding::identity;
+    if(q_br > 0 && q_br >= q_gzip)
+    {
+        first = content_coding::br;
+        if(q_gzip > 0)
+            next = content_coding::gzip;
+    }
+    else if(q_gzip > 0)
+    {
+        first = content_coding::gzip;
+        if(q_br > 0)
+            next = content_coding::br;
+    }
+    if(second)
+        *second = next;
+    return first;
+}
+
+//------------------------------------------------
+
+struct serve_precompressed::impl
+{
+    struct node
+    {
+        std::string key;
+        std::shared_ptr<std::string const> body;
+    };
+
+    // A file waiting to be compressed
+    struct job
+    {
+        std::string key;
+        std::string path;
+        std::uintmax_t size;
+        content_coding coding;
+    };
+
+    std::string root;
+    precompressed_config cfg;
+
+    std::mutex m;
+    std::list<node> lru; // most recent first
+    std::unordered_map<std::string, std::list<node>::iterator> index;
+    std::size_t bytes = 0;
+
+    // Compression runs on a thread of its own, so that
+    // a large file does not hold up the event loop. Each
+    // key is queued at most once.
+    std::condition_variable cv;
+    std::deque<job> jobs;
+    std::unordered_set<std::string> pending;
+    bool stop = false;
+    std::thread t;
+
+    impl(
+        core::string_view root_,
+        precompressed_config const& cfg_)
+        : root(root_)
+        , cfg(cfg_)
+    {
+    }
+
+    ~impl()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m);
+            stop = true;
+        }
+        cv.notify_one();
+        if(t.joinable())
+            t.join();
+    }
+
+    std::shared_ptr<std::string const>
+    find(std::string const& key)
+    {
+        std::lock_guard<std::mutex> lock(m);
+        auto const it = index.find(key);
+        if(it == index.end())
+            return nullptr;
+        lru.splice(lru.begin(), lru, it->second);
+        return it->second->body;
+    }
+
+    // Precondition: lock held
+    void
+    insert_locked(
+        std::string key,
+        std::shared_ptr<std::string const> body)
+    {
+        auto const cost = key.size() + body->size();
+        if(cost > cfg.max_cache_bytes)
+            return;
+        if(index.count(key) != 0)
+            return;
+        lru.push_front(node{ std::move(key), std::move(body) });
+        index.emplace(lru.front().key, lru.begin());
+        bytes += cost;
+        while(bytes > cfg.max_cache_bytes)
+        {
+            auto& n = lru.back();
+            bytes -= n.key.size() + n.body->size();
+            index.erase(n.key);
+            lru.pop_back();
+        }
+    }
+
+    void
+    insert(
+        std::string key,
+        std::shared_ptr<std::string const> body)
+    {
+        std::lock_guard<std::mutex> lock(m);
+        insert_locked(std::move(key), std::move(body));
+    }
+
+    // Queue a file for compression, unless it is
+    // already queued or the queue is full
+    void
+    enqueue(job j)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m);
+            if( stop ||
+                pending.size() >= cfg.max_pending ||
+                ! pending.insert(j.key).second)
+                return;
+            jobs.push_back(std::move(j));
+            if(! t.joinable())
+                t = std::thread([this]{ run(); });
+        }
+        cv.notify_one();
+    }
+
+    void
+    run()
+    {
+        std::unique_lock<std::mutex> lock(m);
+        for(;;)
+        {
+            cv.wait(lock, [this]{ return stop || ! jobs.empty(); });
+            if(stop)
+                return;
+            job j = std::move(jobs.front());
+            jobs.pop_front();
+            lock.unlock();
+
+            std::shared_ptr<std::string> body;
+            std::string plain;
+            if(read_file(j.path.c_str(), j.size, plain))
+            {
+                body = std::make_shared<std::string>();
+                if(! compress(j.coding, cfg, plain, *body))
+                    body.reset();
+            }
+
+            lock.lock();
+            pending.erase(j.key);
+            if(body)
+                insert_locked(std::move(j.key), std::move(body));
+        }
+    }
+
+    // Return the body for a coding, from a sidecar or
+    // the cache, or null. May send the response itself.
+    capy::task<std::shared_ptr<std::string const>>
+    body_for(
+        http::route_params& rp,
+        std::pmr::string const& path,
+        std::uintmax_t size,
+        std::int64_t mtime,
+        content_coding c,
+        bool& sent,
+        system::error_code& ec);
+};
+
+capy::task<std::shared_ptr<std::string const>>
+serve_precompressed::
+impl::
+body_for(
+    http::route_params& rp,
+    std::pmr::string const& path,
+    std::uintmax_t size,
+    std::int64_t mtime,
+    content_coding c,
+    bool& sent,
+    system::error_code& ec)
+{
+    namespace fs = std::filesystem;
+
+    std::string key(path.data(), path.size());
+    key.push_back('\0');
+    key.append(std::to_string(mtime));
+    key.push_back('\0');
+    key.append(coding_name(c));
+    if(auto body = find(key))
+        co_return body;
+
+    // A sidecar which cannot be used, or read, is
+    // skipped, and the file itself compressed instead
+    if(cfg.use_sidecars)
+    {
+        std::pmr::string side(path, get_arena(rp));
+        side.append(sidecar_suffix(c));
+        std::error_code fec;
+        auto const st = fs::status(side, fec);
+        auto const side_size = ! fec && fs::is_regular_file(st) &&
+            fs::last_write_time(side, fec)
+                .time_since_epoch().count() >= mtime && ! fec ?
+            fs::file_size(side, fec) : 0;
+        if(! fec && side_size > 0)
+        {
+#ifndef _WIN32
+            // large sidecars go out without a copy; once the
+            // header is written, an error is the connection's
+            detail::file_handle f{ ::open(side.c_str(), O_RDONLY | O_CLOEXEC) };
+            struct ::stat fst;
+            if( f.fd >= 0 &&
+                ::fstat(f.fd, &fst) == 0 &&
+                S_ISREG(fst.st_mode))
+            {
+                ec = co_await send_file(rp, f.fd, 0,
+                    static_cast<std::uint64_t>(fst.st_size));
+                if(ec != system::errc::operation_not_supported)
+                {
+                    sent = true;
+                    co_return nullptr;
+                }
+                ec = {};
+            }
+#endif
+            auto body = std::make_shared<std::string>();
+            if(read_file(side.c_str(), side_size, *body))
+            {
+                insert(std::move(key), body);
+                co_return body;
+            }
+        }
+    }
+
+    // Compressed off the event loop; this request, and
+    // any others until it is done, get the file as is
+    if(size <= cfg.max_file_size)
+        enqueue(job{ std::move(key),
+            std::string(path.data(), path.size()), size, c });
+    co_return nullptr;
+}
+
+serve_precompressed::
+serve_precompressed(
+    core::string_view root,
+    precompressed_config const& cfg)
+    : impl_(std::make_shared<impl>(root, cfg))
+{
+}
+
+http::route_task
+serve_precompressed::
+operator()(http::route_params& rp) const
+{
+    namespace fs = std::filesystem;
+
+    auto const method = rp.req.method();
+    if( method != http::method::get &&
+        method != http::method::head)
+        co_return http::route_next;
+
+    // Ranges and revalidations are answered by the
+    // handler which follows
+    if(detail::is_partial_or_conditional(rp.req))
+        co_return http::route_next;
+
+    content_coding second;
+    auto const first = negotiate_encoding(
+        rp.req.value_or(http::field::accept_encoding, ""),
+        &second);
+    if(first == content_coding::identity)
+        co_return http::route_next;
+
+    std::pmr::string path(get_arena(rp));
+    if(! detail::map_path(path, impl_->root, rp.path))
+        co_return http::route_next;
+    auto const type = detail::content_type(path);
+    if(! detail::is_compressible(type))
+        co_return http::route_next;
+
+    std::error_code fec;
+    auto const st = fs::status(path, fec);
+    if(fec || ! fs::is_regular_file(st))
+        co_return http::route_next;
+    auto const size = fs::file_size(path, fec);
+    if(fec)
+        co_return http::route_next;
+    auto const mtime = static_cast<std::int64_t>(
+        fs::last_write_time(path, fec).time_since_epoch().count());
+    if(fec)
+        co_return http::route_next;
+
+    for(auto c : { first, second })
+    {
+        if(c == content_coding::identity)
+            break;
+
+        // set before a sidecar may be sent directly
+        rp.res.set(http::field::content_type, type);
+        rp.res.set(http::field::content_encoding, coding_name(c));
+        rp.res.set(http::field::vary, "Accept-Encoding");
+
+        bool sent = false;
+        system::error_code ec;
+        auto body = co_await impl_->body_for(
+            rp, path, size, mtime, c, sent, ec);
+        if(ec)
+            co_return http::route_error(ec);
+        if(sent)
+            co_return http::route_done;
+        if(! body)
+            continue;
+
+        if(method == http::method::head)
+        {
+            // the header a GET would get
+            rp.res.set_payload_size(body->size());
+            auto const s = detail::find_slots(rp);
+            if(! s || ! s->tap)
+                break;
+            auto ec2 = co_await s->tap->write(rp.res.buffer());
+            if(ec2)
+                co_return http::route_error(ec2);
+            co_return http::route_done;
+        }
+
+        auto [ec2] = co_await rp.send(*body);
+        if(ec2)
+            co_return http::route_error(ec2);
+        co_return http::route_done;
+    }
+
+    // no coding is ready
+    rp.res.erase(http::field::content_type);
+    rp.res.erase(http::field::content_encoding);
+    rp.res.erase(http::field::vary);
+    co_return http::route_next;
+}
+
+} // beast2
+} // boost
@@ -0,0 +1,312 @@
+//
+// Copyright (c) 2026 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/beast2
+//
+
+#include <boost/beast2/sharded_http_server.hpp>
+#include "src/detail/connection_pool.hpp"
+#include <boost/http/server/flat_router.hpp>
+#include <boost/capy/ex/run_async.hpp>
+#include <boost/capy/task.hpp>
+#include <memory>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+# include <pthread.h>
+# include <sched.h>
+#elif defined(_WIN32)
+# include <windows.h>
+#endif
+
+namespace boost {
+namespace beast2 {
+
+namespace {
+
+// Return the CPUs which this process may run on, in
+// ascending order. In a cpuset or a container these
+// need not start at zero or be contiguous.
+std::vector<std::size_t>
+allowed_cpus()
+{
+    std::vector<std::size_t> v;
+#if defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if(::sched_getaffinity(0, sizeof(set), &set) == 0)
+    {
+        for(std::size_t i = 0; i < CPU_SETSIZE; ++i)
+            if(CPU_ISSET(i, &set))
+                v.push_back(i);
+        return v;
+    }
+#elif defined(_WIN32)
+    DWORD_PTR proc = 0;
+    DWORD_PTR sys = 0;
+    if(::GetProcessAffinityMask(
+        ::GetCurrentProcess(), &proc, &sys))
+    {
+        for(std::size_t i = 0; i < sizeof(DWORD_PTR) * 8; ++i)
+            if(proc & (DWORD_PTR(1) << i))
+                v.push_back(i);
+        return v;
+    }
+#endif
+    std::size_t const n =
+        std::thread::hardware_concurrency();
+    for(std::size_t i = 0; i < n; ++i)
+        v.push_back(i);
+    return v;
+}
+
+// Bind a thread to a single CPU
+std::error_code
+pin_to_cpu(
+    std::thread& t,
+    std::size_t cpu) noexcept
+{
+#if defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    int const ev = ::pthread_setaffinity_np(
+        t.native_handle(), sizeof(set), &set);
+    if(ev != 0)
+        return std::error_code(ev, std::system_category());
+#elif defined(_WIN32)
+    if(::SetThreadAffinityMask(
+        t.native_handle(), DWORD_PTR(1) << cpu) == 0)
+        return std::error_code(static_cast<int>(
+            ::GetLastError()), std::system_category());
+#else
+    (void)t;
+    (void)cpu;
+#endif
+    return {};
+}
+
+} // (anon)
+
+// A shard is a complete, independent server. The
+// io_context is declared first so that it outlives
+// the server and its workers.
+struct sharded_http_server::shard
+{
+    corosio::io_context ctx;
+    http_server srv;
+    std::thread t;
+
+    shard(
+        server_config const& cfg,
+        shared_router router,
+        http::shared_parser_config parser_cfg,
+        http::shared_serializer_config serializer_cfg)
+        : srv(
+            ctx,
+            cfg,
+            std::move(router),
+            std::move(parser_cfg),
+            std::move(serializer_cfg))
+    {
+    }
+};
+
+struct sharded_http_server::impl
+{
+    std::vector<std::unique_ptr<shard>> shards;
+    std::vector<std::size_t> cpus;
+    bool pin = false;
+};
+
+sharded_http_server::
+~sharded_http_server()
+{
+    delete impl_;
+}
+
+sharded_http_server::
+sharded_http_server(
+    std::size_t num_shards,
+    std::size_t num_workers,
+    http::flat_router router,
+    http::shared_parser_config parser_cfg,
+    http::shared_serializer_config serializer_cfg)
+    : sharded_http_server(
+        num_shards,
+        detail::fixed_config(num_workers),
+        shared_router(std::move(router)),
+        std::move(parser_cfg),
+        std::move(serializer_cfg))
+{
+}
+
+sharded_http_server::
+sharded_http_server(
+    std::size_t num_shards,
+    server_config const& cfg,
+    shared_router router,
+    http::shared_parser_config parser_cfg,
+    http::shared_serializer_config serializer_cfg)
+    : impl_(new impl)
+{
+    impl_->cpus = allowed_cpus();
+    std::size_t const ncpu = impl_->cpus.size();
+    if(num_shards == 0)
+        num_shards = ncpu > 0 ? ncpu : 1;
+
+    // Pinning more shards than cores would stack
+    // several event loops on one core.
+    impl_->pin = ncpu > 0 && num_shards <= ncpu;
+
+    impl_->shards.reserve(num_shards);
+    for(std::size_t i = 0; i < num_shards; ++i)
+        impl_->shards.push_back(std::make_unique<shard>(
+            cfg,
+            router, // read-only, shared by all shards
+            parser_cfg,
+            serializer_cfg));
+}
+
+std::size_t
+sharded_http_server::
+size() const noexcept
+{
+    return impl_->shards.size();
+}
+
+corosio::io_context&
+sharded_http_server::
+get_context(std::size_t i) noexcept
+{
+    return impl_->shards[i]->ctx;
+}
+
+http_server&
+sharded_http_server::
+get_server(std::size_t i) noexcept
+{
+    return impl_->shards[i]->srv;
+}
+
+void
+sharded_http_server::
+replace_router(http::flat_router router)
+{
+    shared_router sr(std::move(router));
+    for(auto& s : impl_->shards)
+        s->srv.replace_router(sr);
+}
+
+std::error_code
+sharded_http_server::
+bind(corosio::endpoint ep)
+{
+    for(auto& s : impl_->shards)
+    {
+        auto ec = s->srv.bind(ep, corosio::reuse_port(true));
+        if(ec)
+            return ec;
+    }
+    return {};
+}
+
+std::error_code
+sharded_http_server::
+start()
+{
+    // Shard i runs on the i-th CPU this process may
+    // use. A shard which cannot be pinned still runs.
+    std::error_code result;
+    for(std::size_t i = 0; i < impl_->shards.size(); ++i)
+    {
+        auto& s = *impl_->shards[i];
+        s.srv.start();
+        s.t = std::thread(
+            [p = &s]
+            {
+                p->ctx.run();
+            });
+        if(! impl_->pin)
+            continue;
+        auto ec = pin_to_cpu(s.t, impl_->cpus[i]);
+        if(ec && ! result)
+            result = ec;
+    }
+    return result;
+}
+
+void
+sharded_http_server::
+stop()
+{
+    // tcp_server::stop must run on the thread
+    // which owns the shard's event loop
+    for(auto& s : impl_->shards)
+    {
+        capy::run_async(s->ctx.get_executor())(
+            [](http_server& srv) -> capy::task<void>
+            {
+                srv.stop();
+                co_return;
+            }(s->srv));
+    }
+}
+
+void
+sharded_http_server::
+drain()
+{
+    for(auto& s : impl_->shards)
+        s->srv.drain();
+}
+
+connection_stats
+sharded_http_server::
+get_connection_stats() const noexcept
+{
+    connection_stats st;
+    for(auto& s : impl_->shards)
+    {
+        auto const si = s->srv.get_connection_stats();
+        st.live += si.live;
+        st.draining += si.draining;
+        st.stopping = st.stopping || si.stopping;
+    }
+    return st;
+}
+
+frame_pool_stats
+sharded_http_server::
+get_frame_stats() const noexcept
+{
+    frame_pool_stats st;
+    for(auto& s : impl_->shards)
+    {
+        auto const si = s->srv.get_frame_stats();
+        st.allocations += si.allocations;
+        st.heap_allocations += si.heap_allocations;
+        st.cached_bytes += si.cached_bytes;
+    }
+    return st;
+}
+
+void
+sharded_http_server::
+join()
+{
+    for(auto& s : impl_->shards)
+    {
+        if(s->t.joinable())
+            s->t.join();
+        s->srv.join();
+    }
+}
+
+} // beast2
+} // boost
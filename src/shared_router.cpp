@@ -0,0 +1,118 @@
+//
+// Copyright (c) 2026 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/beast2
+//
+
+#include <boost/beast2/shared_router.hpp>
+
+namespace boost {
+namespace beast2 {
+
+namespace {
+
+// make_shared places the control block immediately
+// before the object. Over-aligning the holder pushes
+// the router onto a fresh cache line, away from the
+// reference count which is written on every copy.
+struct alignas(64) router_holder
+{
+    http::flat_router fr;
+
+    explicit
+    router_holder(http::flat_router&& fr_)
+        : fr(std::move(fr_))
+    {
+    }
+};
+
+} // (anon)
+
+shared_router::
+shared_router(http::flat_router fr)
+{
+    auto sp = std::make_shared<router_holder>(std::move(fr));
+    p_ = std::shared_ptr<http::flat_router const>(sp, &sp->fr);
+}
+
+//------------------------------------------------
+
+// Immutable once published
+struct router_slot::node
+{
+    shared_router sr;
+    std::uint64_t version;
+};
+
+router_slot::
+~router_slot()
+{
+    delete current_.load(std::memory_order_relaxed);
+    for(auto p : retired_)
+        delete p;
+}
+
+router_slot::
+router_slot(shared_router sr)
+    : current_(new node{ std::move(sr), 1 })
+{
+}
+
+shared_router
+router_slot::
+get() const
+{
+    shared_router sr;
+    std::uint64_t version = 0;
+    refresh(sr, version);
+    return sr;
+}
+
+void
+router_slot::
+replace(shared_router sr)
+{
+    // freed after the lock is released
+    std::vector<node*> dead;
+    {
+        std::lock_guard<std::mutex> lock(m_);
+        retired_.reserve(retired_.size() + 1);
+        auto const v = version_.load(
+            std::memory_order_relaxed) + 1;
+        auto p = new node{ std::move(sr), v };
+        retired_.push_back(current_.exchange(p));
+        version_.store(v, std::memory_order_release);
+
+        // A reader which loads current_ after the
+        // exchange sees the new node. One which loaded
+        // it before is still counted in readers_, so
+        // while any are, the retired nodes are kept.
+        if(readers_.load() == 0)
+            dead.swap(retired_);
+    }
+    // the old tables, where these held their last
+    // handles, are destroyed outside the lock
+    for(auto p : dead)
+        delete p;
+}
+
+bool
+router_slot::
+refresh(
+    shared_router& sr,
+    std::uint64_t& version) const
+{
+    shared_router prev = std::move(sr);
+    readers_.fetch_add(1);
+    node const* p = current_.load();
+    sr = p->sr;
+    version = p->version;
+    readers_.fetch_sub(1, std::memory_order_release);
+    return true;
+}
+
+} // beast2
+} // boost
@@ -0,0 +1,364 @@
+//
+// Copyright (c) 2026 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/beast2
+//
+
+#include <boost/beast2/timer_wheel.hpp>
+#include <boost/capy/ex/execution_context.hpp>
+#include <boost/capy/ex/run_async.hpp>
+#include <boost/capy/task.hpp>
+#include <boost/corosio/timer.hpp>
+
+namespace boost {
+namespace beast2 {
+
+timer_wheel::
+~timer_wheel()
+{
+    for(auto& level : wheel_)
+    {
+        for(auto& b : level)
+        {
+            while(b.head)
+                unlink(*b.head);
+        }
+    }
+    while(overflow_.head)
+        unlink(*overflow_.head);
+    while(expired_.head)
+        unlink(*expired_.head);
+}
+
+timer_wheel::
+timer_wheel(
+    duration resolution,
+    std::function<void()> on_wake)
+    : base_(clock_type::now())
+    , res_(resolution.count() > 0 ?
+        resolution : duration(1))
+    , on_wake_(std::move(on_wake))
+{
+}
+
+std::size_t
+timer_wheel::
+size() const noexcept
+{
+    std::lock_guard<std::mutex> lock(m_);
+    return size_;
+}
+
+void
+timer_wheel::
+arm(entry& e, time_point expiry)
+{
+    if(e.owner_ && e.owner_ != this)
+        e.owner_->cancel(e);
+
+    bool wake;
+    {
+        std::lock_guard<std::mutex> lock(m_);
+        if(e.owner_)
+            unlink(e);
+
+        // round up to the next tick boundary
+        std::uint64_t tick = 0;
+        if(expiry > base_)
+        {
+            auto const d = expiry - base_;
+            tick = static_cast<std::uint64_t>(d / res_);
+            if(d % res_ != duration::zero())
+                ++tick;
+        }
+        if(tick <= now_)
+            tick = now_ + 1;
+        e.tick_ = tick;
+        wake = size_ == 0;
+        link(e);
+    }
+    if(wake && on_wake_)
+        on_wake_();
+}
+
+void
+timer_wheel::
+cancel(entry& e) noexcept
+{
+    std::lock_guard<std::mutex> lock(m_);
+    if(e.owner_ == this)
+        unlink(e);
+}
+
+std::size_t
+timer_wheel::
+advance(time_point now)
+{
+    std::uint64_t target = 0;
+    if(now > base_)
+        target = static_cast<std::uint64_t>((now - base_) / res_);
+
+    {
+        std::lock_guard<std::mutex> lock(m_);
+        if(size_ == 0)
+        {
+            // nothing to visit on the way
+            if(now_ < target)
+                now_ = target;
+        }
+        else if(target > now_ && target - now_ > slots)
+        {
+            jump(target);
+        }
+        else
+        {
+            while(now_ < target)
+            {
+                ++now_;
+                if((now_ & (slots - 1)) == 0)
+                    cascade(1);
+                expire(wheel_[0][now_ & (slots - 1)]);
+            }
+        }
+    }
+
+    // Handlers run without the lock, so that they may
+    // arm and cancel. Each entry is taken off the list
+    // before its handler is called.
+    std::size_t n = 0;
+    for(;;)
+    {
+        entry* e;
+        {
+            std::lock_guard<std::mutex> lock(m_);
+            e = expired_.head;
+            if(! e)
+                break;
+            unlink(*e);
+        }
+        ++n;
+        if(e->on_expire)
+            e->on_expire();
+    }
+    return n;
+}
+
+// Precondition: lock held, e is not linked
+void
+timer_wheel::
+push(bucket& b, entry& e) noexcept
+{
+    e.prev_ = nullptr;
+    e.next_ = b.head;
+    if(b.head)
+        b.head->prev_ = &e;
+    b.head = &e;
+    e.bucket_ = &b;
+    e.owner_ = this;
+    ++size_;
+}
+
+// Precondition: lock held, e is not linked
+void
+timer_wheel::
+link(entry& e) noexcept
+{
+    std::uint64_t const delta = e.tick_ - now_;
+    if(delta > max_delta)
+    {
+        push(overflow_, e);
+        return;
+    }
+    unsigned level = 0;
+    while(delta >= (std::uint64_t(1) << (bits * (level + 1))))
+        ++level;
+    push(wheel_[level][
+        (e.tick_ >> (bits * level)) & (slots - 1)], e);
+}
+
+// Precondition: lock held, e.owner_ == this
+void
+timer_wheel::
+unlink(entry& e) noexcept
+{
+    if(e.prev_)
+        e.prev_->next_ = e.next_;
+    else
+        e.bucket_->head = e.next_;
+    if(e.next_)
+        e.next_->prev_ = e.prev_;
+    e.prev_ = nullptr;
+    e.next_ = nullptr;
+    e.bucket_ = nullptr;
+    e.owner_ = nullptr;
+    --size_;
+}
+
+// Redistribute the current slot of a level into the
+// levels below. Called when all lower levels wrap.
+// When the top level wraps, the overflow list is
+// redistributed, and entries which now fit move
+// onto the wheel.
+void
+timer_wheel::
+cascade(unsigned level) noexcept
+{
+    bucket* b = &overflow_;
+    if(level < levels)
+    {
+        auto const idx =
+            (now_ >> (bits * level)) & (slots - 1);
+        if(idx == 0)
+            cascade(level + 1);
+        b = &wheel_[level][idx];
+    }
+    entry* p = b->head;
+    b->head = nullptr;
+    while(p)
+    {
+        entry* next = p->next_;
+        --size_;
+        link(*p);
+        p = next;
+    }
+}
+
+// Move to a tick far ahead. Every entry is taken off
+// the wheel and filed again relative to the new time,
+// which costs one pass over the entries however many
+// ticks were missed.
+void
+timer_wheel::
+jump(std::uint64_t target) noexcept
+{
+    entry* all = nullptr;
+    auto const take = [&](bucket& b)
+    {
+        while(b.head)
+        {
+            entry& e = *b.head;
+            unlink(e);
+            e.next_ = all;
+            all = &e;
+        }
+    };
+    for(auto& level : wheel_)
+        for(auto& b : level)
+            take(b);
+    take(overflow_);
+
+    now_ = target;
+    while(all)
+    {
+        entry* next = all->next_;
+        all->next_ = nullptr;
+        if(all->tick_ <= now_)
+            push(expired_, *all);
+        else
+            link(*all);
+        all = next;
+    }
+}
+
+// Move every entry of a slot to the expired list
+void
+timer_wheel::
+expire(bucket& b) noexcept
+{
+    while(b.head)
+    {
+        entry& e = *b.head;
+        unlink(e);
+        push(expired_, e);
+    }
+}
+
+//------------------------------------------------
+
+namespace {
+
+// Owns the wheel of one io_context and drives it with
+// a single timer, which only runs while entries are
+// armed, so an idle server does not wake up.
+class timer_wheel_service
+    : public capy::execution_context::service
+{
+public:
+    using key_type = timer_wheel_service;
+
+    explicit
+    timer_wheel_service(capy::execution_context& ctx)
+        : ctx_(static_cast<corosio::io_context&>(ctx))
+        , wheel_(
+            std::chrono::milliseconds(100),
+            [this]{ wake(); })
+        , timer_(ctx_)
+    {
+    }
+
+    timer_wheel&
+    wheel() noexcept
+    {
+        return wheel_;
+    }
+
+    void
+    shutdown() override
+    {
+        std::lock_guard<std::mutex> lock(m_);
+        stopped_ = true;
+        timer_.cancel();
+    }
+
+private:
+    void
+    wake()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_);
+            if(running_ || stopped_)
+                return;
+            running_ = true;
+        }
+        capy::run_async(ctx_.get_executor())(run());
+    }
+
+    capy::task<void>
+    run()
+    {
+        for(;;)
+        {
+            timer_.expires_after(wheel_.resolution());
+            auto [ec] = co_await timer_.wait();
+            wheel_.advance(timer_wheel::clock_type::now());
+
+            std::lock_guard<std::mutex> lock(m_);
+            if(ec || stopped_ || wheel_.size() == 0)
+            {
+                running_ = false;
+                co_return;
+            }
+        }
+    }
+
+    corosio::io_context& ctx_;
+    std::mutex m_;
+    timer_wheel wheel_;
+    corosio::timer timer_;
+    bool running_ = false;
+    bool stopped_ = false;
+};
+
+} // (anon)
+
+timer_wheel&
+use_timer_wheel(corosio::io_context& ctx)
+{
+    return ctx.use_service<timer_wheel_service>().wheel();
+}
+
+} // beast2
+} // boost
@@ -0,0 +1,88 @@
+//
+// Copyright (c) 2026 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/beast2
+//
+
+// Test that header file is self-contained.
+#include <boost/beast2/admission_controller.hpp>
+
+#include "test_suite.hpp"
+
+namespace boost {
+namespace beast2 {
+
+struct admission_controller_test
+{
+    using clock_type = admission_controller::clock_type;
+
+    void
+    testCodel()
+    {
+        using ms = std::chrono::milliseconds;
+
+        admission_config cfg;
+        cfg.enabled = true;
+        cfg.target = ms(5);
+        cfg.interval = ms(100);
+        admission_controller ac(cfg);
+
+        auto const t0 = clock_type::time_point() + std::chrono::hours(1);
+
+        // a short burst above target is admitted
+        BOOST_TEST(ac.admit(ms(1), t0));
+        BOOST_TEST(ac.admit(ms(20), t0));
+        BOOST_TEST(ac.admit(ms(20), t0 + ms(50)));
+        BOOST_TEST(! ac.get_stats().dropping);
+
+        // above target for a whole interval sheds
+        BOOST_TEST(! ac.admit(ms(20), t0 + ms(100)));
+        BOOST_TEST(ac.get_stats().dropping);
+        BOOST_TEST(! ac.admit(ms(6), t0 + ms(101)));
+
+        // one arrival below target ends the overload
+        BOOST_TEST(ac.admit(ms(4), t0 + ms(102)));
+        BOOST_TEST(! ac.get_stats().dropping);
+        BOOST_TEST(ac.admit(ms(20), t0 + ms(103)));
+
+        auto const st = ac.get_stats();
+        BOOST_TEST_EQ(st.admitted, 5u);
+        BOOST_TEST_EQ(st.shed, 2u);
+
+        ac.shed();
+        BOOST_TEST_EQ(ac.get_stats().admitted, 4u);
+        BOOST_TEST_EQ(ac.get_stats().shed, 3u);
+    }
+
+    void
+    testDisabled()
+    {
+        // shedding is opt-in
+        admission_config cfg;
+        BOOST_TEST(! cfg.enabled);
+        BOOST_TEST_EQ(cfg.shed_workers, 0u);
+        admission_controller ac(cfg);
+        auto const t0 = clock_type::now();
+        BOOST_TEST(ac.admit(std::chrono::seconds(10), t0));
+        BOOST_TEST(ac.admit(std::chrono::seconds(10),
+            t0 + std::chrono::seconds(10)));
+        BOOST_TEST_EQ(ac.get_stats().shed, 0u);
+    }
+
+    void
+    run()
+    {
+        testCodel();
+        testDisabled();
+    }
+};
+
+TEST_SUITE(
+    admission_controller_test,
+    "boost.beast2.admission_controller");
+
+} // beast2
+} // boost
@@ -0,0 +1,159 @@
+//
+// Copyright (c) 2026 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/beast2
+//
+
+// Test that header file is self-contained.
+#include <boost/beast2/body_writer.hpp>
+
+#include <boost/beast2/format.hpp>
+#include <boost/capy/test/buffer_sink.hpp>
+#include <boost/capy/test/fuse.hpp>
+#include <boost/capy/test/run_blocking.hpp>
+
+#include "test_suite.hpp"
+
+#include <string>
+
+namespace boost {
+namespace beast2 {
+
+struct body_writer_test
+{
+    // Run a task to completion on this thread
+    static
+    system::error_code
+    complete(capy::task<system::error_code> t)
+    {
+        system::error_code ec;
+        capy::test::run_blocking(
+            [&](system::error_code e)
+            {
+                ec = e;
+            })(std::move(t));
+        return ec;
+    }
+
+    void
+    testChunked()
+    {
+        capy::test::fuse f;
+        capy::test::buffer_sink bs(f);
+        http::route_params rp;
+        rp.res_body = capy::any_buffer_sink(&bs);
+
+        body_writer w(rp);
+        BOOST_TEST(rp.res.chunked());
+        format_to(w, "hello {}", "world");
+        BOOST_TEST(! complete(w.flush()));
+        BOOST_TEST_EQ(bs.data(), "hello world");
+        BOOST_TEST(! bs.eof_called());
+        format_to(w, "{}", 42);
+        BOOST_TEST(! complete(w.finish()));
+        BOOST_TEST_EQ(bs.data(), "hello world42");
+        BOOST_TEST(bs.eof_called());
+    }
+
+    void
+    testSpill()
+    {
+        // the sink prepares 8 bytes at a time
+        capy::test::fuse f;
+        capy::test::buffer_sink bs(f, 8);
+        http::route_params rp;
+        rp.res_body = capy::any_buffer_sink(&bs);
+
+        body_writer w(rp);
+        BOOST_TEST(! w.full());
+        std::string const s(20, 'x');
+        w.append(s.data(), s.size());
+        BOOST_TEST(w.full());
+
+        // flush writes what was held back
+        BOOST_TEST(! complete(w.flush()));
+        BOOST_TEST(! w.full());
+        BOOST_TEST_EQ(bs.data(), s);
+        BOOST_TEST(! complete(w.finish()));
+        BOOST_TEST_EQ(bs.data(), s);
+    }
+
+    void
+    testContentLength()
+    {
+        // exact
+        {
+            capy::test::fuse f;
+            capy::test::buffer_sink bs(f);
+            http::route_params rp;
+            rp.res_body = capy::any_buffer_sink(&bs);
+            body_writer w(rp, 5);
+            BOOST_TEST(! rp.res.chunked());
+            BOOST_TEST_EQ(rp.res.payload_size(), 5u);
+            format_to(w, "abcde");
+            BOOST_TEST(! complete(w.finish()));
+            BOOST_TEST_EQ(bs.data(), "abcde");
+        }
+
+        // short
+        {
+            capy::test::fuse f;
+            capy::test::buffer_sink bs(f);
+            http::route_params rp;
+            rp.res_body = capy::any_buffer_sink(&bs);
+            body_writer w(rp, 5);
+            format_to(w, "abc");
+            BOOST_TEST(complete(w.finish()) ==
+                error::body_length_mismatch);
+            BOOST_TEST(! bs.eof_called());
+        }
+
+        // long, the excess is never written
+        {
+            capy::test::fuse f;
+            capy::test::buffer_sink bs(f);
+            http::route_params rp;
+            rp.res_body = capy::any_buffer_sink(&bs);
+            body_writer w(rp, 5);
+            format_to(w, "abcdefg");
+            BOOST_TEST(complete(w.flush()) ==
+                error::body_length_mismatch);
+            BOOST_TEST(bs.data().size() <= 5u);
+        }
+    }
+
+    void
+    testHead()
+    {
+        capy::test::fuse f;
+        capy::test::buffer_sink bs(f);
+        http::route_params rp;
+        rp.req.set_start_line(
+            http::method::head, "/", http::version::http_1_1);
+        rp.res_body = capy::any_buffer_sink(&bs);
+
+        // the length of the body a GET would get
+        body_writer w(rp, 5);
+        BOOST_TEST_EQ(rp.res.payload_size(), 5u);
+        BOOST_TEST(! complete(w.finish()));
+        BOOST_TEST(bs.data().empty());
+    }
+
+    void
+    run()
+    {
+        static_assert(format_sink<body_writer>);
+        testChunked();
+        testSpill();
+        testContentLength();
+        testHead();
+    }
+};
+
+TEST_SUITE(body_writer_test, "boost.beast2.body_writer");
+
+} // beast2
+} // boost
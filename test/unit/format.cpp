@@ -12,6 +12,12 @@
 
 #include "test_suite.hpp"
 
+#include <limits>
+#include <memory_resource>
+#include <sstream>
+#include <string>
+#include <type_traits>
+
 namespace boost {
 namespace beast2 {
 
@@ -37,8 +43,102 @@ struct format_test
         BOOST_TEST_THROWS(f(match, fs, args...), std::invalid_argument);
     }
 
+    template<class... Args>
+    std::string
+    lit(
+        format_string<std::type_identity_t<Args>...> fs,
+        Args const&... args)
+    {
+        BOOST_TEST(fs.checked());
+        std::string s;
+        format_to(s, fs, args...);
+        return s;
+    }
+
+    void
+    testTypes()
+    {
+        std::string const str = "str";
+        char const* cs = "cs";
+        char const* null = nullptr;
+        BOOST_TEST_EQ(lit("{} {} {} {}", 42, -7, 0u, 1234567890123ll),
+            "42 -7 0 1234567890123");
+        BOOST_TEST_EQ(lit("{} {}", true, false), "1 0");
+        BOOST_TEST_EQ(lit("{} {} {}", 'c', str, cs), "c str cs");
+        BOOST_TEST_EQ(lit("{}", null), "(null)");
+        BOOST_TEST_EQ(lit("{} {} {}", 2.5, 0.1, 1.0 / 3), "2.5 0.1 0.333333");
+        BOOST_TEST_EQ(lit("{} {}", 1e20, 100000.0), "1e+20 100000");
+        BOOST_TEST_EQ(lit("{}", core::string_view("sv")), "sv");
+        BOOST_TEST_EQ(lit("{}", std::numeric_limits<long long>::min()),
+            "-9223372036854775808");
+        BOOST_TEST_EQ(lit("{}", (void const*)0x1f), "0x1f");
+
+        // a literal is parsed at compile time,
+        // any other string when it is used
+        core::string_view fs = "{}";
+        BOOST_TEST(! format_string<int>(fs).checked());
+    }
+
+    void
+    testSpecs()
+    {
+        BOOST_TEST_EQ(lit("[{:5}]", 42), "[   42]");
+        BOOST_TEST_EQ(lit("[{:<5}]", 42), "[42   ]");
+        BOOST_TEST_EQ(lit("[{:^6}]", 42), "[  42  ]");
+        BOOST_TEST_EQ(lit("[{:*>5}]", 42), "[***42]");
+        BOOST_TEST_EQ(lit("[{:05}]", -42), "[-0042]");
+        BOOST_TEST_EQ(lit("[{:5}]", "ab"), "[ab   ]");
+        BOOST_TEST_EQ(lit("[{:>5}]", "ab"), "[   ab]");
+        BOOST_TEST_EQ(lit("[{:.2}]", "abcd"), "[ab]");
+        BOOST_TEST_EQ(lit("{:x} {:X} {:o} {:b}", 255, 255, 8, 5),
+            "ff FF 10 101");
+        BOOST_TEST_EQ(lit("{:#x} {:#010x} {:#b}", 255, 255, 5),
+            "0xff 0x000000ff 0b101");
+        BOOST_TEST_EQ(lit("{:x}", -255), "-ff");
+        BOOST_TEST_EQ(lit("{:d} {:c}", 'A', 'A'), "65 A");
+        BOOST_TEST_EQ(lit("{:.3f} {:e} {:E}", 3.14159, 1500.0, 1500.0),
+            "3.142 1.500000e+03 1.500000E+03");
+        BOOST_TEST_EQ(lit("[{:8.2f}]", 3.14159), "[    3.14]");
+        BOOST_TEST_EQ(lit("[{:08.2f}]", -3.14159), "[-0003.14]");
+        BOOST_TEST_EQ(lit("{:.0f}", 1e300).size(), 301u);
+        BOOST_TEST_EQ(lit("{{{}}}", 1), "{1}");
+
+        // bad specs in runtime strings
+        e("", "{:x}", "str");
+        e("", "{:.2}", 1);
+        e("", "{:#}", 1.5);
+        e("", "{:q}", 1);
+        e("", "{:.}", 1.5);
+        e("", "{x}", 1);
+    }
+
+    void
+    testSinks()
+    {
+        // a buffer
+        char buf[8];
+        BOOST_TEST_EQ(format_to(buf, sizeof(buf), "{}-{}", 12, 34), 5u);
+        BOOST_TEST(core::string_view(buf, 5) == "12-34");
+        BOOST_TEST_EQ(format_to(buf, 4, "{}", 123456), 6u);
+        BOOST_TEST(core::string_view(buf, 4) == "1234");
+
+        // a stream
+        std::ostringstream os;
+        format_to(os, "{} {:>3}", "a", 1);
+        BOOST_TEST_EQ(os.str(), "a   1");
+
+        // any string with append
+        std::pmr::string ps;
+        format_to(ps, "{}", 42);
+        BOOST_TEST(ps == "42");
+    }
+
     void run()
     {
+        testTypes();
+        testSpecs();
+        testSinks();
+
         // Bad format strings, string arg.
         e("{}",     "{}");
         e("{",      "{");
@@ -0,0 +1,146 @@
+//
+// Copyright (c) 2026 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/beast2
+//
+
+// Test that header file is self-contained.
+#include <boost/beast2/frame_pool.hpp>
+
+#include "src/detail/frame_totals.hpp"
+
+#include "test_suite.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace boost {
+namespace beast2 {
+
+struct frame_pool_test
+{
+    void
+    testRecycle()
+    {
+        frame_pool fp;
+        void* p = fp.allocate(100);
+        fp.deallocate(p, 100);
+
+        // same size class, same block
+        BOOST_TEST(fp.allocate(120) == p);
+        fp.deallocate(p, 120);
+
+        auto const st = fp.get_stats();
+        BOOST_TEST_EQ(st.allocations, 2u);
+        BOOST_TEST_EQ(st.heap_allocations, 1u);
+        BOOST_TEST_EQ(st.cached_bytes, 128u);
+    }
+
+    void
+    testSteadyState()
+    {
+        // A few frames of various sizes live at
+        // once, as in a chain of awaiting handlers
+        std::size_t const sizes[] = { 48, 200, 700, 200, 3000 };
+        frame_pool fp;
+        std::vector<void*> v;
+        auto round = [&]
+        {
+            for(auto n : sizes)
+                v.push_back(fp.allocate(n));
+            for(std::size_t i = v.size(); i-- > 0;)
+                fp.deallocate(v[i], sizes[i]);
+            v.clear();
+        };
+
+        round();
+        auto const warm = fp.get_stats().heap_allocations;
+        BOOST_TEST_EQ(warm, 5u);
+        for(int i = 0; i < 1000; ++i)
+            round();
+        auto const st = fp.get_stats();
+        BOOST_TEST_EQ(st.heap_allocations, warm);
+        BOOST_TEST_EQ(st.allocations, 5005u);
+    }
+
+    void
+    testLarge()
+    {
+        frame_pool fp;
+        void* p = fp.allocate(frame_pool::max_size + 1);
+        fp.deallocate(p, frame_pool::max_size + 1);
+        BOOST_TEST_EQ(fp.get_stats().cached_bytes, 0u);
+
+        // extended alignment bypasses the lists
+        void* q = fp.allocate(64, 64);
+        BOOST_TEST_EQ(
+            reinterpret_cast<std::uintptr_t>(q) % 64, 0u);
+        fp.deallocate(q, 64, 64);
+        BOOST_TEST_EQ(fp.get_stats().cached_bytes, 0u);
+        BOOST_TEST_EQ(fp.get_stats().heap_allocations, 2u);
+    }
+
+    void
+    testMaxCached()
+    {
+        frame_pool fp(1);
+        void* p0 = fp.allocate(64);
+        void* p1 = fp.allocate(64);
+        fp.deallocate(p0, 64);
+        fp.deallocate(p1, 64);
+        BOOST_TEST_EQ(fp.get_stats().cached_bytes, 64u);
+        fp.release();
+        BOOST_TEST_EQ(fp.get_stats().cached_bytes, 0u);
+    }
+
+    void
+    testTotals()
+    {
+        detail::frame_totals t;
+        frame_pool_stats last0;
+        frame_pool_stats last1;
+        {
+            frame_pool fp0;
+            frame_pool fp1;
+            fp0.deallocate(fp0.allocate(64), 64);
+            fp1.deallocate(fp1.allocate(128), 128);
+            t.report(fp0, last0);
+            t.report(fp1, last1);
+            BOOST_TEST_EQ(t.get().allocations, 2u);
+            BOOST_TEST_EQ(t.get().heap_allocations, 2u);
+            BOOST_TEST_EQ(t.get().cached_bytes, 192u);
+
+            // only the change is added
+            fp0.deallocate(fp0.allocate(64), 64);
+            fp1.release();
+            t.report(fp0, last0);
+            t.report(fp1, last1);
+            BOOST_TEST_EQ(t.get().allocations, 3u);
+            BOOST_TEST_EQ(t.get().heap_allocations, 2u);
+            BOOST_TEST_EQ(t.get().cached_bytes, 64u);
+        }
+        t.forget(last0);
+        t.forget(last1);
+        BOOST_TEST_EQ(t.get().cached_bytes, 0u);
+    }
+
+    void
+    run()
+    {
+        testRecycle();
+        testSteadyState();
+        testLarge();
+        testMaxCached();
+        testTotals();
+    }
+};
+
+TEST_SUITE(
+    frame_pool_test,
+    "boost.beast2.frame_pool");
+
+} // beast2
+} // boost
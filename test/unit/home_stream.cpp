@@ -0,0 +1,188 @@
+//
+// Copyright (c) 2026 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/beast2
+//
+
+// Test that header file is self-contained.
+#include "src/detail/home_stream.hpp"
+
+#include <boost/capy/ex/run_async.hpp>
+#include <boost/capy/ex/thread_pool.hpp>
+
+#include "test_suite.hpp"
+
+#include <algorithm>
+#include <future>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace boost {
+namespace beast2 {
+
+struct home_stream_test
+{
+    // Records the thread each operation runs on
+    struct thread_stream
+    {
+        std::vector<std::thread::id> threads;
+        std::string in = "hello";
+        std::string out;
+
+        capy::task<capy::io_result<std::size_t>>
+        read_some(capy::mutable_buffer b)
+        {
+            threads.push_back(std::this_thread::get_id());
+            auto const n = (std::min)(b.size(), in.size());
+            in.copy(static_cast<char*>(b.data()), n);
+            in.erase(0, n);
+            co_return { system::error_code(), n };
+        }
+
+        capy::task<capy::io_result<std::size_t>>
+        write_some(capy::const_buffer b)
+        {
+            threads.push_back(std::this_thread::get_id());
+            out.append(static_cast<char const*>(b.data()), b.size());
+            co_return { system::error_code(), b.size() };
+        }
+    };
+
+    using home_socket = detail::home_stream<
+        thread_stream, capy::thread_pool::executor_type>;
+
+    struct result
+    {
+        std::thread::id before;
+        std::thread::id away;
+        std::thread::id after;
+        system::error_code ec;
+        std::string got;
+        std::promise<void> done;
+    };
+
+    // Plays the part of the TLS handshake
+    static
+    capy::task<std::thread::id>
+    handshake(
+        home_socket& s,
+        result& r)
+    {
+        char buf[16];
+        auto [ec, n] = co_await s.read_some(
+            capy::mutable_buffer(buf, sizeof(buf)));
+        r.ec = ec;
+        r.got.assign(buf, n);
+        if(! ec)
+        {
+            auto [ec2, n2] = co_await s.write_some(
+                capy::const_buffer("world", 5));
+            r.ec = ec2;
+            (void)n2;
+        }
+        co_return std::this_thread::get_id();
+    }
+
+    // Runs on the connection's executor, as a session does
+    static
+    capy::task<void>
+    session(
+        home_socket& s,
+        capy::thread_pool& pool,
+        result& r)
+    {
+        r.before = std::this_thread::get_id();
+        s.away = true;
+        r.away = co_await capy::run(
+            pool.get_executor())(handshake(s, r));
+        s.away = false;
+        r.after = std::this_thread::get_id();
+        r.done.set_value();
+    }
+
+    void
+    testAway()
+    {
+        capy::thread_pool conn(1);
+        capy::thread_pool pool(1);
+        thread_stream ts;
+        home_socket s(ts, conn.get_executor());
+        result r;
+        capy::run_async(conn.get_executor())(session(s, pool, r));
+        r.done.get_future().wait();
+
+        // the handshake ran on the pool, its I/O did not,
+        // and the session resumed where it started
+        BOOST_TEST(! r.ec);
+        BOOST_TEST(r.away != r.before);
+        BOOST_TEST(r.after == r.before);
+        BOOST_TEST_EQ(ts.threads.size(), 2u);
+        for(auto const& id : ts.threads)
+            BOOST_TEST(id == r.before);
+        BOOST_TEST_EQ(r.got, "hello");
+        BOOST_TEST_EQ(ts.out, "world");
+    }
+
+    void
+    testExpired()
+    {
+        capy::thread_pool conn(1);
+        capy::thread_pool pool(1);
+        thread_stream ts;
+        home_socket s(ts, conn.get_executor());
+
+        // the deadline fired while no operation was pending
+        s.expired = true;
+        result r;
+        capy::run_async(conn.get_executor())(session(s, pool, r));
+        r.done.get_future().wait();
+
+        BOOST_TEST(r.ec == system::errc::operation_canceled);
+        BOOST_TEST(ts.threads.empty());
+        BOOST_TEST(r.after == r.before);
+    }
+
+    void
+    testRebind()
+    {
+        capy::thread_pool conn(1);
+        capy::thread_pool pool(1);
+        thread_stream ts1;
+        thread_stream ts2;
+        home_socket s(ts1, conn.get_executor());
+
+        // the previous connection's deadline fired
+        s.expired = true;
+        s.rebind(ts2);
+        BOOST_TEST(! s.expired);
+        result r;
+        capy::run_async(conn.get_executor())(session(s, pool, r));
+        r.done.get_future().wait();
+
+        // the next connection's socket is used
+        BOOST_TEST(! r.ec);
+        BOOST_TEST(ts1.threads.empty());
+        BOOST_TEST_EQ(ts2.threads.size(), 2u);
+        BOOST_TEST_EQ(r.got, "hello");
+        BOOST_TEST_EQ(ts2.out, "world");
+    }
+
+    void
+    run()
+    {
+        testAway();
+        testExpired();
+        testRebind();
+    }
+};
+
+TEST_SUITE(
+    home_stream_test,
+    "boost.beast2.home_stream");
+
+} // beast2
+} // boost
@@ -0,0 +1,179 @@
+//
+// Copyright (c) 2026 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/beast2
+//
+
+// Test that header file is self-contained.
+#include <boost/beast2/html_template.hpp>
+
+#include <boost/capy/test/buffer_sink.hpp>
+#include <boost/capy/test/fuse.hpp>
+#include <boost/capy/test/run_blocking.hpp>
+
+#include "test_suite.hpp"
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace boost {
+namespace beast2 {
+
+struct html_template_test
+{
+    void
+    testRender()
+    {
+        html_template const t(
+            "<h1>{{ title }}</h1>{{{raw}}}\n"
+            "<ul>{{#items}}<li>{{item}}:{{n}}</li>{{/items}}</ul>");
+        BOOST_TEST_EQ(t.slots(), 5u);
+        auto const title = t.slot("title");
+        auto const raw = t.slot("raw");
+        auto const items = t.slot("items");
+        auto const item = t.slot("item");
+        auto const n = t.slot("n");
+
+        std::vector<std::string> const v = { "a", "<b&c>" };
+        std::string s;
+        t.render(s,
+            [&](std::size_t slot, std::size_t row, html_writer& w)
+            {
+                if(slot == items)
+                    return row < v.size();
+                if(slot == title)
+                    w.text("x\"y'");
+                else if(slot == raw)
+                    w.text("<br>");
+                else if(slot == item)
+                    w.text(v[row]);
+                else if(slot == n)
+                    format_to(w, "{:02}", row);
+                return false;
+            });
+        BOOST_TEST_EQ(s,
+            "<h1>x&quot;y&#39;</h1><br>\n"
+            "<ul><li>a:00</li><li>&lt;b&amp;c&gt;:01</li></ul>");
+    }
+
+    void
+    testNested()
+    {
+        html_template const t(
+            "{{#rows}}[{{#cols}}{{v}}{{/cols}}]{{/rows}}");
+        auto const rows = t.slot("rows");
+        auto const cols = t.slot("cols");
+        std::size_t r0 = 0;
+        std::string s;
+        t.render(s,
+            [&](std::size_t slot, std::size_t row, html_writer& w)
+            {
+                if(slot == rows)
+                {
+                    r0 = row;
+                    return row < 3;
+                }
+                if(slot == cols)
+                    return row < r0;
+                format_to(w, "{}", row);
+                return false;
+            });
+        BOOST_TEST_EQ(s, "[][0][01]");
+
+        // an empty section renders nothing
+        s.clear();
+        t.render(s,
+            [](std::size_t, std::size_t, html_writer&)
+            {
+                return false;
+            });
+        BOOST_TEST_EQ(s, "");
+    }
+
+    void
+    testBody()
+    {
+        // the sink prepares 8 bytes at a time
+        capy::test::fuse f;
+        capy::test::buffer_sink bs(f, 8);
+        http::route_params rp;
+        rp.res_body = capy::any_buffer_sink(&bs);
+        body_writer bw(rp);
+
+        html_template const t(
+            "<ul>{{#rows}}<li>{{\tv\t}}</li>{{/rows}}</ul>");
+        auto const rows = t.slot("rows");
+        std::string expect = "<ul>";
+        for(int i = 0; i < 100; ++i)
+            expect += "<li>" + std::to_string(i) + "</li>";
+        expect += "</ul>";
+
+        // each row starts with the previous one flushed
+        bool held = false;
+        system::error_code ec;
+        capy::test::run_blocking(
+            [&](system::error_code e)
+            {
+                ec = e;
+            })(t.render(bw,
+            [&](std::size_t slot, std::size_t row, html_writer& w)
+            {
+                if(slot == rows)
+                {
+                    held = held || bw.full();
+                    return row < 100;
+                }
+                format_to(w, "{}", row);
+                return false;
+            }));
+        BOOST_TEST(! ec);
+        BOOST_TEST(! held);
+        capy::test::run_blocking(
+            [&](system::error_code e)
+            {
+                ec = e;
+            })(bw.finish());
+        BOOST_TEST(! ec);
+        BOOST_TEST_EQ(bs.data(), expect);
+    }
+
+    void
+    testErrors()
+    {
+        auto const bad = [](char const* text)
+        {
+            BOOST_TEST_THROWS(html_template{ text },
+                std::invalid_argument);
+        };
+        bad("{{x");
+        bad("{{{x}}");
+        bad("{{}}");
+        bad("{{#a}}");
+        bad("{{/a}}");
+        bad("{{#a}}{{/b}}");
+        bad("{{#a}}{{/a}}{{a}}");
+
+        html_template const t("{{a}}");
+        BOOST_TEST_THROWS(t.slot("b"), std::invalid_argument);
+    }
+
+    void
+    run()
+    {
+        testRender();
+        testNested();
+        testBody();
+        testErrors();
+    }
+};
+
+TEST_SUITE(
+    html_template_test,
+    "boost.beast2.html_template");
+
+} // beast2
+} // boost
@@ -0,0 +1,233 @@
+//
+// Copyright (c) 2026 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/beast2
+//
+
+// Test that header file is self-contained.
+#include "src/detail/ktls.hpp"
+
+#include "tls_pair.hpp"
+#include "test_suite.hpp"
+
+#include <cstring>
+#include <string>
+
+namespace boost {
+namespace beast2 {
+
+struct ktls_test
+{
+    using tls_pair = test::tls_pair;
+
+    static int keylog_lines;
+
+    void
+    testPrepare()
+    {
+        tls_pair tp;
+        keylog_lines = 0;
+        SSL_CTX_set_keylog_callback(tp.server,
+            [](SSL const*, char const*) { ++keylog_lines; });
+
+        tls_session_config cfg;
+        detail::tls_session_cache cache(cfg);
+        {
+            detail::ktls_offload ko;
+            detail::ktls_state ks;
+            auto mode = detail::ktls_mode::tx_rx;
+            SSL_SESSION_free(tp.connect(&cache, nullptr, &ko, &ks, &mode));
+
+            // one record each way since ChangeCipherSpec
+            BOOST_TEST_EQ(ks.tx_seq, 1u);
+            BOOST_TEST_EQ(ks.rx_seq, 1u);
+
+            // without a socket, nothing is offloaded
+            BOOST_TEST(mode == detail::ktls_mode::none);
+            BOOST_TEST_EQ(ko.offloaded(), 0u);
+
+            // the previous key log callback still runs
+            BOOST_TEST(keylog_lines > 0);
+        }
+
+        // and is restored
+        BOOST_TEST(SSL_CTX_get_keylog_callback(tp.server) != nullptr);
+        SSL_SESSION_free(tp.connect(&cache, nullptr));
+        BOOST_TEST_EQ(cache.get_stats().failed_handshakes, 0u);
+    }
+
+    // Seal an application data record the way the
+    // kernel does, from the keys it would be given
+    static
+    std::string
+    seal(
+        SSL* ssl,
+        detail::ktls_keys const& k,
+        std::string const& plain,
+        unsigned char const* nonce_explicit)
+    {
+        auto const nid = SSL_CIPHER_get_cipher_nid(
+            SSL_get_current_cipher(ssl));
+        bool const tls13 = SSL_version(ssl) == TLS1_3_VERSION;
+        bool const chacha = nid == NID_chacha20_poly1305;
+        auto const cipher =
+            nid == NID_aes_128_gcm ? EVP_aes_128_gcm() :
+            nid == NID_aes_256_gcm ? EVP_aes_256_gcm() :
+            EVP_chacha20_poly1305();
+
+        // TLS 1.2 with AES-GCM sends part of the nonce,
+        // the others derive it from the sequence number
+        unsigned char nonce[12];
+        std::memcpy(nonce, k.iv, sizeof(nonce));
+        std::size_t explicit_size = 0;
+        if(tls13 || chacha)
+        {
+            for(int i = 0; i < 8; ++i)
+                nonce[4 + i] ^= k.rec_seq[i];
+        }
+        else
+        {
+            std::memcpy(nonce + 4, nonce_explicit, 8);
+            explicit_size = 8;
+        }
+
+        std::string inner = plain;
+        if(tls13)
+            inner.push_back(23);
+        auto const len = explicit_size + inner.size() + 16;
+        std::string rec = { 23, 3, 3,
+            static_cast<char>(len >> 8),
+            static_cast<char>(len & 0xff) };
+        std::string aad;
+        if(tls13)
+        {
+            aad = rec;
+        }
+        else
+        {
+            aad.assign(reinterpret_cast<char const*>(k.rec_seq), 8);
+            aad += { 23, 3, 3,
+                static_cast<char>(plain.size() >> 8),
+                static_cast<char>(plain.size() & 0xff) };
+        }
+        if(explicit_size)
+            rec.append(reinterpret_cast<char const*>(nonce + 4), 8);
+
+        auto const cc = EVP_CIPHER_CTX_new();
+        int n = 0;
+        std::string out(inner.size(), '\0');
+        unsigned char tag[16];
+        EVP_EncryptInit_ex(cc, cipher, nullptr, nullptr, nullptr);
+        EVP_CIPHER_CTX_ctrl(cc, EVP_CTRL_AEAD_SET_IVLEN, 12, nullptr);
+        EVP_EncryptInit_ex(cc, nullptr, nullptr, k.key, nonce);
+        EVP_EncryptUpdate(cc, nullptr, &n,
+            reinterpret_cast<unsigned char const*>(aad.data()),
+            static_cast<int>(aad.size()));
+        EVP_EncryptUpdate(cc,
+            reinterpret_cast<unsigned char*>(&out[0]), &n,
+            reinterpret_cast<unsigned char const*>(inner.data()),
+            static_cast<int>(inner.size()));
+        EVP_EncryptFinal_ex(cc, nullptr, &n);
+        EVP_CIPHER_CTX_ctrl(cc, EVP_CTRL_AEAD_GET_TAG, 16, tag);
+        EVP_CIPHER_CTX_free(cc);
+        rec += out;
+        rec.append(reinterpret_cast<char const*>(tag), 16);
+        return rec;
+    }
+
+    // Check the keys and sequence numbers the kernel
+    // would be given against what OpenSSL does
+    void
+    checkKeys(
+        int version,
+        char const* cipher,
+        int exchanges)
+    {
+        tls_pair tp(version);
+        if(version == TLS1_3_VERSION)
+            SSL_CTX_set_ciphersuites(tp.client, cipher);
+        else
+            SSL_CTX_set_cipher_list(tp.client, cipher);
+
+        detail::ktls_offload ko;
+        detail::ktls_state ks;
+        auto const s = SSL_new(tp.server);
+        auto const c = SSL_new(tp.client);
+        ko.prepare(s, ks);
+        BOOST_TEST(tls_pair::handshake(s, c));
+        BOOST_TEST_EQ(std::string(SSL_CIPHER_get_name(
+            SSL_get_current_cipher(s))), cipher);
+
+        // records through OpenSSL still count
+        char buf[64];
+        for(int i = 0; i < exchanges; ++i)
+        {
+            SSL_write(s, "x", 1);
+            SSL_read(c, buf, sizeof(buf));
+            SSL_write(c, "y", 1);
+            SSL_read(s, buf, sizeof(buf));
+        }
+
+        // the client opens what the kernel would send
+        detail::ktls_keys tx;
+        BOOST_TEST(detail::derive_ktls_keys(s, ks, true, tx));
+        auto const rec = seal(s, tx, "hello", tx.iv + 4);
+        auto const bio = SSL_get_rbio(s);
+        BIO_write(bio, rec.data(), static_cast<int>(rec.size()));
+        int const n = SSL_read(c, buf, sizeof(buf));
+        BOOST_TEST_EQ(std::string(buf, n > 0 ? n : 0), "hello");
+
+        // the kernel would open what the client sends
+        detail::ktls_keys rx;
+        BOOST_TEST(detail::derive_ktls_keys(s, ks, false, rx));
+        SSL_write(c, "world", 5);
+        unsigned char raw[256];
+        int const got = BIO_read(bio, raw, sizeof(raw));
+        auto const expect = seal(s, rx, "world", raw + 5);
+        BOOST_TEST_EQ(std::string(
+            reinterpret_cast<char const*>(raw), got > 0 ? got : 0),
+            expect);
+
+        SSL_free(s);
+        SSL_free(c);
+    }
+
+    void
+    testKeys()
+    {
+        for(int exchanges : { 0, 2 })
+        {
+            checkKeys(TLS1_2_VERSION,
+                "ECDHE-ECDSA-AES128-GCM-SHA256", exchanges);
+            checkKeys(TLS1_2_VERSION,
+                "ECDHE-ECDSA-AES256-GCM-SHA384", exchanges);
+            checkKeys(TLS1_2_VERSION,
+                "ECDHE-ECDSA-CHACHA20-POLY1305", exchanges);
+            checkKeys(TLS1_3_VERSION,
+                "TLS_AES_128_GCM_SHA256", exchanges);
+            checkKeys(TLS1_3_VERSION,
+                "TLS_AES_256_GCM_SHA384", exchanges);
+            checkKeys(TLS1_3_VERSION,
+                "TLS_CHACHA20_POLY1305_SHA256", exchanges);
+        }
+    }
+
+    void
+    run()
+    {
+        testPrepare();
+        testKeys();
+    }
+};
+
+int ktls_test::keylog_lines = 0;
+
+TEST_SUITE(
+    ktls_test,
+    "boost.beast2.ktls");
+
+} // beast2
+} // boost
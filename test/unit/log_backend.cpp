@@ -0,0 +1,237 @@
+//
+// Copyright (c) 2026 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/beast2
+//
+
+// Test that header file is self-contained.
+#include <boost/beast2/log_backend.hpp>
+
+#include "test_suite.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace boost {
+namespace beast2 {
+
+struct log_backend_test
+{
+    // Collects everything written
+    struct string_sink : log_sink
+    {
+        std::mutex m;
+        std::string s;
+
+        void
+        write(
+            char const* data,
+            std::size_t size) override
+        {
+            std::lock_guard<std::mutex> lock(m);
+            s.append(data, size);
+        }
+    };
+
+    // Holds the logging thread until opened
+    struct gate_sink : log_sink
+    {
+        std::mutex m;
+        std::condition_variable cv;
+        bool open = false;
+        std::size_t lines = 0;
+
+        void
+        write(
+            char const* data,
+            std::size_t size) override
+        {
+            std::unique_lock<std::mutex> lock(m);
+            cv.wait(lock, [this]{ return open; });
+            for(std::size_t i = 0; i < size; ++i)
+                if(data[i] == '\n')
+                    ++lines;
+        }
+
+        void
+        release()
+        {
+            std::lock_guard<std::mutex> lock(m);
+            open = true;
+            cv.notify_all();
+        }
+    };
+
+    void
+    testWrite()
+    {
+        auto sink = std::make_shared<string_sink>();
+        log_backend b(16, sink);
+        BOOST_TEST(b.push("one"));
+        BOOST_TEST(b.push(std::string(1000, 'x')));
+        BOOST_TEST(b.push("three"));
+        b.flush();
+        BOOST_TEST(sink->s ==
+            "one\n" + std::string(1000, 'x') + "\nthree\n");
+        auto const st = b.get_stats();
+        BOOST_TEST_EQ(st.written, 3u);
+        BOOST_TEST_EQ(st.dropped, 0u);
+        BOOST_TEST(st.batches >= 1u);
+    }
+
+    void
+    testProducers()
+    {
+        auto sink = std::make_shared<string_sink>();
+        log_backend b(64, sink);
+        b.set_overflow(log_overflow::block);
+        std::vector<std::thread> v;
+        for(int i = 0; i < 4; ++i)
+            v.emplace_back([&b, i]
+            {
+                std::string const rec(10, char('a' + i));
+                for(int j = 0; j < 1000; ++j)
+                    b.push(rec);
+            });
+        for(auto& t : v)
+            t.join();
+        b.flush();
+
+        // every record arrives whole
+        BOOST_TEST_EQ(sink->s.size(), 4u * 1000u * 11u);
+        for(std::size_t i = 0; i < sink->s.size(); i += 11)
+        {
+            auto const c = sink->s[i];
+            BOOST_TEST(
+                sink->s.compare(i, 11, std::string(10, c) + "\n") == 0);
+        }
+        auto const st = b.get_stats();
+        BOOST_TEST_EQ(st.written, 4000u);
+        BOOST_TEST_EQ(st.dropped, 0u);
+    }
+
+    void
+    testDrop()
+    {
+        auto sink = std::make_shared<gate_sink>();
+        std::size_t pushed = 0;
+        {
+            log_backend b(4, sink);
+            for(int i = 0; i < 100; ++i)
+                if(b.push("x"))
+                    ++pushed;
+            auto const st = b.get_stats();
+            BOOST_TEST_EQ(st.dropped, 100u - pushed);
+            BOOST_TEST(st.dropped > 0u);
+            sink->release();
+        }
+        // the destructor writes what was kept
+        BOOST_TEST_EQ(sink->lines, pushed);
+    }
+
+    // Throws something which is not a std::exception
+    struct throwing_sink : log_sink
+    {
+        void
+        write(char const*, std::size_t) override
+        {
+            throw 42;
+        }
+    };
+
+    static
+    void
+    throwing_decoder(
+        char const*,
+        std::size_t,
+        std::string& dest)
+    {
+        dest.append("partial");
+        throw 42;
+    }
+
+    void
+    testThrow()
+    {
+        auto sink = std::make_shared<string_sink>();
+        log_backend b(8, std::make_shared<throwing_sink>());
+        b.push("a");
+        b.push("b");
+        b.flush();
+        auto st = b.get_stats();
+        BOOST_TEST_EQ(st.dropped, 2u);
+        BOOST_TEST_EQ(st.written, 0u);
+
+        // the logging thread carries on
+        b.set_sink(sink);
+        b.push("x", &throwing_decoder);
+        b.push("c");
+        b.flush();
+        BOOST_TEST(sink->s == "c\n");
+        st = b.get_stats();
+        BOOST_TEST_EQ(st.dropped, 3u);
+        BOOST_TEST_EQ(st.written, 1u);
+    }
+
+    void
+    testSleep()
+    {
+        // records pushed while the logging thread goes
+        // to sleep are not left behind
+        auto sink = std::make_shared<string_sink>();
+        log_backend b(8, sink);
+        for(int i = 0; i < 200; ++i)
+        {
+            b.push("z");
+            std::this_thread::yield();
+        }
+        for(int i = 0; i < 1000; ++i)
+        {
+            if(b.get_stats().written == 200u)
+                break;
+            std::this_thread::sleep_for(
+                std::chrono::milliseconds(1));
+        }
+        BOOST_TEST_EQ(b.get_stats().written, 200u);
+    }
+
+    void
+    testSetSink()
+    {
+        auto s1 = std::make_shared<string_sink>();
+        auto s2 = std::make_shared<string_sink>();
+        log_backend b(8, s1);
+        b.push("a");
+        b.flush();
+        b.set_sink(s2);
+        b.push("b");
+        b.flush();
+        BOOST_TEST(s1->s == "a\n");
+        BOOST_TEST(s2->s == "b\n");
+    }
+
+    void
+    run()
+    {
+        testWrite();
+        testProducers();
+        testDrop();
+        testSetSink();
+        testThrow();
+        testSleep();
+    }
+};
+
+TEST_SUITE(
+    log_backend_test,
+    "boost.beast2.log_backend");
+
+} // beast2
+} // boost
@@ -10,15 +10,155 @@
 // Test that header file is self-contained.
 #include <boost/beast2/logger.hpp>
 
+#include <boost/beast2/log_service.hpp>
+
 #include "test_suite.hpp"
 
+#include <mutex>
+#include <ostream>
+#include <string>
+
 namespace boost {
 namespace beast2 {
 
 struct logger_test
 {
-    void run()
+    struct string_sink : log_sink
+    {
+        std::mutex m;
+        std::string s;
+
+        void
+        write(
+            char const* data,
+            std::size_t size) override
+        {
+            std::lock_guard<std::mutex> lock(m);
+            s.append(data, size);
+        }
+    };
+
+    // not capturable, so formatted at once
+    struct point
+    {
+        int x;
+        int y;
+
+        friend
+        std::ostream&
+        operator<<(std::ostream& os, point const& p)
+        {
+            return os << p.x << ',' << p.y;
+        }
+    };
+
+    void
+    testDeferred()
+    {
+        static_assert(detail::log_capturable<
+            int, double, char[4], char const*, std::string>);
+        static_assert(! detail::log_capturable<int, point>);
+
+        auto sink = std::make_shared<string_sink>();
+        log_sections ls;
+        ls.backend().set_sink(sink);
+        auto sect = ls.get("test");
+        sect.set_threshold(0);
+
+        std::string name = "abc";
+        char const* cs = "def";
+        sect("n={} d={} s={} c={} t={}", 42, 2.5, name, cs, "lit");
+        name = "changed"; // the record holds a copy
+        sect("p={}", point{ 1, 2 });
+        core::string_view fs = "runtime {}";
+        sect(fs, 7);
+        LOG_TRC(sect)("level {}", 0);
+        char const* np = nullptr;
+        sect("null={}", np);
+        // parsed once, then reused with new arguments
+        for(int i = 0; i < 2; ++i)
+            sect("again {:>3}", i);
+        ls.backend().flush();
+
+        BOOST_TEST(sink->s ==
+            "n=42 d=2.5 s=abc c=def t=lit\n"
+            "p=1,2\n"
+            "runtime 7\n"
+            "level 0\n"
+            "null=(null)\n"
+            "again   0\n"
+            "again   1\n");
+    }
+
+    void
+    testThreshold()
+    {
+        auto sink = std::make_shared<string_sink>();
+        log_sections ls;
+        ls.backend().set_sink(sink);
+        auto a = ls.get("a");
+        auto b = ls.get("b");
+        BOOST_TEST_EQ(a.threshold(), 0);
+        b.set_threshold(2);
+
+        // copies share the level
+        ls.get("a").set_threshold(1);
+        BOOST_TEST_EQ(a.threshold(), 1);
+        BOOST_TEST_EQ(b.threshold(), 2);
+
+        int evaluated = 0;
+        auto const arg = [&]{ return ++evaluated; };
+        LOG_DBG(a)("a {}", arg());
+        LOG_DBG(b)("b {}", arg());
+        LOG_TRC(a)("a {}", arg());
+        b.log(1, "b {}", 0);
+        LOG_ERR(b)("b {}", arg());
+        ls.backend().flush();
+
+        // squelched arguments are not evaluated
+        BOOST_TEST_EQ(evaluated, 2);
+        BOOST_TEST(sink->s == "a 1\nb 2\n");
+    }
+
+    void
+    testOutlive()
+    {
+        auto sink = std::make_shared<string_sink>();
+        {
+            section sect;
+            {
+                log_sections ls;
+                ls.backend().set_sink(sink);
+                sect = ls.get("kept");
+            }
+
+            // the backend lives as long as the section
+            LOG_ERR(sect)("after {}", 1);
+        }
+        BOOST_TEST(sink->s == "after 1\n");
+    }
+
+    void
+    testService()
+    {
+        auto& svc = use_log_service();
+        svc.get_section("svc");
+        BOOST_TEST(svc.set_threshold("svc", 3));
+        BOOST_TEST_EQ(svc.get_section("svc").threshold(), 3);
+
+        // an unknown name does not create a section
+        BOOST_TEST(! svc.set_threshold("svc-unknown", 3));
+        for(auto const& sect : svc.get_sections())
+            BOOST_TEST(sect.name() != "svc-unknown");
+    }
+
+    void
+    run()
     {
+        testDeferred();
+        testThreshold();
+        testOutlive();
+        testService();
     }
 };
 
@@ -0,0 +1,223 @@
+//
+// Copyright (c) 2026 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/beast2
+//
+
+// Test that header file is self-contained.
+#include <boost/beast2/metrics_service.hpp>
+
+#include "test_suite.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace boost {
+namespace beast2 {
+
+struct metrics_service_test
+{
+    static
+    bool
+    contains(
+        std::string const& s,
+        core::string_view what)
+    {
+        return s.find(what.data(), 0, what.size()) !=
+            std::string::npos;
+    }
+
+    void
+    testCounter()
+    {
+        auto& svc = use_metrics_service();
+        auto c = svc.get_counter(
+            "test_counter_total", "A counter.", "k=\"a\"");
+        std::vector<std::thread> v;
+        for(int i = 0; i < 4; ++i)
+            v.emplace_back([c]
+            {
+                for(int j = 0; j < 1000; ++j)
+                    c.add();
+            });
+        for(auto& t : v)
+            t.join();
+        BOOST_TEST_EQ(c.value(), 4000u);
+
+        // same name and labels, same metric
+        BOOST_TEST_EQ(svc.get_counter(
+            "test_counter_total", "", "k=\"a\"").value(), 4000u);
+        BOOST_TEST_EQ(svc.get_counter(
+            "test_counter_total", "", "k=\"b\"").value(), 0u);
+
+        // a default handle does nothing
+        counter none;
+        none.add();
+        BOOST_TEST_EQ(none.value(), 0u);
+
+        BOOST_TEST_THROWS(
+            svc.get_gauge("test_counter_total", ""),
+            std::invalid_argument);
+    }
+
+    void
+    testSlots()
+    {
+        // threads alive together never share a slot
+        constexpr int n = 40;
+        std::vector<std::size_t> idx(n);
+        std::atomic<int> arrived{0};
+        std::vector<std::thread> v;
+        for(int i = 0; i < n; ++i)
+            v.emplace_back([&, i]
+            {
+                idx[i] = detail::metric_slot();
+                ++arrived;
+                while(arrived.load() < n)
+                    std::this_thread::yield();
+            });
+        for(auto& t : v)
+            t.join();
+        std::sort(idx.begin(), idx.end());
+        BOOST_TEST(std::adjacent_find(
+            idx.begin(), idx.end()) == idx.end());
+
+        // the slot of an exited thread is reused
+        std::size_t a = 0;
+        std::size_t b = 0;
+        std::thread([&]{ a = detail::metric_slot(); }).join();
+        std::thread([&]{ b = detail::metric_slot(); }).join();
+        BOOST_TEST_EQ(a, b);
+
+        // counts survive the threads which made them
+        auto c = use_metrics_service().get_counter(
+            "test_slots_total", "Slots.");
+        v.clear();
+        for(int i = 0; i < n; ++i)
+            v.emplace_back([c]{ c.add(2); });
+        for(auto& t : v)
+            t.join();
+        BOOST_TEST_EQ(c.value(), 2u * n);
+    }
+
+    void
+    testGauge()
+    {
+        auto g = use_metrics_service().get_gauge(
+            "test_gauge", "A gauge.");
+        g.set(10);
+        g.add(5);
+        g.sub(3);
+        BOOST_TEST_EQ(g.value(), 12);
+    }
+
+    void
+    testHistogram()
+    {
+        using detail::histogram_impl;
+
+        // buckets increase with the value
+        std::size_t prev = 0;
+        for(std::uint64_t x = 0; x < 100000; ++x)
+        {
+            auto const i = histogram_impl::index(x);
+            BOOST_TEST(i >= prev);
+            prev = i;
+        }
+        BOOST_TEST_EQ(histogram_impl::index(~std::uint64_t(0)),
+            histogram_impl::buckets - 1);
+
+        auto h = use_metrics_service().get_histogram(
+            "test_latency_seconds", "A histogram.", {}, 1e-6);
+        BOOST_TEST_EQ(h.quantile(0.5), 0u);
+        for(std::uint64_t x = 1; x <= 1000; ++x)
+            h.observe(x);
+        BOOST_TEST_EQ(h.count(), 1000u);
+
+        // within a bucket of the exact value
+        auto const p50 = h.quantile(0.5);
+        BOOST_TEST(p50 >= 500 && p50 <= 625);
+        auto const p99 = h.quantile(0.99);
+        BOOST_TEST(p99 >= 990 && p99 <= 1250);
+        BOOST_TEST(h.quantile(1) >= 1000);
+    }
+
+    void
+    testRender()
+    {
+        auto& svc = use_metrics_service();
+        svc.get_counter("test_render_total", "Rendered.").add(7);
+        svc.get_histogram("test_render_seconds", "Times.",
+            "route=\"x\"", 1e-3).observe(3);
+
+        std::string s;
+        svc.render(s);
+        BOOST_TEST(contains(s, "# HELP test_render_total Rendered.\n"));
+        BOOST_TEST(contains(s, "# TYPE test_render_total counter\n"));
+        BOOST_TEST(contains(s, "\ntest_render_total 7\n"));
+        BOOST_TEST(contains(s, "# TYPE test_render_seconds histogram\n"));
+        BOOST_TEST(contains(s,
+            "test_render_seconds_bucket{route=\"x\",le=\"0.003\"} 1\n"));
+        BOOST_TEST(contains(s,
+            "test_render_seconds_bucket{route=\"x\",le=\"+Inf\"} 1\n"));
+
+        // bounds above the largest value are still there
+        BOOST_TEST(contains(s,
+            "test_render_seconds_bucket{route=\"x\",le=\"1.023\"} 1\n"));
+        BOOST_TEST(contains(s,
+            "test_render_seconds_bucket{route=\"x\",le=\"1.09951163e+09\"} 1\n"));
+        BOOST_TEST(contains(s,
+            "test_render_seconds_sum{route=\"x\"} 0.003\n"));
+        BOOST_TEST(contains(s,
+            "test_render_seconds_count{route=\"x\"} 1\n"));
+    }
+
+    void
+    testMeasureRoute()
+    {
+        auto& svc = use_metrics_service();
+        measure_route m("a\"b\\c\nd", svc);
+
+        std::string s;
+        svc.render(s);
+        BOOST_TEST(contains(s,
+            "beast2_route_latency_seconds_count"
+            "{route=\"a\\\"b\\\\c\\nd\"} 0\n"));
+    }
+
+    void
+    testServerMetrics()
+    {
+        server_metrics m;
+        auto const before = m.requests[1].value();
+        m.on_response(204);
+        m.on_response(99);
+        BOOST_TEST_EQ(m.requests[1].value(), before + 1);
+    }
+
+    void
+    run()
+    {
+        testCounter();
+        testSlots();
+        testGauge();
+        testHistogram();
+        testRender();
+        testMeasureRoute();
+        testServerMetrics();
+    }
+};
+
+TEST_SUITE(
+    metrics_service_test,
+    "boost.beast2.metrics_service");
+
+} // beast2
+} // boost
@@ -0,0 +1,101 @@
+//
+// Copyright (c) 2026 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/beast2
+//
+
+// Test that header file is self-contained.
+#include <boost/beast2/request_arena.hpp>
+
+#include <boost/beast2/detail/request_slots.hpp>
+
+#include "test_suite.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace boost {
+namespace beast2 {
+
+struct request_arena_test
+{
+    void
+    testAllocate()
+    {
+        request_arena a(256);
+        void* p0 = a.allocate(10, 1);
+        void* p1 = a.allocate(8, 8);
+        BOOST_TEST(p0 != p1);
+        BOOST_TEST_EQ(
+            reinterpret_cast<std::uintptr_t>(p1) % 8, 0u);
+        BOOST_TEST_EQ(a.used(), 18u);
+
+        // reset rewinds to the kept buffer
+        a.reset();
+        BOOST_TEST_EQ(a.used(), 0u);
+        BOOST_TEST(a.allocate(10, 1) == p0);
+    }
+
+    void
+    testSpill()
+    {
+        request_arena a(64);
+        std::pmr::vector<std::pmr::string> v(&a);
+        for(int i = 0; i < 100; ++i)
+            v.emplace_back(100, 'x');
+        BOOST_TEST_EQ(v.size(), 100u);
+        BOOST_TEST(a.used() > 100u * 100u);
+        v.clear();
+        v.shrink_to_fit();
+        a.reset();
+        BOOST_TEST_EQ(a.used(), 0u);
+    }
+
+    void
+    testEqual()
+    {
+        request_arena a;
+        request_arena b;
+        BOOST_TEST(a.is_equal(a));
+        BOOST_TEST(! a.is_equal(b));
+    }
+
+    void
+    testGetArena()
+    {
+        http::route_params rp;
+        BOOST_TEST(get_arena(rp) ==
+            std::pmr::new_delete_resource());
+
+        // the worker publishes one slot per request
+        request_arena a;
+        detail::request_slots slots;
+        slots.arena = &a;
+        rp.route_data.emplace<detail::request_slots*>(&slots);
+        BOOST_TEST(get_arena(rp) == &a);
+
+        rp.route_data.clear();
+        BOOST_TEST(get_arena(rp) ==
+            std::pmr::new_delete_resource());
+    }
+
+    void
+    run()
+    {
+        testAllocate();
+        testSpill();
+        testEqual();
+        testGetArena();
+    }
+};
+
+TEST_SUITE(
+    request_arena_test,
+    "boost.beast2.request_arena");
+
+} // beast2
+} // boost
@@ -0,0 +1,89 @@
+//
+// Copyright (c) 2026 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/beast2
+//
+
+// Test that header file is self-contained.
+#include <boost/beast2/request_trace.hpp>
+
+#include "test_suite.hpp"
+
+#include <chrono>
+
+namespace boost {
+namespace beast2 {
+
+struct request_trace_test
+{
+    using tp = trace_point;
+    using clock_type = request_trace::clock_type;
+
+    void
+    testTrace()
+    {
+        request_trace t;
+        BOOST_TEST_EQ(request_trace::size, 7u);
+        BOOST_TEST(! t.has(tp::accept));
+        BOOST_TEST(! t.has(tp::last_byte));
+
+        auto const t0 = clock_type::now();
+        t[tp::first_byte] = t0;
+        t[tp::header_parsed] = t0 + std::chrono::microseconds(30);
+        BOOST_TEST(t.has(tp::first_byte));
+        BOOST_TEST(
+            t.between(tp::first_byte, tp::header_parsed) ==
+            std::chrono::microseconds(30));
+
+        // unreached points measure as zero
+        BOOST_TEST(
+            t.between(tp::first_byte, tp::dispatch_end) ==
+            clock_type::duration::zero());
+
+        t.mark(tp::last_byte);
+        BOOST_TEST(t.has(tp::last_byte));
+        BOOST_TEST(t[tp::last_byte] >= t0);
+    }
+
+    void
+    testReporter()
+    {
+        log_sections ls;
+        slow_request_reporter r(
+            ls.get("slow"), std::chrono::milliseconds(10));
+        http::route_params rp;
+
+        // incomplete traces are ignored
+        request_trace t;
+        r.on_request(t, rp);
+
+        // fast and slow requests
+        auto const t0 = clock_type::now();
+        t[tp::accept] = t0;
+        t[tp::first_byte] = t0;
+        t[tp::header_parsed] = t0;
+        t[tp::url_parsed] = t0;
+        t[tp::dispatch_begin] = t0;
+        t[tp::dispatch_end] = t0 + std::chrono::milliseconds(1);
+        r.on_request(t, rp);
+        t[tp::last_byte] = t0 + std::chrono::milliseconds(20);
+        r.on_request(t, rp);
+    }
+
+    void
+    run()
+    {
+        testTrace();
+        testReporter();
+    }
+};
+
+TEST_SUITE(
+    request_trace_test,
+    "boost.beast2.request_trace");
+
+} // beast2
+} // boost
@@ -0,0 +1,118 @@
+//
+// Copyright (c) 2026 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/beast2
+//
+
+// Test that header file is self-contained.
+#include <boost/beast2/response_cache.hpp>
+
+#include "test_suite.hpp"
+
+namespace boost {
+namespace beast2 {
+
+struct response_cache_test
+{
+    using clock_type = response_cache::clock_type;
+
+    static
+    std::shared_ptr<response_cache::entry const>
+    make_entry(
+        std::size_t size,
+        clock_type::time_point expires)
+    {
+        auto e = std::make_shared<response_cache::entry>();
+        e->bytes.assign(size, 'x');
+        e->header_size = size;
+        e->expires = expires;
+        return e;
+    }
+
+    void
+    testFind()
+    {
+        response_cache cache;
+        auto const now = clock_type::now();
+        auto const later = now + std::chrono::seconds(60);
+
+        BOOST_TEST(! cache.find("h/a", ""));
+        cache.insert("h/a", "", "", make_entry(10, later));
+        BOOST_TEST(cache.find("h/a", ""));
+        BOOST_TEST(! cache.find("h/b", ""));
+
+        // stale entries are dropped
+        BOOST_TEST(! cache.find("h/a", "", later));
+        BOOST_TEST(! cache.find("h/a", "", now));
+
+        auto const st = cache.get_stats();
+        BOOST_TEST_EQ(st.hits, 1u);
+        BOOST_TEST_EQ(st.misses, 4u);
+        BOOST_TEST_EQ(st.entries, 0u);
+    }
+
+    void
+    testVary()
+    {
+        response_cache cache;
+        auto const later = clock_type::now() + std::chrono::seconds(60);
+
+        cache.insert("h/a", "accept-encoding", std::string("br\0", 3),
+            make_entry(10, later));
+        cache.insert("h/a", "accept-encoding", std::string("gzip\0", 5),
+            make_entry(10, later));
+        BOOST_TEST_EQ(cache.vary_of("h/a"), "accept-encoding");
+        BOOST_TEST(cache.find("h/a", std::string("br\0", 3)));
+        BOOST_TEST(cache.find("h/a", std::string("gzip\0", 5)));
+        BOOST_TEST(! cache.find("h/a", std::string("\0", 1)));
+
+        // different names replace every variant
+        cache.insert("h/a", "", "", make_entry(10, later));
+        BOOST_TEST_EQ(cache.vary_of("h/a"), "");
+        BOOST_TEST_EQ(cache.get_stats().entries, 1u);
+    }
+
+    void
+    testEvict()
+    {
+        response_cache_config cfg;
+        cfg.shards = 1;
+        cfg.max_bytes = 100;
+        response_cache cache(cfg);
+        auto const later = clock_type::now() + std::chrono::seconds(60);
+
+        cache.insert("a", "", "", make_entry(40, later));
+        cache.insert("b", "", "", make_entry(40, later));
+        BOOST_TEST(cache.find("a", "")); // a is now most recent
+        cache.insert("c", "", "", make_entry(40, later));
+        BOOST_TEST(cache.find("a", ""));
+        BOOST_TEST(! cache.find("b", ""));
+        BOOST_TEST(cache.find("c", ""));
+        BOOST_TEST_EQ(cache.get_stats().evictions, 1u);
+
+        // too large for the shard
+        cache.insert("d", "", "", make_entry(200, later));
+        BOOST_TEST(! cache.find("d", ""));
+
+        cache.clear();
+        BOOST_TEST_EQ(cache.get_stats().bytes, 0u);
+    }
+
+    void
+    run()
+    {
+        testFind();
+        testVary();
+        testEvict();
+    }
+};
+
+TEST_SUITE(
+    response_cache_test,
+    "boost.beast2.response_cache");
+
+} // beast2
+} // boost
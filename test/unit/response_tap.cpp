@@ -0,0 +1,74 @@
+//
+// Copyright (c) 2026 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/beast2
+//
+
+// Test that header file is self-contained.
+#include <boost/beast2/response_tap.hpp>
+
+#include "test_suite.hpp"
+
+namespace boost {
+namespace beast2 {
+
+struct response_tap_test
+{
+    struct test_tap : response_tap
+    {
+        capy::task<system::error_code>
+        write(core::string_view) override
+        {
+            co_return system::error_code();
+        }
+
+        void
+        put(core::string_view s)
+        {
+            record(s.data(), s.size());
+        }
+    };
+
+    void
+    run()
+    {
+        test_tap t;
+        std::string got;
+
+        // nothing is recorded unless asked
+        t.put("abc");
+        t.complete();
+        BOOST_TEST(got.empty());
+
+        t.capture(8, [&](core::string_view s){ got = s; });
+        t.put("abc");
+        t.put("def");
+        t.complete();
+        BOOST_TEST_EQ(got, "abcdef");
+
+        // over the limit
+        got.clear();
+        t.capture(4, [&](core::string_view s){ got = s; });
+        t.put("abc");
+        t.put("def");
+        t.complete();
+        BOOST_TEST(got.empty());
+
+        got.clear();
+        t.capture(8, [&](core::string_view s){ got = s; });
+        t.put("abc");
+        t.discard();
+        t.complete();
+        BOOST_TEST(got.empty());
+    }
+};
+
+TEST_SUITE(
+    response_tap_test,
+    "boost.beast2.response_tap");
+
+} // beast2
+} // boost
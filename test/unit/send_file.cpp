@@ -0,0 +1,91 @@
+//
+// Copyright (c) 2026 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/beast2
+//
+
+// Test that header file is self-contained.
+#include <boost/beast2/send_file.hpp>
+
+#include "src/detail/static_file.hpp"
+#include <boost/http/field.hpp>
+
+#include "test_suite.hpp"
+
+namespace boost {
+namespace beast2 {
+
+struct send_file_test
+{
+    static
+    std::string
+    mapped(
+        core::string_view root,
+        core::string_view rel)
+    {
+        std::pmr::string path;
+        if(! detail::map_path(path, root, rel))
+            return "!";
+        return std::string(path);
+    }
+
+    void
+    testMapPath()
+    {
+        // relative to the mount point
+        BOOST_TEST_EQ(mapped("/www", "/a.css"), "/www/a.css");
+        BOOST_TEST_EQ(mapped("/www/", "/img/b.png"), "/www/img/b.png");
+        BOOST_TEST_EQ(mapped("/www", ""), "/www");
+
+        // decoded
+        BOOST_TEST_EQ(mapped("/www", "/a%20b.txt"), "/www/a b.txt");
+
+        // never outside the root
+        BOOST_TEST_EQ(mapped("/www", "/../etc/passwd"), "!");
+        BOOST_TEST_EQ(mapped("/www", "/a/%2e%2e/%2e%2e/x"), "!");
+        BOOST_TEST_EQ(mapped("/www", "/a%2f..%2fb"), "!");
+        BOOST_TEST_EQ(mapped("/www", "/a%5c..%5cb"), "!");
+        BOOST_TEST_EQ(mapped("/www", "/a%00.txt"), "!");
+
+        // directories
+        BOOST_TEST_EQ(mapped("/www", "/dir/"), "!");
+        BOOST_TEST_EQ(mapped("/www", "/a//b"), "!");
+    }
+
+    void
+    testConditional()
+    {
+        http::route_params rp;
+        BOOST_TEST(! detail::is_partial_or_conditional(rp.req));
+
+        http::field const fields[] = {
+            http::field::range,
+            http::field::if_range,
+            http::field::if_match,
+            http::field::if_none_match,
+            http::field::if_modified_since,
+            http::field::if_unmodified_since };
+        for(auto f : fields)
+        {
+            rp.req.set(f, "x");
+            BOOST_TEST(detail::is_partial_or_conditional(rp.req));
+            rp.req.erase(f);
+        }
+        BOOST_TEST(! detail::is_partial_or_conditional(rp.req));
+    }
+
+    void
+    run()
+    {
+        testMapPath();
+        testConditional();
+    }
+};
+
+TEST_SUITE(send_file_test, "boost.beast2.send_file");
+
+} // beast2
+} // boost
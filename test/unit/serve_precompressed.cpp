@@ -0,0 +1,61 @@
+//
+// Copyright (c) 2026 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/beast2
+//
+
+// Test that header file is self-contained.
+#include <boost/beast2/serve_precompressed.hpp>
+
+#include "test_suite.hpp"
+
+namespace boost {
+namespace beast2 {
+
+struct serve_precompressed_test
+{
+    void
+    check(
+        core::string_view ae,
+        content_coding first,
+        content_coding second)
+    {
+        content_coding next;
+        BOOST_TEST(negotiate_encoding(ae, &next) == first);
+        BOOST_TEST(next == second);
+    }
+
+    void
+    testNegotiate()
+    {
+        using cc = content_coding;
+        check("", cc::identity, cc::identity);
+        check("identity", cc::identity, cc::identity);
+        check("gzip", cc::gzip, cc::identity);
+        check("br", cc::br, cc::identity);
+        check("gzip, deflate, br", cc::br, cc::gzip);
+        check("GZIP;q=1.0, br;q=0.5", cc::gzip, cc::br);
+        check("br;q=0, gzip", cc::gzip, cc::identity);
+        check("*", cc::br, cc::gzip);
+        check("*;q=0.5, gzip", cc::gzip, cc::br);
+        check("br;q=0, *;q=0", cc::identity, cc::identity);
+        check("br;q=2", cc::identity, cc::identity);
+        check("br ; q=0.001", cc::br, cc::identity);
+    }
+
+    void
+    run()
+    {
+        testNegotiate();
+    }
+};
+
+TEST_SUITE(
+    serve_precompressed_test,
+    "boost.beast2.serve_precompressed");
+
+} // beast2
+} // boost
@@ -0,0 +1,131 @@
+//
+// Copyright (c) 2026 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/beast2
+//
+
+// Test that header file is self-contained.
+#include <boost/beast2/server_config.hpp>
+
+#include "src/detail/connection_pool.hpp"
+
+#include "test_suite.hpp"
+
+#include <thread>
+
+namespace boost {
+namespace beast2 {
+
+struct server_config_test
+{
+    void
+    testPool()
+    {
+        server_config cfg;
+        cfg.min_workers = 2;
+        cfg.max_workers = 3;
+        cfg.shrink_after = std::chrono::seconds(0);
+
+        detail::connection_pool<int> pool(cfg,
+            []{ return std::make_unique<int>(0); });
+        BOOST_TEST_EQ(pool.get_stats().size, 2u);
+
+        auto a = pool.acquire();
+        auto b = pool.acquire();
+        auto c = pool.acquire();
+        BOOST_TEST(a && b && c);
+        BOOST_TEST(! pool.acquire());
+        BOOST_TEST_EQ(pool.get_stats().grow_count, 1u);
+        BOOST_TEST_EQ(pool.get_stats().peak, 3u);
+
+        // idle states above the minimum are released
+        pool.release(std::move(a));
+        pool.release(std::move(b));
+        pool.release(std::move(c));
+        auto const st = pool.get_stats();
+        BOOST_TEST_EQ(st.size, 2u);
+        BOOST_TEST_EQ(st.busy, 0u);
+        BOOST_TEST_EQ(st.shrink_count, 1u);
+    }
+
+    void
+    testTimer()
+    {
+        server_config cfg;
+        cfg.min_workers = 1;
+        cfg.max_workers = 3;
+        cfg.shrink_after = std::chrono::milliseconds(1);
+        timer_wheel w(std::chrono::milliseconds(1));
+        detail::connection_pool<int> pool(cfg,
+            []{ return std::make_unique<int>(0); }, &w);
+
+        auto a = pool.acquire();
+        auto b = pool.acquire();
+        pool.release(std::move(a));
+        pool.release(std::move(b));
+        BOOST_TEST_EQ(pool.get_stats().size, 2u);
+        BOOST_TEST_EQ(pool.get_stats().shrink_count, 0u);
+        BOOST_TEST_EQ(w.size(), 1u);
+
+        // no further acquire or release
+        std::this_thread::sleep_for(
+            std::chrono::milliseconds(5));
+        w.advance(timer_wheel::clock_type::now());
+        auto const st = pool.get_stats();
+        BOOST_TEST_EQ(st.size, 1u);
+        BOOST_TEST_EQ(st.shrink_count, 1u);
+
+        // at the minimum, the timer stays disarmed
+        BOOST_TEST_EQ(w.size(), 0u);
+    }
+
+    void
+    testLease()
+    {
+        server_config cfg;
+        cfg.min_workers = 1;
+        cfg.max_workers = 1;
+        detail::connection_pool<int> pool(cfg,
+            []{ return std::make_unique<int>(0); });
+
+        {
+            detail::pool_lease<int> a(pool);
+            BOOST_TEST(static_cast<bool>(a));
+            detail::pool_lease<int> b(pool);
+            BOOST_TEST(! b);
+            a.release();
+        }
+        BOOST_TEST_EQ(pool.get_stats().size, 1u);
+        BOOST_TEST_EQ(pool.get_stats().busy, 0u);
+
+        // a lease dropped without release is discarded
+        {
+            detail::pool_lease<int> a(pool);
+            BOOST_TEST(static_cast<bool>(a));
+        }
+        auto const st = pool.get_stats();
+        BOOST_TEST_EQ(st.size, 0u);
+        BOOST_TEST_EQ(st.busy, 0u);
+        detail::pool_lease<int> c(pool);
+        BOOST_TEST(static_cast<bool>(c));
+        c.release();
+    }
+
+    void
+    run()
+    {
+        testPool();
+        testTimer();
+        testLease();
+    }
+};
+
+TEST_SUITE(
+    server_config_test,
+    "boost.beast2.server_config");
+
+} // beast2
+} // boost
@@ -0,0 +1,141 @@
+//
+// Copyright (c) 2026 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/beast2
+//
+
+// Test that header file is self-contained.
+#include <boost/beast2/sharded_http_server.hpp>
+
+#include <boost/http/request_parser.hpp>
+#include <boost/http/serializer.hpp>
+#include <boost/http/server/flat_router.hpp>
+#include <boost/http/server/router.hpp>
+#include <string>
+
+#include "test_suite.hpp"
+
+#ifdef __linux__
+# include <arpa/inet.h>
+# include <netinet/in.h>
+# include <sys/socket.h>
+# include <unistd.h>
+#endif
+
+namespace boost {
+namespace beast2 {
+
+struct sharded_http_server_test
+{
+#ifdef __linux__
+    // Returns a free ephemeral port on the loopback interface
+    static
+    unsigned short
+    ephemeral_port()
+    {
+        int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+        sockaddr_in sa{};
+        sa.sin_family = AF_INET;
+        sa.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        socklen_t len = sizeof(sa);
+        if(::bind(fd, reinterpret_cast<sockaddr*>(&sa), len) != 0 ||
+            ::getsockname(fd, reinterpret_cast<sockaddr*>(&sa), &len) != 0)
+            sa.sin_port = 0;
+        ::close(fd);
+        return ntohs(sa.sin_port);
+    }
+
+    // Sends one request and returns everything the
+    // server writes before it closes the connection
+    static
+    std::string
+    fetch(unsigned short port)
+    {
+        int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+        sockaddr_in sa{};
+        sa.sin_family = AF_INET;
+        sa.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        sa.sin_port = htons(port);
+        std::string out;
+        if(::connect(fd, reinterpret_cast<sockaddr*>(&sa),
+            sizeof(sa)) == 0)
+        {
+            std::string const req =
+                "GET / HTTP/1.1\r\n"
+                "Host: localhost\r\n"
+                "Connection: close\r\n"
+                "\r\n";
+            if(::send(fd, req.data(), req.size(), 0) ==
+                static_cast<::ssize_t>(req.size()))
+            {
+                char buf[1024];
+                for(;;)
+                {
+                    auto const n = ::recv(fd, buf, sizeof(buf), 0);
+                    if(n <= 0)
+                        break;
+                    out.append(buf, static_cast<std::size_t>(n));
+                }
+            }
+        }
+        ::close(fd);
+        return out;
+    }
+
+    void
+    testServe()
+    {
+        http::router r;
+        r.use("/",
+            [](http::route_params& rp) -> http::route_task
+            {
+                auto [ec] = co_await rp.send("hello");
+                if(ec)
+                    co_return http::route_error(ec);
+                co_return http::route_done;
+            });
+
+        sharded_http_server srv(
+            2, 2,
+            http::flat_router(std::move(r)),
+            http::make_parser_config(http::parser_config(true)),
+            http::make_serializer_config(http::serializer_config()));
+        BOOST_TEST_EQ(srv.size(), 2u);
+
+        auto const port = ephemeral_port();
+        BOOST_TEST(port != 0);
+        auto ec = srv.bind(corosio::endpoint(
+            corosio::ipv4_address::loopback(), port));
+        BOOST_TEST(! ec);
+
+        // a pin failure is reported, not fatal
+        (void)srv.start();
+
+        auto const res = fetch(port);
+        BOOST_TEST(res.compare(0, 12, "HTTP/1.1 200") == 0);
+        BOOST_TEST(res.size() >= 5 &&
+            res.compare(res.size() - 5, 5, "hello") == 0);
+
+        // draining lets every shard's event loop return
+        srv.drain();
+        srv.join();
+        auto const st = srv.get_connection_stats();
+        BOOST_TEST_EQ(st.live, 0u);
+    }
+#endif
+
+    void run()
+    {
+#ifdef __linux__
+        testServe();
+#endif
+    }
+};
+
+TEST_SUITE(sharded_http_server_test, "boost.beast2.sharded_http_server");
+
+} // beast2
+} // boost
@@ -0,0 +1,112 @@
+//
+// Copyright (c) 2026 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/beast2
+//
+
+// Test that header file is self-contained.
+#include <boost/beast2/shared_router.hpp>
+
+#include <boost/http/server/router.hpp>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "test_suite.hpp"
+
+namespace boost {
+namespace beast2 {
+
+struct shared_router_test
+{
+    void
+    testSlot()
+    {
+        shared_router a(http::flat_router(http::router{}));
+        shared_router b(http::flat_router(http::router{}));
+        router_slot slot(a);
+
+        shared_router cached;
+        std::uint64_t version = 0;
+        BOOST_TEST(slot.update(cached, version));
+        BOOST_TEST_EQ(&*cached, &*a);
+
+        // unchanged: nothing to do
+        BOOST_TEST(! slot.update(cached, version));
+
+        // a held handle survives replacement
+        shared_router held = cached;
+        slot.replace(b);
+        BOOST_TEST(slot.update(cached, version));
+        BOOST_TEST_EQ(&*cached, &*b);
+        BOOST_TEST_EQ(&*held, &*a);
+        BOOST_TEST(! slot.update(cached, version));
+        BOOST_TEST_EQ(&*slot.get(), &*b);
+    }
+
+    void
+    testConcurrent()
+    {
+        router_slot slot(shared_router(
+            http::flat_router(http::router{})));
+        std::atomic<bool> done{false};
+        std::vector<std::thread> readers;
+        for(int i = 0; i < 4; ++i)
+            readers.emplace_back(
+                [&]
+                {
+                    shared_router cached;
+                    std::uint64_t version = 0;
+                    while(! done.load())
+                        if(slot.update(cached, version))
+                            (void)cached->x;
+                });
+        shared_router last;
+        for(int i = 0; i < 1000; ++i)
+        {
+            last = shared_router(http::flat_router(http::router{}));
+            slot.replace(last);
+        }
+        done = true;
+        for(auto& t : readers)
+            t.join();
+
+        // every replaced table the slot held is gone
+        // once the readers have moved on
+        slot.replace(last);
+        BOOST_TEST_EQ(last.use_count(), 2);
+        BOOST_TEST_EQ(&*slot.get(), &*last);
+    }
+
+    void run()
+    {
+        testSlot();
+        testConcurrent();
+
+        shared_router sr0;
+        BOOST_TEST(! sr0);
+
+        shared_router sr1(http::flat_router(http::router{}));
+        BOOST_TEST(sr1);
+        BOOST_TEST_EQ(sr1.use_count(), 1);
+
+        // copies share the same table
+        shared_router sr2(sr1);
+        BOOST_TEST_EQ(sr1.use_count(), 2);
+        BOOST_TEST_EQ(&*sr1, &*sr2);
+
+        // the table does not share a cache line
+        // with the reference count
+        BOOST_TEST_EQ(reinterpret_cast<std::uintptr_t>(
+            sr1.operator->()) % 64, 0u);
+    }
+};
+
+TEST_SUITE(shared_router_test, "boost.beast2.shared_router");
+
+} // beast2
+} // boost
@@ -0,0 +1,207 @@
+//
+// Copyright (c) 2026 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/beast2
+//
+
+// Test that header file is self-contained.
+#include <boost/beast2/timer_wheel.hpp>
+
+#include <vector>
+
+#include "test_suite.hpp"
+
+namespace boost {
+namespace beast2 {
+
+struct timer_wheel_test
+{
+    using ms = std::chrono::milliseconds;
+
+    void
+    testExpiry()
+    {
+        int wakes = 0;
+        timer_wheel w(ms(10), [&]{ ++wakes; });
+        auto const t0 = timer_wheel::clock_type::now();
+
+        // deadlines spread over every level
+        std::vector<long> const due = {
+            0, 1, 5, 63, 64, 65, 1000, 4095, 4096, 70000, 300000 };
+        std::vector<timer_wheel::entry> es(due.size());
+        std::vector<long> fired(due.size(), -1);
+        long tick = 0;
+        for(std::size_t i = 0; i < due.size(); ++i)
+        {
+            es[i].on_expire = [&, i]{ fired[i] = tick; };
+            w.arm(es[i], t0 + ms(10 * due[i]));
+        }
+        BOOST_TEST_EQ(wakes, 1);
+        BOOST_TEST_EQ(w.size(), due.size());
+
+        // cancelled entries never fire
+        w.cancel(es[3]);
+        BOOST_TEST_EQ(w.size(), due.size() - 1);
+
+        for(tick = 0; tick <= 300002; ++tick)
+            w.advance(t0 + ms(10 * tick) + ms(1));
+        BOOST_TEST_EQ(w.size(), 0u);
+
+        for(std::size_t i = 0; i < due.size(); ++i)
+        {
+            if(i == 3)
+            {
+                BOOST_TEST_EQ(fired[i], -1);
+                continue;
+            }
+            // at most one tick late, never early
+            BOOST_TEST_GE(fired[i], due[i]);
+            BOOST_TEST_LE(fired[i], due[i] + 1);
+        }
+    }
+
+    void
+    testRearm()
+    {
+        timer_wheel w(ms(10));
+        auto const t0 = timer_wheel::clock_type::now();
+        int n = 0;
+        {
+            timer_wheel::entry e;
+            e.on_expire = [&]{ ++n; };
+            w.arm(e, t0 + ms(50));
+            w.arm(e, t0 + ms(500));
+            BOOST_TEST_EQ(w.size(), 1u);
+            BOOST_TEST_EQ(w.advance(t0 + ms(100)), 0u);
+            BOOST_TEST_EQ(w.advance(t0 + ms(520)), 1u);
+            BOOST_TEST_EQ(n, 1);
+
+            // destroying an armed entry disarms it
+            w.arm(e, t0 + ms(1000));
+        }
+        BOOST_TEST_EQ(w.size(), 0u);
+        BOOST_TEST_EQ(w.advance(t0 + ms(2000)), 0u);
+    }
+
+    void
+    testCatchUp()
+    {
+        timer_wheel w(ms(10));
+        auto const t0 = timer_wheel::clock_type::now();
+        std::vector<long> const due = {
+            3, 70, 5000, 90000, 100010, 200000 };
+        std::vector<timer_wheel::entry> es(due.size());
+        std::vector<int> fired(due.size(), 0);
+        for(std::size_t i = 0; i < due.size(); ++i)
+        {
+            es[i].on_expire = [&, i]{ ++fired[i]; };
+            w.arm(es[i], t0 + ms(10 * due[i]));
+        }
+
+        // one call covers a long stall
+        BOOST_TEST_EQ(w.advance(t0 + ms(10 * 100000)), 4u);
+        for(std::size_t i = 0; i < 4; ++i)
+            BOOST_TEST_EQ(fired[i], 1);
+        BOOST_TEST_EQ(w.size(), 2u);
+
+        // the rest keep their deadlines
+        BOOST_TEST_EQ(w.advance(t0 + ms(10 * 100009)), 0u);
+        BOOST_TEST_EQ(w.advance(t0 + ms(10 * 100012)), 1u);
+        BOOST_TEST_EQ(w.advance(t0 + ms(10 * 199999)), 0u);
+        BOOST_TEST_EQ(w.advance(t0 + ms(10 * 200002)), 1u);
+        BOOST_TEST_EQ(w.size(), 0u);
+    }
+
+    void
+    testFar()
+    {
+        // beyond the 2^24 ticks the levels cover
+        long const far = (1L << 24) + 1000;
+        {
+            timer_wheel w(ms(1));
+            auto const t0 = timer_wheel::clock_type::now();
+            timer_wheel::entry e;
+            long fired = -1;
+            long tick = 0;
+            e.on_expire = [&]{ fired = tick; };
+            w.arm(e, t0 + ms(far));
+
+            // stepping through every tick cascades it
+            // off the overflow list when the top wraps
+            for(; fired < 0 && tick <= far + 200; tick += 64)
+                w.advance(t0 + ms(tick));
+            BOOST_TEST_GE(fired, far);
+            BOOST_TEST_LE(fired, far + 128);
+        }
+        {
+            // and a jump over it fires it too
+            timer_wheel w(ms(1));
+            auto const t0 = timer_wheel::clock_type::now();
+            timer_wheel::entry e;
+            int n = 0;
+            e.on_expire = [&]{ ++n; };
+            w.arm(e, t0 + ms(far));
+            BOOST_TEST_EQ(w.advance(t0 + ms(far - 10)), 0u);
+            BOOST_TEST_EQ(w.advance(t0 + ms(far + 2)), 1u);
+            BOOST_TEST_EQ(n, 1);
+        }
+    }
+
+    void
+    testHandlers()
+    {
+        timer_wheel w(ms(10));
+        auto const t0 = timer_wheel::clock_type::now();
+
+        // a handler may re-arm its own entry
+        timer_wheel::entry a;
+        int na = 0;
+        a.on_expire = [&]
+        {
+            if(++na < 3)
+                w.arm(a, t0 + ms(100 * (na + 1)));
+        };
+        w.arm(a, t0 + ms(100));
+        w.advance(t0 + ms(120));
+        BOOST_TEST_EQ(na, 1);
+        BOOST_TEST_EQ(w.size(), 1u);
+        // re-armed in the past, it fires on the next tick
+        w.advance(t0 + ms(1000));
+        BOOST_TEST_EQ(na, 2);
+        w.advance(t0 + ms(1030));
+        BOOST_TEST_EQ(na, 3);
+        BOOST_TEST_EQ(w.size(), 0u);
+
+        // and cancel another which expired with it
+        timer_wheel::entry b;
+        timer_wheel::entry c;
+        int n = 0;
+        b.on_expire = [&]{ ++n; w.cancel(c); };
+        c.on_expire = [&]{ ++n; w.cancel(b); };
+        w.arm(b, t0 + ms(2000));
+        w.arm(c, t0 + ms(2000));
+        BOOST_TEST_EQ(w.advance(t0 + ms(2020)), 1u);
+        BOOST_TEST_EQ(n, 1);
+        BOOST_TEST_EQ(w.size(), 0u);
+    }
+
+    void
+    run()
+    {
+        testExpiry();
+        testRearm();
+        testCatchUp();
+        testFar();
+        testHandlers();
+    }
+};
+
+TEST_SUITE(
+    timer_wheel_test,
+    "boost.beast2.timer_wheel");
+
+} // beast2
+} // boost
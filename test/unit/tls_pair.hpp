@@ -0,0 +1,134 @@
+//
+// Copyright (c) 2026 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/beast2
+//
+
+#ifndef BOOST_BEAST2_TEST_UNIT_TLS_PAIR_HPP
+#define BOOST_BEAST2_TEST_UNIT_TLS_PAIR_HPP
+
+#include "src/detail/ktls.hpp"
+#include "src/detail/tls_session_cache.hpp"
+
+#include <openssl/evp.h>
+#include <openssl/ssl.h>
+#include <openssl/x509.h>
+
+namespace boost {
+namespace beast2 {
+namespace test {
+
+// A server and client handshaking over memory BIOs
+struct tls_pair
+{
+    SSL_CTX* server = nullptr;
+    SSL_CTX* client = nullptr;
+
+    // The client offers versions up to `version`
+    explicit
+    tls_pair(int version = TLS1_2_VERSION)
+    {
+        auto kc = EVP_PKEY_CTX_new_id(EVP_PKEY_EC, nullptr);
+        EVP_PKEY* key = nullptr;
+        EVP_PKEY_keygen_init(kc);
+        EVP_PKEY_CTX_set_ec_paramgen_curve_nid(
+            kc, NID_X9_62_prime256v1);
+        EVP_PKEY_keygen(kc, &key);
+        EVP_PKEY_CTX_free(kc);
+
+        auto cert = X509_new();
+        X509_set_version(cert, 2);
+        ASN1_INTEGER_set(X509_get_serialNumber(cert), 1);
+        X509_gmtime_adj(X509_getm_notBefore(cert), 0);
+        X509_gmtime_adj(X509_getm_notAfter(cert), 3600);
+        X509_set_pubkey(cert, key);
+        X509_sign(cert, key, EVP_sha256());
+
+        server = SSL_CTX_new(TLS_server_method());
+        SSL_CTX_use_certificate(server, cert);
+        SSL_CTX_use_PrivateKey(server, key);
+        client = SSL_CTX_new(TLS_client_method());
+        SSL_CTX_set_max_proto_version(client, version);
+        X509_free(cert);
+        EVP_PKEY_free(key);
+    }
+
+    ~tls_pair()
+    {
+        SSL_CTX_free(server);
+        SSL_CTX_free(client);
+    }
+
+    // Connect two objects through a pair of BIOs.
+    // What the client writes is read from the
+    // server's BIO, and the other way around.
+    static
+    bool
+    handshake(
+        SSL* s,
+        SSL* c)
+    {
+        BIO* b1 = nullptr;
+        BIO* b2 = nullptr;
+        BIO_new_bio_pair(&b1, 0, &b2, 0);
+        SSL_set_bio(s, b1, b1);
+        SSL_set_bio(c, b2, b2);
+        SSL_set_accept_state(s);
+        SSL_set_connect_state(c);
+        int rs = 0;
+        int rc = 0;
+        for(int i = 0; i < 20 && (rs != 1 || rc != 1); ++i)
+        {
+            if(rc != 1)
+                rc = SSL_do_handshake(c);
+            if(rs != 1)
+                rs = SSL_do_handshake(s);
+        }
+
+        // TLS 1.3 tickets follow the handshake
+        char ch;
+        SSL_read(c, &ch, 1);
+        return rs == 1 && rc == 1;
+    }
+
+    // Returns the client's session
+    SSL_SESSION*
+    connect(
+        detail::tls_session_cache* cache,
+        SSL_SESSION* sess,
+        detail::ktls_offload* ko = nullptr,
+        detail::ktls_state* ks = nullptr,
+        detail::ktls_mode* mode = nullptr)
+    {
+        auto s = SSL_new(server);
+        auto c = SSL_new(client);
+        if(cache)
+            cache->prepare(s);
+        if(ko)
+            ko->prepare(s, *ks);
+        if(sess)
+            SSL_set_session(c, sess);
+        bool const ok = handshake(s, c);
+        if(cache)
+            cache->on_handshake(s, ok);
+        if(ko)
+            *mode = ko->enable(s, *ks, -1);
+        auto result = SSL_get1_session(c);
+
+        // a session not shut down cleanly is discarded
+        SSL_shutdown(s);
+        SSL_shutdown(c);
+        SSL_free(s);
+        SSL_free(c);
+        return result;
+    }
+};
+
+} // test
+} // beast2
+} // boost
+
+#endif
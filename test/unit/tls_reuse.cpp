@@ -0,0 +1,136 @@
+//
+// Copyright (c) 2026 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/beast2
+//
+
+// Test that header file is self-contained.
+#include "src/detail/tls_reuse.hpp"
+
+#include <boost/beast2/server_config.hpp>
+
+#include "tls_pair.hpp"
+#include "test_suite.hpp"
+
+namespace boost {
+namespace beast2 {
+
+struct tls_reuse_test
+{
+    using tls_pair = test::tls_pair;
+
+    // One connection served by `s`: a handshake, a
+    // record each way, and a clean shutdown
+    static
+    bool
+    serve(SSL* s, SSL* c)
+    {
+        if(! tls_pair::handshake(s, c))
+            return false;
+        char buf[5];
+        if( SSL_write(c, "hello", 5) != 5 ||
+            SSL_read(s, buf, 5) != 5 ||
+            SSL_write(s, "world", 5) != 5 ||
+            SSL_read(c, buf, 5) != 5)
+            return false;
+        SSL_shutdown(c);
+        SSL_shutdown(s);
+        return
+            SSL_shutdown(s) == 1 &&
+            SSL_shutdown(c) == 1;
+    }
+
+    void
+    testReuse(int version)
+    {
+        tls_pair tp(version);
+        tls_session_config cfg;
+        detail::tls_session_cache cache(cfg);
+        SSL* s = SSL_new(tp.server);
+
+        SSL* c1 = SSL_new(tp.client);
+        cache.prepare(s);
+        BOOST_TEST(serve(s, c1));
+        BOOST_TEST(! SSL_session_reused(s));
+        auto sess = SSL_get1_session(c1);
+        BOOST_TEST(detail::reuse_tls(s));
+        SSL_free(c1);
+
+        // the same object serves a second client,
+        // which resumes the first one's session
+        SSL* c2 = SSL_new(tp.client);
+        SSL_set_session(c2, sess);
+        cache.prepare(s);
+        BOOST_TEST(serve(s, c2));
+        BOOST_TEST(SSL_session_reused(s));
+        BOOST_TEST(detail::reuse_tls(s));
+        SSL_free(c2);
+
+        // and a third, with a full handshake
+        SSL* c3 = SSL_new(tp.client);
+        cache.prepare(s);
+        BOOST_TEST(serve(s, c3));
+        BOOST_TEST(! SSL_session_reused(s));
+        SSL_free(c3);
+
+        SSL_SESSION_free(sess);
+        SSL_free(s);
+    }
+
+    void
+    testPending()
+    {
+        tls_pair tp;
+        SSL* s = SSL_new(tp.server);
+        SSL* c = SSL_new(tp.client);
+        BOOST_TEST(tls_pair::handshake(s, c));
+
+        // a record the server has not read yet
+        // would be taken for the next connection's
+        BOOST_TEST(SSL_write(c, "hello", 5) == 5);
+        BOOST_TEST(! detail::reuse_tls(s));
+
+        // read, it no longer matters
+        char buf[5];
+        BOOST_TEST(SSL_read(s, buf, 5) == 5);
+        BOOST_TEST(detail::reuse_tls(s));
+        SSL_free(c);
+        SSL_free(s);
+    }
+
+    void
+    testReleaseBuffers()
+    {
+        // the buffer policy is kept from one
+        // connection to the next
+        tls_pair tp;
+        SSL* s = SSL_new(tp.server);
+        SSL_set_mode(s, SSL_MODE_RELEASE_BUFFERS);
+        SSL* c = SSL_new(tp.client);
+        BOOST_TEST(serve(s, c));
+        BOOST_TEST(detail::reuse_tls(s));
+        BOOST_TEST((SSL_get_mode(s) &
+            SSL_MODE_RELEASE_BUFFERS) != 0);
+        SSL_free(c);
+        SSL_free(s);
+    }
+
+    void
+    run()
+    {
+        testReuse(TLS1_2_VERSION);
+        testReuse(TLS1_3_VERSION);
+        testPending();
+        testReleaseBuffers();
+    }
+};
+
+TEST_SUITE(
+    tls_reuse_test,
+    "boost.beast2.tls_reuse");
+
+} // beast2
+} // boost
@@ -0,0 +1,115 @@
+//
+// Copyright (c) 2026 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/beast2
+//
+
+// Test that header file is self-contained.
+#include "src/detail/tls_session_cache.hpp"
+
+#include "tls_pair.hpp"
+#include "test_suite.hpp"
+
+namespace boost {
+namespace beast2 {
+
+struct tls_session_cache_test
+{
+    using tls_pair = test::tls_pair;
+
+    void
+    testCache(int version)
+    {
+        tls_pair tp(version);
+        tls_session_config cfg;
+        cfg.tickets = false;
+        detail::tls_session_cache cache(cfg);
+
+        auto sess = tp.connect(&cache, nullptr);
+        BOOST_TEST(sess != nullptr);
+        auto st = cache.get_stats();
+        BOOST_TEST_EQ(st.full_handshakes, 1u);
+        BOOST_TEST(st.cached_sessions >= 1u);
+
+        SSL_SESSION_free(tp.connect(&cache, sess));
+        SSL_SESSION_free(sess);
+        st = cache.get_stats();
+        BOOST_TEST_EQ(st.full_handshakes, 1u);
+        BOOST_TEST_EQ(st.resumed_handshakes, 1u);
+        BOOST_TEST_EQ(st.cache_hits, 1u);
+        BOOST_TEST_EQ(st.failed_handshakes, 0u);
+    }
+
+    void
+    testTickets(int version)
+    {
+        tls_pair tp(version);
+        tls_session_config cfg;
+        cfg.cache = false;
+        detail::tls_session_cache cache(cfg);
+
+        auto sess = tp.connect(&cache, nullptr);
+        SSL_SESSION_free(tp.connect(&cache, sess));
+        SSL_SESSION_free(sess);
+        auto st = cache.get_stats();
+        BOOST_TEST_EQ(st.full_handshakes, 1u);
+        BOOST_TEST_EQ(st.resumed_handshakes, 1u);
+        BOOST_TEST_EQ(st.cached_sessions, 0u);
+
+        // tickets sealed with the previous key still resume
+        cfg.ticket_rotation = std::chrono::seconds(0);
+        detail::tls_session_cache rotating(cfg);
+        sess = tp.connect(&rotating, nullptr);
+        SSL_SESSION_free(tp.connect(&rotating, sess));
+        SSL_SESSION_free(sess);
+        st = rotating.get_stats();
+        BOOST_TEST_EQ(st.resumed_handshakes, 1u);
+        BOOST_TEST(st.key_rotations >= 1u);
+    }
+
+    void
+    testUninstall()
+    {
+        tls_pair tp;
+        tls_session_config cfg;
+        {
+            detail::tls_session_cache cache(cfg);
+            SSL_SESSION_free(tp.connect(&cache, nullptr));
+            BOOST_TEST(SSL_CTX_sess_get_get_cb(tp.server) != nullptr);
+
+            // the cache keeps a context it has seen alive
+            auto ctx = SSL_CTX_new(TLS_server_method());
+            auto ssl = SSL_new(ctx);
+            cache.prepare(ssl);
+            SSL_free(ssl);
+            SSL_CTX_free(ctx);
+        }
+
+        // and leaves it as it was found
+        BOOST_TEST(SSL_CTX_sess_get_get_cb(tp.server) == nullptr);
+        BOOST_TEST(SSL_CTX_sess_get_new_cb(tp.server) == nullptr);
+        auto sess = tp.connect(nullptr, nullptr);
+        BOOST_TEST(sess != nullptr);
+        SSL_SESSION_free(sess);
+    }
+
+    void
+    run()
+    {
+        testCache(TLS1_2_VERSION);
+        testCache(TLS1_3_VERSION);
+        testTickets(TLS1_2_VERSION);
+        testTickets(TLS1_3_VERSION);
+        testUninstall();
+    }
+};
+
+TEST_SUITE(
+    tls_session_cache_test,
+    "boost.beast2.tls_session_cache");
+
+} // beast2
+} // boost